@@ -0,0 +1,79 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Compares the time to parse the packets sent by a client (server side) with
+ * parseClientPacket(), which reads the in-game inputs without a JSON DOM, and
+ * with a JSON DOM for every packet.
+ */
+
+#include "../src/common/bindings/client_packet.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr size_t NUM_ITERATIONS = 200000;
+
+    /**
+     * @brief Returns the average duration of the given function, in
+     * nanoseconds.
+     */
+    double measureNs(const std::function<void()> &function) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            function();
+        }
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / NUM_ITERATIONS;
+    }
+
+    void runBenchmark(const std::string &name, const std::string &packet) {
+        const double flatNs =
+            measureNs([&] { bindings::parseClientPacket(packet); });
+        const double domNs = measureNs([&] {
+            bindings::ClientBindings::fromJson(nlohmann::json::parse(packet));
+        });
+
+        std::cout << std::left << std::setw(24) << name << std::right
+                  << std::fixed << std::setprecision(1)
+                  << " parseClientPacket " << std::setw(7) << flatNs
+                  << " ns, DOM " << std::setw(7) << domNs << " ns\n";
+    }
+
+} // namespace
+
+int main() {
+    runBenchmark(
+        "MoveActive",
+        bindings::MoveActive{TetrominoMove::Left, 1234}.to_json().dump());
+    runBenchmark("RotateActive",
+                 bindings::RotateActive{true, 1234}.to_json().dump());
+    runBenchmark("StateHash",
+                 bindings::StateHash{400, 0x9e3779b97f4a7c15}.to_json().dump());
+    runBenchmark("Message (DOM fallback)",
+                 bindings::Message{2, "hello there"}.to_json().dump());
+
+    return 0;
+}
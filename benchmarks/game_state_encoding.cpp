@@ -0,0 +1,197 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Compares the JSON and binary encodings of the GameState packets: size and
+ * time to encode (server side, from the GameState to the packet's text) and
+ * to decode (client side, from the text to the client::GameState), for a
+ * player and for a viewer of a 9-player game.
+ *
+ * Also gives the average size of the GameStateDelta packets sent to a player
+ * while the game goes on.
+ */
+
+#include "../src/common/bindings/in_game/game_state_client.hpp"
+#include "../src/common/bindings/in_game/game_state_delta.hpp"
+#include "../src/common/bindings/in_game/game_state_server.hpp"
+
+#include "core/in_game/game_state/game_state.hpp"
+#include "core/in_game/game_state/game_state_viewer.hpp"
+#include "game_engine/game_engine.hpp"
+#include "game_log/game_action.hpp"
+#include "game_log/game_log.hpp"
+#include "game_state/game_state_codec.hpp"
+#include "rng/rng.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr size_t NUM_PLAYERS = 9;
+    constexpr size_t NUM_WARMUP_TICKS = 150;
+    constexpr size_t NUM_ITERATIONS = 2000;
+    constexpr size_t NUM_DELTA_TICKS = 100;
+
+    /**
+     * @brief Plays random inputs for the given number of engine ticks,
+     * calling the given function after each one.
+     */
+    void playRandomTicks(GameEngine &engine, Rng &rng, size_t numTicks,
+                         const std::function<void()> &onTick = {}) {
+        for (size_t tick = 0; tick < numTicks; ++tick) {
+            for (UserID userID = 1; userID <= NUM_PLAYERS; ++userID) {
+                const size_t numMoves = rng.nextIndex(4);
+                for (size_t i = 0; i < numMoves; ++i) {
+                    applyGameAction(engine, userID,
+                                    game_action::MoveActive{static_cast<
+                                        TetrominoMove>(rng.nextIndex(2))});
+                }
+            }
+            engine.tick();
+
+            if (onTick) {
+                onTick();
+            }
+        }
+    }
+
+    /**
+     * @brief Plays random inputs for a while so that the boards are not
+     * empty.
+     */
+    GameStatePtr createGameState() {
+        std::vector<GameLogPlayer> players;
+        for (UserID userID = 1; userID <= NUM_PLAYERS; ++userID) {
+            players.push_back({userID, "player" + std::to_string(userID)});
+        }
+
+        GameLog gameLog{GameMode::RoyalCompetition, 42, std::move(players)};
+        GameStatePtr pGameState = gameLog.createInitialGameState();
+        GameEngine engine{pGameState};
+
+        Rng rng{7};
+        playRandomTicks(engine, rng, NUM_WARMUP_TICKS);
+
+        return pGameState;
+    }
+
+    /**
+     * @brief Returns the average duration of the given function, in
+     * microseconds.
+     */
+    double measureUs(const std::function<void()> &function) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+            function();
+        }
+        const std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        return elapsed.count() / NUM_ITERATIONS;
+    }
+
+    template <typename ClientGameState>
+    void runBenchmark(const std::string &name,
+                      const std::function<nlohmann::json()> &serialize,
+                      const std::function<nlohmann::json()> &encode) {
+        const std::string jsonPacket = serialize().dump();
+        const std::string binaryPacket = encode().dump();
+
+        auto decode = [](const std::string &packet) {
+            ClientGameState gameState;
+            gameState.deserialize(
+                bindings::GameStateMessage::getSerializedGameState(
+                    nlohmann::json::parse(packet)));
+            return gameState;
+        };
+
+        const double jsonEncodeUs = measureUs([&] { serialize().dump(); });
+        const double binaryEncodeUs = measureUs([&] { encode().dump(); });
+        const double jsonDecodeUs = measureUs([&] { decode(jsonPacket); });
+        const double binaryDecodeUs = measureUs([&] { decode(binaryPacket); });
+
+        std::cout << name << '\n'
+                  << std::fixed << std::setprecision(1)
+                  << "  json:   " << std::setw(7) << jsonPacket.size()
+                  << " bytes, encode " << std::setw(7) << jsonEncodeUs
+                  << " us, decode " << std::setw(7) << jsonDecodeUs << " us\n"
+                  << "  binary: " << std::setw(7) << binaryPacket.size()
+                  << " bytes, encode " << std::setw(7) << binaryEncodeUs
+                  << " us, decode " << std::setw(7) << binaryDecodeUs
+                  << " us\n";
+    }
+
+    /**
+     * @brief Plays on the given game and prints the average size of the
+     * GameStateDelta packets sent to a player after each engine tick.
+     */
+    void runDeltaBenchmark(const GameStatePtr &pGameState) {
+        GameEngine engine{pGameState};
+        Rng rng{11};
+
+        nlohmann::json j_base = pGameState->serializeForPlayer(1);
+        size_t totalSize = 0;
+
+        playRandomTicks(engine, rng, NUM_DELTA_TICKS, [&] {
+            nlohmann::json j_gameState = pGameState->serializeForPlayer(1);
+            totalSize += bindings::GameStateDelta{
+                1, 0,
+                game_state_codec::encodeDelta(j_base, j_gameState).value(), 0}
+                             .to_json()
+                             .dump()
+                             .size();
+            j_base = std::move(j_gameState);
+        });
+
+        std::cout << "GameStateDelta (player, " << NUM_PLAYERS << " players)\n"
+                  << "  delta:  " << std::setw(7)
+                  << totalSize / NUM_DELTA_TICKS << " bytes on average\n";
+    }
+
+} // namespace
+
+int main() {
+    GameStatePtr pGameState = createGameState();
+
+    runBenchmark<client::GameState>(
+        "GameState (player, " + std::to_string(NUM_PLAYERS) + " players)",
+        [&] {
+            return bindings::GameStateMessage::serializeForPlayer(*pGameState,
+                                                                  1);
+        },
+        [&] {
+            return bindings::GameStateMessage::encodeForPlayer(*pGameState, 1);
+        });
+
+    runBenchmark<client::GameStateViewer>(
+        "GameStateViewer (" + std::to_string(NUM_PLAYERS) + " players)",
+        [&] {
+            return bindings::GameStateMessage::serializeForViewer(*pGameState);
+        },
+        [&] {
+            return bindings::GameStateMessage::encodeForViewer(*pGameState);
+        });
+
+    runDeltaBenchmark(pGameState);
+
+    return 0;
+}
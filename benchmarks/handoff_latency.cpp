@@ -0,0 +1,150 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Measures the latency of handing a value over from several producer threads
+ * to a strand, as the io threads do with the inputs of a game and the game
+ * workers with the packages of a client: with one asio::post per value, and
+ * with the BoundedMpscQueue and a single post per batch.
+ */
+
+#include "../src/server/bounded_mpsc_queue/bounded_mpsc_queue.hpp"
+
+#include <asio.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t NUM_PRODUCERS = 4;
+    constexpr size_t NUM_VALUES_PER_PRODUCER = 100000;
+    // between two values of a producer, not to only measure a full queue
+    constexpr std::chrono::nanoseconds SEND_INTERVAL{2000};
+    constexpr size_t QUEUE_CAPACITY = 1024;
+
+    using Strand = asio::strand<asio::io_context::executor_type>;
+    // a handover function takes the time the value was sent, and has the
+    // strand record the latency once it gets it
+    using Handover = std::function<void(Clock::time_point)>;
+
+    /**
+     * @brief Waits (busy) until the given time, as sleeping is far less
+     * precise than the intervals measured.
+     */
+    void waitUntil(Clock::time_point time) {
+        while (Clock::now() < time) {
+        }
+    }
+
+    /**
+     * @brief Runs the producers with the given handover function, then
+     * prints the latencies recorded by the strand.
+     */
+    void runBenchmark(const std::string &name, asio::io_context &context,
+                      std::vector<double> &latenciesNs,
+                      const Handover &handover) {
+        latenciesNs.clear();
+        latenciesNs.reserve(NUM_PRODUCERS * NUM_VALUES_PER_PRODUCER);
+
+        auto work = asio::make_work_guard(context);
+        std::thread consumer([&context]() { context.run(); });
+
+        std::vector<std::thread> producers;
+        for (size_t i = 0; i < NUM_PRODUCERS; ++i) {
+            producers.emplace_back([&handover]() {
+                Clock::time_point next = Clock::now();
+                for (size_t j = 0; j < NUM_VALUES_PER_PRODUCER; ++j) {
+                    waitUntil(next);
+                    handover(Clock::now());
+                    next += SEND_INTERVAL;
+                }
+            });
+        }
+        for (std::thread &producer : producers) {
+            producer.join();
+        }
+
+        work.reset();
+        consumer.join();
+        context.restart();
+
+        std::sort(latenciesNs.begin(), latenciesNs.end());
+        const auto percentile = [&latenciesNs](double p) {
+            return latenciesNs[static_cast<size_t>(
+                p * static_cast<double>(latenciesNs.size() - 1))];
+        };
+
+        std::cout << std::left << std::setw(26) << name << std::right
+                  << std::fixed << std::setprecision(0) << " p50 "
+                  << std::setw(7) << percentile(0.5) << " ns, p99 "
+                  << std::setw(7) << percentile(0.99) << " ns, max "
+                  << std::setw(9) << latenciesNs.back() << " ns\n";
+    }
+
+    void recordLatency(std::vector<double> &latenciesNs,
+                       Clock::time_point sentTime) {
+        const std::chrono::duration<double, std::nano> latency =
+            Clock::now() - sentTime;
+        latenciesNs.push_back(latency.count());
+    }
+
+} // namespace
+
+int main() {
+    asio::io_context context;
+    Strand strand = asio::make_strand(context);
+    std::vector<double> latenciesNs;
+
+    runBenchmark("asio::post per value", context, latenciesNs,
+                 [&](Clock::time_point sentTime) {
+                     asio::post(strand, [&latenciesNs, sentTime]() {
+                         recordLatency(latenciesNs, sentTime);
+                     });
+                 });
+
+    BoundedMpscQueue<Clock::time_point, QUEUE_CAPACITY> queue;
+    std::atomic<bool> isDrainPosted = false;
+    const auto drain = [&]() {
+        isDrainPosted.exchange(false, std::memory_order_acq_rel);
+        while (std::optional<Clock::time_point> sentTime = queue.tryPop()) {
+            recordLatency(latenciesNs, *sentTime);
+        }
+    };
+
+    runBenchmark("BoundedMpscQueue + batch", context, latenciesNs,
+                 [&](Clock::time_point sentTime) {
+                     while (!queue.tryPush(Clock::time_point{sentTime})) {
+                         std::this_thread::yield();
+                     }
+                     if (!isDrainPosted.exchange(true,
+                                                 std::memory_order_acq_rel)) {
+                         asio::post(strand, drain);
+                     }
+                 });
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Measures the server's io backend on the loopback with the game protocol
+ * (length-prefixed frames of MoveActive bindings, echoed by the server): the
+ * connection churn, the throughput of small messages and the latency of a
+ * round trip. The backend is chosen at build time (USE_IO_URING), so build it
+ * once with each backend to compare them.
+ */
+
+#include "../src/common/bindings/framing.hpp"
+#include "../src/common/bindings/in_game/move_active.hpp"
+#include "../src/server/tetris_main_server/io_backend.hpp"
+
+#include <asio.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+    using asio::ip::tcp;
+
+    constexpr unsigned NUM_SERVER_THREADS = 2;
+    constexpr size_t NUM_CHURN_CONNECTIONS = 5000;
+    constexpr size_t NUM_CLIENTS = 8;
+    // messages each client keeps in flight for the throughput
+    constexpr size_t PIPELINE_DEPTH = 32;
+    constexpr size_t NUM_PIPELINED_MESSAGES = 100000;
+    constexpr size_t NUM_ROUND_TRIPS = 20000;
+
+    /**
+     * @brief A connection of the echo server, on its own strand like a
+     * ClientLink: reads the framing magic, then sends each frame back.
+     */
+    class EchoSession : public std::enable_shared_from_this<EchoSession> {
+      private:
+        tcp::socket socket_;
+        bindings::FrameHeader header_;
+        std::string body_;
+
+        void readFrame() {
+            asio::async_read(
+                socket_, asio::buffer(header_),
+                [self = shared_from_this()](asio::error_code ec,
+                                            std::size_t) {
+                    if (ec) {
+                        return;
+                    }
+                    self->body_.resize(bindings::decodeFrameHeader(
+                        std::span<const char, bindings::FRAME_HEADER_SIZE>{
+                            self->header_}));
+                    self->readBody();
+                });
+        }
+
+        void readBody() {
+            asio::async_read(
+                socket_, asio::buffer(body_),
+                [self = shared_from_this()](asio::error_code ec,
+                                            std::size_t) {
+                    if (!ec) {
+                        self->echoFrame();
+                    }
+                });
+        }
+
+        void echoFrame() {
+            const std::array<asio::const_buffer, 2> buffers{
+                asio::buffer(header_), asio::buffer(body_)};
+            asio::async_write(socket_, buffers,
+                              [self = shared_from_this()](
+                                  asio::error_code ec, std::size_t) {
+                                  if (!ec) {
+                                      self->readFrame();
+                                  }
+                              });
+        }
+
+      public:
+        explicit EchoSession(tcp::socket socket)
+            : socket_(std::move(socket)) {}
+
+        void start() {
+            asio::async_read(
+                socket_, asio::buffer(header_.data(),
+                                      bindings::FRAMING_MAGIC.size()),
+                [self = shared_from_this()](asio::error_code ec,
+                                            std::size_t) {
+                    if (!ec) {
+                        self->readFrame();
+                    }
+                });
+        }
+    };
+
+    void accept(asio::io_context &context, tcp::acceptor &acceptor) {
+        acceptor.async_accept(
+            asio::make_strand(context),
+            [&context, &acceptor](asio::error_code ec, tcp::socket socket) {
+                if (!ec) {
+                    socket.set_option(tcp::no_delay(true));
+                    std::make_shared<EchoSession>(std::move(socket))->start();
+                }
+                accept(context, acceptor);
+            });
+    }
+
+    std::string makeFrame() {
+        const std::string body =
+            bindings::MoveActive{TetrominoMove::Left, 42}.to_json().dump();
+        const bindings::FrameHeader header =
+            bindings::encodeFrameHeader(static_cast<uint32_t>(body.size()));
+        return std::string(header.begin(), header.end()) + body;
+    }
+
+    tcp::socket connect(asio::io_context &context, uint16_t port) {
+        tcp::socket socket(context);
+        socket.connect({asio::ip::address_v4::loopback(), port});
+        socket.set_option(tcp::no_delay(true));
+        asio::write(socket, asio::buffer(bindings::FRAMING_MAGIC.data(),
+                                         bindings::FRAMING_MAGIC.size()));
+        return socket;
+    }
+
+    /**
+     * @brief Runs the given function on NUM_CLIENTS threads and returns the
+     * time they took.
+     */
+    template <typename Function>
+    std::chrono::duration<double> runClients(Function function) {
+        const Clock::time_point start = Clock::now();
+        std::vector<std::thread> clients;
+        for (size_t i = 0; i < NUM_CLIENTS; ++i) {
+            clients.emplace_back([&function, i]() { function(i); });
+        }
+        for (std::thread &client : clients) {
+            client.join();
+        }
+        return Clock::now() - start;
+    }
+
+    void benchmarkChurn(uint16_t port, const std::string &frame) {
+        const std::chrono::duration<double> elapsed =
+            runClients([port, &frame](size_t) {
+                asio::io_context context;
+                std::string reply(frame.size(), '\0');
+                for (size_t i = 0; i < NUM_CHURN_CONNECTIONS / NUM_CLIENTS;
+                     ++i) {
+                    tcp::socket socket = connect(context, port);
+                    asio::write(socket, asio::buffer(frame));
+                    asio::read(socket, asio::buffer(reply));
+                }
+            });
+
+        std::cout << std::left << std::setw(22) << "connection churn"
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(10) << NUM_CHURN_CONNECTIONS / elapsed.count()
+                  << " connections/s\n";
+    }
+
+    void benchmarkThroughput(uint16_t port, const std::string &frame) {
+        // PIPELINE_DEPTH frames written at once, then read back
+        std::string batch;
+        for (size_t i = 0; i < PIPELINE_DEPTH; ++i) {
+            batch += frame;
+        }
+
+        const std::chrono::duration<double> elapsed =
+            runClients([port, &batch](size_t) {
+                asio::io_context context;
+                tcp::socket socket = connect(context, port);
+                std::string replies(batch.size(), '\0');
+                for (size_t i = 0;
+                     i < NUM_PIPELINED_MESSAGES / PIPELINE_DEPTH; ++i) {
+                    asio::write(socket, asio::buffer(batch));
+                    asio::read(socket, asio::buffer(replies));
+                }
+            });
+
+        const double numMessages =
+            static_cast<double>(NUM_CLIENTS * NUM_PIPELINED_MESSAGES);
+        std::cout << std::left << std::setw(22) << "small messages"
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(10) << numMessages / elapsed.count()
+                  << " messages/s\n";
+    }
+
+    void benchmarkLatency(uint16_t port, const std::string &frame) {
+        std::vector<std::vector<double>> latenciesUs(NUM_CLIENTS);
+        runClients([port, &frame, &latenciesUs](size_t client) {
+            asio::io_context context;
+            tcp::socket socket = connect(context, port);
+            std::string reply(frame.size(), '\0');
+            latenciesUs[client].reserve(NUM_ROUND_TRIPS);
+            for (size_t i = 0; i < NUM_ROUND_TRIPS; ++i) {
+                const Clock::time_point sent = Clock::now();
+                asio::write(socket, asio::buffer(frame));
+                asio::read(socket, asio::buffer(reply));
+                const std::chrono::duration<double, std::micro> latency =
+                    Clock::now() - sent;
+                latenciesUs[client].push_back(latency.count());
+            }
+        });
+
+        std::vector<double> allLatenciesUs;
+        for (const std::vector<double> &latencies : latenciesUs) {
+            allLatenciesUs.insert(allLatenciesUs.end(), latencies.begin(),
+                                  latencies.end());
+        }
+        std::sort(allLatenciesUs.begin(), allLatenciesUs.end());
+        const auto percentile = [&allLatenciesUs](double p) {
+            return allLatenciesUs[static_cast<size_t>(
+                p * static_cast<double>(allLatenciesUs.size() - 1))];
+        };
+
+        std::cout << std::left << std::setw(22) << "round trip" << std::right
+                  << std::fixed << std::setprecision(1) << " p50 "
+                  << std::setw(6) << percentile(0.5) << " us, p99 "
+                  << std::setw(6) << percentile(0.99) << " us, max "
+                  << std::setw(8) << allLatenciesUs.back() << " us\n";
+    }
+
+} // namespace
+
+int main() {
+    asio::io_context context;
+    tcp::acceptor acceptor(context, {asio::ip::address_v4::loopback(), 0});
+    const uint16_t port = acceptor.local_endpoint().port();
+    accept(context, acceptor);
+
+    std::vector<std::thread> serverThreads;
+    for (unsigned i = 0; i < NUM_SERVER_THREADS; ++i) {
+        serverThreads.emplace_back([&context]() { context.run(); });
+    }
+
+    std::cout << "io backend: " << IO_BACKEND << "\n";
+    const std::string frame = makeFrame();
+    benchmarkChurn(port, frame);
+    benchmarkThroughput(port, frame);
+    benchmarkLatency(port, frame);
+
+    context.stop();
+    for (std::thread &thread : serverThreads) {
+        thread.join();
+    }
+    return 0;
+}
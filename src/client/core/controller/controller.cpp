@@ -18,6 +18,7 @@
 #include "controller.hpp"
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -35,6 +36,7 @@
 #include "../../../common/bindings/change_password.hpp"
 #include "../../../common/bindings/change_username.hpp"
 #include "../../../common/bindings/constants.hpp"
+#include "../../../common/bindings/conversation_page.hpp"
 #include "../../../common/bindings/conversations.hpp"
 #include "../../../common/bindings/create_game.hpp"
 #include "../../../common/bindings/friend_request.hpp"
@@ -44,21 +46,35 @@
 #include "../../../common/bindings/in_game/buy_bonus.hpp"
 #include "../../../common/bindings/in_game/buy_penalty.hpp"
 #include "../../../common/bindings/in_game/empty_penalty_stash.hpp"
+#include "../../../common/bindings/in_game/engine_tick.hpp"
+#include "../../../common/bindings/in_game/game_input.hpp"
 #include "../../../common/bindings/in_game/game_state_client.hpp"
 #include "../../../common/bindings/in_game/hold_active_tetromino.hpp"
+#include "../../../common/bindings/in_game/lockstep_sync.hpp"
 #include "../../../common/bindings/in_game/move_active.hpp"
 #include "../../../common/bindings/in_game/quit_game.hpp"
+#include "../../../common/bindings/in_game/request_game_state_snapshot.hpp"
 #include "../../../common/bindings/in_game/rotate_active.hpp"
 #include "../../../common/bindings/in_game/select_target.hpp"
+#include "../../../common/bindings/in_game/state_hash.hpp"
 #include "../../../common/bindings/join_game.hpp"
 #include "../../../common/bindings/message.hpp"
+#include "../../../common/bindings/new_message.hpp"
 #include "../../../common/bindings/pending_friend_requests.hpp"
+#include "../../../common/bindings/ping.hpp"
+#include "../../../common/bindings/pong.hpp"
 #include "../../../common/bindings/ranking.hpp"
+#include "../../../common/bindings/ranking_delta.hpp"
+#include "../../../common/bindings/ranking_page.hpp"
 #include "../../../common/bindings/registration.hpp"
 #include "../../../common/bindings/registration_response.hpp"
 #include "../../../common/bindings/remove_friend.hpp"
+#include "../../../common/bindings/request_conversation_page.hpp"
+#include "../../../common/bindings/request_ranking_page.hpp"
+#include "../../../common/bindings/server_packet.hpp"
 #include "../../../common/bindings/user.hpp"
 #include "../../../common/bindings/view_game.hpp"
+#include "../../../common/types/overloaded.hpp"
 #include "../../../common/types/types.hpp"
 #include "../network/network_manager.hpp"
 #include "core/controller/update_type.hpp"
@@ -87,80 +103,248 @@ void Controller::updateFriendState(const bindings::User &updatedFriend) {
     }
 }
 
-void Controller::handlePacket(const std::string_view pack) {
-    try {
-        nlohmann::json j = nlohmann::json::parse(pack);
+void Controller::handleLockstepPacket(const bindings::ServerPacket &packet) {
+    if (const auto *pLockstepSync =
+            std::get_if<bindings::LockstepSync>(&packet)) {
+        pLockstepGame_ = std::make_unique<LockstepGame>(*pLockstepSync);
+        lockstepDesynced_ = false;
+    } else if (!pLockstepGame_) {
+        // not (or no longer) in a lockstep game
+        return;
+    } else if (const auto *pGameInput =
+                   std::get_if<bindings::GameInput>(&packet)) {
+        if (!pLockstepGame_->applyInput(pGameInput->tick, pGameInput->userID,
+                                        pGameInput->action)) {
+            lockstepDesynced_ = true;
+        }
+    } else if (const auto *pEngineTick =
+                   std::get_if<bindings::EngineTick>(&packet)) {
+        const size_t tick = pEngineTick->tick;
+        if (!pLockstepGame_->tick(tick)) {
+            lockstepDesynced_ = true;
+        }
 
-        std::lock_guard<std::mutex> guard(mutex_);
+        if (tick % bindings::StateHash::INTERVAL == 0) {
+            // a desynced simulation sends a hash that can't match, for the
+            // server to resync it
+            const uint64_t hash =
+                lockstepDesynced_ ? 0 : pLockstepGame_->computeHash();
+            networkManager_.send(
+                bindings::StateHash{tick, hash}.to_json().dump());
+        }
+    }
 
-        UpdateType updateType = UpdateType::OTHER;
+    gameState_ = pLockstepGame_->getClientGameState();
+}
 
-        switch (static_cast<bindings::BindingType>(
-            j.at(bindings::PACKET_TYPE_FIELD))) {
-        case bindings::BindingType::AuthenticationResponse: {
-            bool success =
-                bindings::AuthenticationResponse::from_json(j).success;
-            authState_ = success ? Controller::AuthState::Authenticated
-                                 : Controller::AuthState::Unauthenticated;
-            break;
-        }
+void Controller::updateGameState(const nlohmann::json &j_gameState,
+                                 bindings::InputSeq lastInputSeq) {
+    if (!j_gameState.contains("self")) {
+        client::GameStateViewer gameStateViewer;
+        gameStateViewer.deserialize(j_gameState);
 
-        case bindings::BindingType::RegistrationResponse: {
-            bool success = bindings::RegistrationResponse::from_json(j).success;
-            registrationState_ =
-                success ? Controller::RegistrationState::Registered
-                        : Controller::RegistrationState::Unregistered;
-            break;
-        }
+        gameState_ = std::move(gameStateViewer);
+        return;
+    }
 
-        case bindings::BindingType::FriendsList: {
-            friendsList_ = bindings::FriendsList::from_json(j).friendsList;
-            updateType = UpdateType::FRIENDS_LIST;
-            break;
-        }
+    client::GameState gameState;
+    gameState.deserialize(j_gameState);
 
-        case bindings::BindingType::Conversations: {
-            conversationsById_ =
-                bindings::Conversations::from_json(j).conversationsById;
-            updateType = UpdateType::CONVERSATIONS;
-            break;
-        }
+    inputPredictor_.reconcile(lastInputSeq,
+                              j_gameState.at("self").at("tetris"),
+                              gameState.self.playerState);
+    inputPredictor_.applyTo(gameState);
 
-        case bindings::BindingType::User: {
-            bindings::User updatedFriend = bindings::User::from_json(j);
-            updateFriendState(updatedFriend);
-            break;
-        }
+    gameState_ = std::move(gameState);
+}
 
-        case bindings::BindingType::PendingFriendRequests: {
-            pendingFriendRequests_ =
-                bindings::PendingFriendRequests::from_json(j).requests;
-            updateType = UpdateType::FRIEND_REQUESTS;
-            break;
-        }
+void Controller::handleConversationPage(
+    bindings::ConversationPage &&conversationPage) {
+    bindings::Conversation &conversation =
+        conversationsById_[conversationPage.userID].second;
+    bindings::Conversation &olderPage = conversationPage.conversation;
 
-        case bindings::BindingType::GameState: {
-            gameState_ = bindings::GameStateMessage::deserializeForPlayer(j);
-            updateType = UpdateType::GAME_STATE;
-            break;
-        }
+    // a page that was already received, or asked before a reconnection
+    if (olderPage.firstIndex + olderPage.senderMessages.size()
+        != conversation.firstIndex) {
+        return;
+    }
 
-        case bindings::BindingType::GameStateViewer: {
-            gameState_ = bindings::GameStateMessage::deserializeForViewer(j);
-            updateType = UpdateType::GAME_STATE;
-            break;
-        }
+    conversation.senderMessages.insert(
+        conversation.senderMessages.begin(),
+        std::make_move_iterator(olderPage.senderMessages.begin()),
+        std::make_move_iterator(olderPage.senderMessages.end()));
+    conversation.firstIndex = olderPage.firstIndex;
+}
+
+void Controller::addRankingEntry(bindings::RankingEntry &&entry) {
+    std::erase_if(ranking_, [&](const bindings::RankingEntry &known) {
+        return known.playerId == entry.playerId;
+    });
+
+    auto it = std::ranges::lower_bound(ranking_, entry.rank, {},
+                                       &bindings::RankingEntry::rank);
+    if (it != ranking_.end() && it->rank == entry.rank) {
+        *it = std::move(entry);
+    } else {
+        ranking_.insert(it, std::move(entry));
+    }
+}
 
-        case bindings::BindingType::Ranking: {
-            ranking_ = bindings::Ranking::from_json(j).ranking;
-            updateType = UpdateType::RANKING;
-            break;
+void Controller::handleRankingDelta(bindings::RankingDelta &&rankingDelta) {
+    const size_t newRank = rankingDelta.entry.rank;
+    const size_t previousRank = rankingDelta.previousRank;
+
+    std::erase_if(ranking_, [&](const bindings::RankingEntry &known) {
+        return known.playerId == rankingDelta.entry.playerId;
+    });
+
+    // the players that have been overtaken go down by one
+    for (bindings::RankingEntry &known : ranking_) {
+        if (known.rank >= newRank && known.rank < previousRank) {
+            ++known.rank;
         }
+    }
+    if (ownRank_ >= newRank && ownRank_ < previousRank) {
+        ++ownRank_;
+    }
+
+    // only kept if it lands among the players the client already has
+    const bool isNextToKnown = std::ranges::any_of(
+        ranking_, [&](const bindings::RankingEntry &known) {
+            return known.rank + 1 == newRank || known.rank == newRank + 1;
+        });
+    if (newRank == 1 || isNextToKnown) {
+        addRankingEntry(std::move(rankingDelta.entry));
+    }
+}
 
-        default:
-            std::cerr << "unknown bindingType "
-                      << j.at(bindings::PACKET_TYPE_FIELD) << std::endl;
+void Controller::handleGameState(
+    bindings::ReceivedGameState &&receivedGameState) {
+    updateGameState(receivedGameState.gameState,
+                    receivedGameState.lastInputSeq);
+
+    lastGameStateJson_ = std::move(receivedGameState.gameState);
+    lastGameStateID_ = receivedGameState.id;
+    gameStateSnapshotRequested_ = false;
+}
+
+void Controller::handleGameStateDelta(
+    const bindings::GameStateDelta &gameStateDelta) {
+    if (lastGameStateID_ == 0 || gameStateDelta.baseId != lastGameStateID_) {
+        // missed the base (or failed to apply it): the next deltas can't be
+        // applied either until a full GameState is received
+        if (!gameStateSnapshotRequested_) {
+            networkManager_.send(
+                bindings::RequestGameStateSnapshot{}.to_json().dump());
+            gameStateSnapshotRequested_ = true;
         }
+        return;
+    }
+
+    nlohmann::json j_gameState = game_state_codec::decodeDelta(
+        lastGameStateJson_, gameStateDelta.delta);
+
+    updateGameState(j_gameState, gameStateDelta.lastInputSeq);
+
+    lastGameStateJson_ = std::move(j_gameState);
+    lastGameStateID_ = gameStateDelta.id;
+}
+
+void Controller::handlePacket(const std::string_view pack) {
+    try {
+        bindings::ServerPacket packet = bindings::parseServerPacket(pack);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        const UpdateType updateType = std::visit(
+            Overloaded{
+                [this](const bindings::AuthenticationResponse &response) {
+                    authState_ = response.success
+                                     ? Controller::AuthState::Authenticated
+                                     : Controller::AuthState::Unauthenticated;
+                    return UpdateType::OTHER;
+                },
+                [this](const bindings::RegistrationResponse &response) {
+                    registrationState_ =
+                        response.success
+                            ? Controller::RegistrationState::Registered
+                            : Controller::RegistrationState::Unregistered;
+                    return UpdateType::OTHER;
+                },
+                [this](bindings::FriendsList &friendsList) {
+                    friendsList_ = std::move(friendsList.friendsList);
+                    return UpdateType::FRIENDS_LIST;
+                },
+                [this](bindings::Conversations &conversations) {
+                    conversationsById_ =
+                        std::move(conversations.conversationsById);
+                    return UpdateType::CONVERSATIONS;
+                },
+                [this](bindings::NewMessage &newMessage) {
+                    auto &[name, conversation] =
+                        conversationsById_[newMessage.userID];
+                    name = std::move(newMessage.username);
+                    conversation.senderMessages.push_back(
+                        std::move(newMessage.senderMessage));
+                    return UpdateType::CONVERSATIONS;
+                },
+                [this](bindings::ConversationPage &conversationPage) {
+                    handleConversationPage(std::move(conversationPage));
+                    return UpdateType::CONVERSATIONS;
+                },
+                [this](const bindings::User &updatedFriend) {
+                    updateFriendState(updatedFriend);
+                    return UpdateType::OTHER;
+                },
+                [this](bindings::PendingFriendRequests &pendingRequests) {
+                    pendingFriendRequests_ =
+                        std::move(pendingRequests.requests);
+                    return UpdateType::FRIEND_REQUESTS;
+                },
+                [this](bindings::Ranking &ranking) {
+                    ranking_ = std::move(ranking.ranking);
+                    ownRank_ = ranking.ownRank;
+                    return UpdateType::RANKING;
+                },
+                [this](bindings::RankingDelta &rankingDelta) {
+                    handleRankingDelta(std::move(rankingDelta));
+                    return UpdateType::RANKING;
+                },
+                [this](bindings::RankingPage &rankingPage) {
+                    for (bindings::RankingEntry &entry : rankingPage.ranking) {
+                        addRankingEntry(std::move(entry));
+                    }
+                    return UpdateType::RANKING;
+                },
+                [this](bindings::ReceivedGameState &receivedGameState) {
+                    handleGameState(std::move(receivedGameState));
+                    return UpdateType::GAME_STATE;
+                },
+                [this](const bindings::GameStateDelta &gameStateDelta) {
+                    handleGameStateDelta(gameStateDelta);
+                    return UpdateType::GAME_STATE;
+                },
+                [this, &packet](const bindings::LockstepSync &) {
+                    handleLockstepPacket(packet);
+                    return UpdateType::GAME_STATE;
+                },
+                [this, &packet](const bindings::GameInput &) {
+                    handleLockstepPacket(packet);
+                    return UpdateType::GAME_STATE;
+                },
+                [this, &packet](const bindings::EngineTick &) {
+                    handleLockstepPacket(packet);
+                    return UpdateType::GAME_STATE;
+                },
+                [this](const bindings::Ping &ping) {
+                    // right away, the server measures the round trip time
+                    networkManager_.send(
+                        bindings::Pong{ping.id}.to_json().dump());
+                    return UpdateType::OTHER;
+                },
+            },
+            packet);
 
         pAbstractDisplay_->forceRefresh(updateType);
     } catch (const std::runtime_error &e) {
@@ -169,22 +353,110 @@ void Controller::handlePacket(const std::string_view pack) {
     }
 }
 
+void Controller::scheduleReplayFrame() {
+    replayTimer_.expires_after(REPLAY_FRAME_INTERVAL);
+    replayTimer_.async_wait([this](const asio::error_code &ec) {
+        if (!ec && onReplayFrame()) {
+            scheduleReplayFrame();
+        }
+    });
+}
+
+bool Controller::onReplayFrame() {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        // quitGame() marks the game as finished
+        if (std::visit(
+                [](const auto &gameState) { return gameState.isFinished; },
+                gameState_)) {
+            return false;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        pReplayPlayer_->update(now - lastReplayFrame_);
+        lastReplayFrame_ = now;
+
+        gameState_ = pReplayPlayer_->getClientGameState();
+    }
+
+    pAbstractDisplay_->forceRefresh(UpdateType::GAME_STATE);
+    return true;
+}
+
+bool Controller::handleReplayKeyPress(const std::string &pressedKey) {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if (pressedKey == "Space") {
+        pReplayPlayer_->togglePause();
+    } else if (pressedKey == "ArrowLeft") {
+        pReplayPlayer_->seekRelative(-REPLAY_SEEK_STEP_MS);
+    } else if (pressedKey == "ArrowRight") {
+        pReplayPlayer_->seekRelative(REPLAY_SEEK_STEP_MS);
+    } else if (pressedKey == "+" || pressedKey == "=") {
+        pReplayPlayer_->speedUp();
+    } else if (pressedKey == "-") {
+        pReplayPlayer_->slowDown();
+    } else if (pressedKey == "p") {
+        pReplayPlayer_->followNextPlayer();
+        currentEffectIdx_ = 0;
+    } else if (pressedKey.size() == 1 && pressedKey[0] >= '0'
+               && pressedKey[0] <= '9') {
+        // jump to 0%, 10%, ..., 90% of the replay
+        pReplayPlayer_->seek(pReplayPlayer_->getStatus().durationMs
+                             * static_cast<uint64_t>(pressedKey[0] - '0') / 10);
+    } else {
+        return false;
+    }
+
+    gameState_ = pReplayPlayer_->getClientGameState();
+    return true;
+}
+
+bindings::InputSeq Controller::predictInput(const GameAction &gameAction) {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    auto *pGameState = std::get_if<client::GameState>(&gameState_);
+    if (pGameState == nullptr || pLockstepGame_ != nullptr || isReplaying()) {
+        return 0;
+    }
+
+    const bindings::InputSeq seq = inputPredictor_.pushInput(gameAction);
+    inputPredictor_.applyTo(*pGameState);
+
+    pAbstractDisplay_->forceRefresh(UpdateType::GAME_STATE);
+
+    return seq;
+}
+
 // ### Public methods ###
 
 Controller::Controller()
     : registrationState_{Controller::RegistrationState::Unregistered},
       authState_{Controller::AuthState::Unauthenticated}, gameState_{},
-      networkManager_{context_, [this](const std::string_view packet) {
+      networkManager_{context_,
+                      [this](const std::string_view packet) {
                           handlePacket(packet);
-                      }} {
+                      }},
+      replayTimer_{context_},
+      lockstepEnabled_{false}, lockstepDesynced_{false}, lastGameStateID_{0},
+      gameStateSnapshotRequested_{false} {
+    if (const char *lockstepEnv = std::getenv(ENV_VAR_LOCKSTEP.data())) {
+        lockstepEnabled_ = std::string_view{lockstepEnv} == "1";
+    }
+
     networkManager_.setDisconnectHandler([this]() {
         std::lock_guard<std::mutex> guard(mutex_);
         registrationState_ = Controller::RegistrationState::Unregistered;
         authState_ = Controller::AuthState::Unauthenticated;
         gameState_ = {};
+        pLockstepGame_.reset();
+        inputPredictor_.reset();
+        lastGameStateID_ = 0;
         friendsList_.clear();
         conversationsById_.clear();
         ranking_.clear();
+        ownRank_ = 0;
         pendingFriendRequests_.clear();
         if (pAbstractDisplay_) {
             pAbstractDisplay_->onDisconnected();
@@ -221,6 +493,42 @@ void Controller::run(std::unique_ptr<AbstractDisplay> &&pAbstractDisplay) {
     }
 }
 
+void Controller::runReplay(
+    const std::filesystem::path &replayPath,
+    std::unique_ptr<AbstractDisplay> &&pAbstractDisplay) {
+    pReplayPlayer_ =
+        std::make_unique<ReplayPlayer>(ReplayReader::open(replayPath));
+    gameState_ = pReplayPlayer_->getClientGameState();
+    currentEffectIdx_ = 0;
+
+    pAbstractDisplay_ = std::move(pAbstractDisplay);
+
+    lastReplayFrame_ = std::chrono::steady_clock::now();
+    scheduleReplayFrame();
+
+    std::thread ioThread([&]() { context_.run(); });
+
+    pAbstractDisplay_->run();
+
+    context_.stop();
+
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+}
+
+bool Controller::isReplaying() const { return pReplayPlayer_ != nullptr; }
+
+std::optional<ReplayStatus> Controller::getReplayStatus() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    if (!pReplayPlayer_) {
+        return std::nullopt;
+    }
+
+    return pReplayPlayer_->getStatus();
+}
+
 const std::string_view Controller::getServerIp() const {
     return serverInfo_.ip;
 }
@@ -245,15 +553,48 @@ void Controller::tryRegister(const std::string &username,
 
 void Controller::tryLogin(const std::string &username,
                           const std::string &password) {
+    bindings::ClientFeatures features =
+        bindings::withFeature(0, bindings::ClientFeature::BinaryGameState);
+    features = bindings::withFeature(features,
+                                     bindings::ClientFeature::DeltaGameState);
+    if (lockstepEnabled_) {
+        features =
+            bindings::withFeature(features, bindings::ClientFeature::Lockstep);
+    }
+
     networkManager_.send(
-        bindings::Authentication{username, password}.to_json().dump());
+        bindings::Authentication{username, password, features}
+            .to_json()
+            .dump());
 }
 
-std::vector<std::pair<std::string, Score>> Controller::getRanking() const {
+std::vector<bindings::RankingEntry> Controller::getRanking() const {
     std::lock_guard<std::mutex> guard(mutex_);
     return ranking_;
 }
 
+size_t Controller::getOwnRank() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return ownRank_;
+}
+
+void Controller::requestRankingPage() {
+    bindings::RequestRankingPage request{1, 0, 0};
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        // the page starts after the last player of the top of the ranking
+        for (const bindings::RankingEntry &entry : ranking_) {
+            if (entry.rank != request.firstRank) {
+                break;
+            }
+            request = bindings::RequestRankingPage{
+                entry.rank + 1, entry.score, entry.playerId};
+        }
+    }
+
+    networkManager_.send(request.to_json().dump());
+}
+
 void Controller::changeProfile(const std::string &username,
                                const std::string &password) {
     networkManager_.send(bindings::ChangeUsername{username}.to_json().dump());
@@ -292,13 +633,39 @@ const NameConversation Controller::getConversationWith(UserID userID) {
     return conversationsById_.at(userID);
 }
 
+void Controller::requestOlderMessages(UserID userID) {
+    std::lock_guard<std::mutex> guard(mutex_);
+
+    auto it = conversationsById_.find(userID);
+    if (it == conversationsById_.end() || it->second.second.firstIndex == 0) {
+        return;
+    }
+
+    networkManager_.send(
+        bindings::RequestConversationPage{userID, it->second.second.firstIndex}
+            .to_json()
+            .dump());
+}
+
 void Controller::createGame(GameMode gameMode, size_t targetNumPlayers) {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        inputPredictor_.reset();
+        lastGameStateID_ = 0;
+    }
+
     networkManager_.send(
         bindings::CreateGame{gameMode, targetNumPlayers}.to_json().dump());
     if (gameMode == GameMode::RoyalCompetition) currentEffectIdx_ = 0;
 }
 
 void Controller::joinGame(GameMode gameMode, std::optional<UserID> friendID) {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        inputPredictor_.reset();
+        lastGameStateID_ = 0;
+    }
+
     networkManager_.send(
         bindings::JoinGame{gameMode, friendID}.to_json().dump());
     if (gameMode == GameMode::RoyalCompetition) currentEffectIdx_ = 0;
@@ -309,15 +676,22 @@ void Controller::joinGameAsViewer(UserID targetId) {
 }
 
 void Controller::bigDrop() {
-    networkManager_.send(bindings::BigDrop{}.to_json().dump());
+    const bindings::InputSeq seq = predictInput(game_action::BigDrop{});
+    networkManager_.send(bindings::BigDrop{seq}.to_json().dump());
 }
 
 void Controller::moveActive(TetrominoMove tetrominoMove) {
-    networkManager_.send(bindings::MoveActive{tetrominoMove}.to_json().dump());
+    const bindings::InputSeq seq =
+        predictInput(game_action::MoveActive{tetrominoMove});
+    networkManager_.send(
+        bindings::MoveActive{tetrominoMove, seq}.to_json().dump());
 }
 
 void Controller::rotateActive(bool clockwise) {
-    networkManager_.send(bindings::RotateActive{clockwise}.to_json().dump());
+    const bindings::InputSeq seq =
+        predictInput(game_action::RotateActive{clockwise});
+    networkManager_.send(
+        bindings::RotateActive{clockwise, seq}.to_json().dump());
 }
 
 void Controller::emptyPenaltyStash() {
@@ -325,14 +699,24 @@ void Controller::emptyPenaltyStash() {
 }
 
 void Controller::holdActiveTetromino() {
-    networkManager_.send(bindings::HoldActiveTetromino{}.to_json().dump());
+    const bindings::InputSeq seq =
+        predictInput(game_action::HoldActiveTetromino{});
+    networkManager_.send(bindings::HoldActiveTetromino{seq}.to_json().dump());
 }
 
 void Controller::selectTarget(UserID userId) {
+    if (isReplaying()) {
+        return;
+    }
+
     networkManager_.send(bindings::SelectTarget{userId}.to_json().dump());
 }
 
 void Controller::buyEffect(EffectType effectType, bool stashForLater) {
+    if (isReplaying()) {
+        return;
+    }
+
     std::visit(
         [this, stashForLater](auto &&effectType) {
             using T = std::decay_t<decltype(effectType)>;
@@ -350,7 +734,14 @@ void Controller::buyEffect(EffectType effectType, bool stashForLater) {
 }
 
 void Controller::quitGame() {
-    networkManager_.send(bindings::QuitGame{}.to_json().dump());
+    if (!isReplaying()) {
+        networkManager_.send(bindings::QuitGame{}.to_json().dump());
+    }
+
+    std::lock_guard<std::mutex> guard(mutex_);
+    pLockstepGame_.reset();
+    inputPredictor_.reset();
+    lastGameStateID_ = 0;
     std::visit(
         [](auto &gameState) {
             using T = std::decay_t<decltype(gameState)>;
@@ -366,23 +757,23 @@ void Controller::quitGame() {
 void Controller::handleKeyPress(const std::string &pressedKey) {
     if (pressedKey == "q") {
         quitGame();
+    } else if (isReplaying()) {
+        handleReplayKeyPress(pressedKey);
+        return;
     } else if (pressedKey == "ArrowLeft") {
-        networkManager_.send(
-            bindings::MoveActive{TetrominoMove::Left}.to_json().dump());
+        moveActive(TetrominoMove::Left);
     } else if (pressedKey == "ArrowRight") {
-        networkManager_.send(
-            bindings::MoveActive{TetrominoMove::Right}.to_json().dump());
+        moveActive(TetrominoMove::Right);
     } else if (pressedKey == "Space") {
-        networkManager_.send(bindings::BigDrop{}.to_json().dump());
+        bigDrop();
     } else if (pressedKey == "ArrowDown") {
-        networkManager_.send(
-            bindings::MoveActive{TetrominoMove::Down}.to_json().dump());
+        moveActive(TetrominoMove::Down);
     } else if (pressedKey == "f") {
-        networkManager_.send(bindings::RotateActive{false}.to_json().dump());
+        rotateActive(false);
     } else if (pressedKey == "h") {
-        networkManager_.send(bindings::HoldActiveTetromino{}.to_json().dump());
+        holdActiveTetromino();
     } else if (pressedKey == "g") {
-        networkManager_.send(bindings::RotateActive{true}.to_json().dump());
+        rotateActive(true);
     }
 
     bool isRoyalCompetition = std::visit(
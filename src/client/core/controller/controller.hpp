@@ -18,18 +18,28 @@
 #ifndef CONTROLLER_HPP
 #define CONTROLLER_HPP
 
+#include "../../../common/bindings/binding_type.hpp"
 #include "../../../common/bindings/conversation.hpp"
+#include "../../../common/bindings/in_game/game_state_delta.hpp"
+#include "../../../common/bindings/server_packet.hpp"
 #include "../../../common/bindings/user.hpp"
 #include "../../../common/types/types.hpp"
 #include "../in_game/game_state/game_state.hpp"
 #include "../in_game/game_state/game_state_viewer.hpp"
+#include "../lockstep/lockstep_game.hpp"
 #include "../network/network_manager.hpp"
+#include "../prediction/input_predictor.hpp"
+#include "../replay_player/replay_player.hpp"
 #include "core/server_info/server_info.hpp"
 #include "effect/effect_type.hpp"
 #include <asio/impl/io_context.ipp>
 #include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <chrono>
+#include <filesystem>
 #include <memory>
 #include <mutex>
+#include <nlohmann/json_fwd.hpp>
 #include <optional>
 #include <stddef.h>
 #include <stdint.h>
@@ -79,6 +89,23 @@ class Controller {
     };
 
   private:
+    /**
+     * @brief Interval between two frames of a replay.
+     */
+    static constexpr std::chrono::milliseconds REPLAY_FRAME_INTERVAL{16};
+
+    /**
+     * @brief How far the seek keys move a replay.
+     */
+    static constexpr int64_t REPLAY_SEEK_STEP_MS = 5000;
+
+    /**
+     * @brief Environment variable enabling the lockstep mode (when set to 1):
+     * the games are simulated locally from the inputs broadcast by the server
+     * instead of receiving the whole GameState on every change.
+     */
+    static constexpr std::string_view ENV_VAR_LOCKSTEP = "ROYAL_BLOCKS_LOCKSTEP";
+
     asio::io_context context_;
 
     RegistrationState registrationState_;
@@ -94,7 +121,10 @@ class Controller {
 
     std::vector<bindings::User> friendsList_;
     std::unordered_map<UserID, NameConversation> conversationsById_;
-    std::vector<std::pair<std::string, Score>> ranking_;
+    // the top of the ranking and the player's neighbours (see
+    // bindings::Ranking), plus the pages asked since
+    std::vector<bindings::RankingEntry> ranking_;
+    size_t ownRank_ = 0;
     std::vector<bindings::User> pendingFriendRequests_;
 
     config::ServerInfo serverInfo_;
@@ -104,6 +134,37 @@ class Controller {
      */
     NetworkManager networkManager_;
 
+    /**
+     * @brief The replay being watched, nullptr when playing online.
+     */
+    std::unique_ptr<ReplayPlayer> pReplayPlayer_;
+    asio::steady_timer replayTimer_;
+    std::chrono::steady_clock::time_point lastReplayFrame_;
+
+    bool lockstepEnabled_;
+
+    /**
+     * @brief The locally simulated game in lockstep mode, nullptr otherwise.
+     */
+    std::unique_ptr<LockstepGame> pLockstepGame_;
+    // set when the server's inputs didn't match the simulation's tick
+    bool lockstepDesynced_;
+
+    /**
+     * @brief Predicts the player's own Tetris while the server's GameState
+     * for the latest inputs is on its way.
+     */
+    InputPredictor inputPredictor_;
+
+    /**
+     * @brief The last GameState received from the server (serialized) and its
+     * number, the base of the next GameStateDelta.
+     */
+    nlohmann::json lastGameStateJson_;
+    bindings::GameStateID lastGameStateID_;
+    // set once a full GameState was requested, until it is received
+    bool gameStateSnapshotRequested_;
+
     /**
      * @brief Handles the received packet
      */
@@ -116,6 +177,80 @@ class Controller {
      */
     void updateFriendState(const bindings::User &updatedFriend);
 
+    /**
+     * @brief Schedules the next replay frame.
+     */
+    void scheduleReplayFrame();
+
+    /**
+     * @brief Advances the replay and refreshes the display.
+     *
+     * @return False once the replay was quit.
+     */
+    bool onReplayFrame();
+
+    /**
+     * @brief Handles the replay controls, returns false if the key isn't one.
+     */
+    bool handleReplayKeyPress(const std::string &pressedKey);
+
+    /**
+     * @brief Predicts the given input of the player and refreshes the
+     * display.
+     *
+     * @return The sequence number to send along with the input, 0 when not
+     * predicting (viewing, lockstep mode or replay).
+     */
+    bindings::InputSeq predictInput(const GameAction &gameAction);
+
+    /**
+     * @brief Updates the displayed GameState (player's or viewer's) with the
+     * given serialized GameState received from the server. Must be called
+     * with the mutex locked.
+     */
+    void updateGameState(const nlohmann::json &j_gameState,
+                         bindings::InputSeq lastInputSeq);
+
+    /**
+     * @brief Adds the given player to the known part of the ranking, in
+     * place of the player that had the same rank. Must be called with the
+     * mutex locked.
+     */
+    void addRankingEntry(bindings::RankingEntry &&entry);
+
+    /**
+     * @brief Moves a player in the known part of the ranking, and the players
+     * they overtook. Must be called with the mutex locked.
+     */
+    void handleRankingDelta(bindings::RankingDelta &&rankingDelta);
+
+    /**
+     * @brief Prepends the given page of older messages to its conversation,
+     * unless it doesn't end where the conversation starts. Must be called
+     * with the mutex locked.
+     */
+    void handleConversationPage(bindings::ConversationPage &&conversationPage);
+
+    /**
+     * @brief Displays the given GameState or GameStateViewer binding and
+     * keeps it as the base of the next GameStateDelta. Must be called with
+     * the mutex locked.
+     */
+    void handleGameState(bindings::ReceivedGameState &&receivedGameState);
+
+    /**
+     * @brief Applies the given GameStateDelta binding to the last received
+     * GameState, or requests a full GameState if it isn't the delta's base.
+     * Must be called with the mutex locked.
+     */
+    void handleGameStateDelta(const bindings::GameStateDelta &gameStateDelta);
+
+    /**
+     * @brief Handles the lockstep bindings (LockstepSync, GameInput and
+     * EngineTick). Must be called with the mutex locked.
+     */
+    void handleLockstepPacket(const bindings::ServerPacket &packet);
+
   public:
     /**
      * @brief Construct a new Controller object
@@ -159,6 +294,29 @@ class Controller {
      */
     void run(std::unique_ptr<AbstractDisplay> &&pAbstractDisplay);
 
+    /**
+     * @brief Plays the given replay file offline, without connecting to the
+     * server.
+     *
+     * @param replayPath The replay file (.rbr) to play.
+     * @param pAbstractDisplay The display to use (GUI or TUI)
+     *
+     * @throws std::runtime_error if the replay file can't be read.
+     */
+    void runReplay(const std::filesystem::path &replayPath,
+                   std::unique_ptr<AbstractDisplay> &&pAbstractDisplay);
+
+    /**
+     * @brief Returns true if a replay is being watched.
+     */
+    bool isReplaying() const;
+
+    /**
+     * @brief Returns the status of the watched replay, nullopt if there is
+     * none.
+     */
+    std::optional<ReplayStatus> getReplayStatus() const;
+
     /**
      * @brief Sets the server's info (ip, port).
      */
@@ -186,9 +344,21 @@ class Controller {
     void tryLogin(const std::string &username, const std::string &password);
 
     /**
-     * @brief Get the ranking of the players of the Endless mode
+     * @brief Get the known part of the ranking of the players of the Endless
+     * mode, sorted by rank
      */
-    std::vector<std::pair<std::string, Score>> getRanking() const;
+    std::vector<bindings::RankingEntry> getRanking() const;
+
+    /**
+     * @brief Get the rank of the player in the ranking of the Endless mode
+     */
+    size_t getOwnRank() const;
+
+    /**
+     * @brief Asks the server for the players that follow the top of the
+     * ranking known by the client
+     */
+    void requestRankingPage();
 
     /**
      * @brief Change the profile of the user by changing the username and
@@ -254,6 +424,12 @@ class Controller {
      */
     const NameConversation getConversationWith(UserID userID);
 
+    /**
+     * @brief Asks the server for the page of messages that precedes the
+     * conversation history with the specified user, if there is one.
+     */
+    void requestOlderMessages(UserID userID);
+
     /**
      * @brief Returns the number of effects in the GameState.
      */
@@ -0,0 +1,114 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lockstep_game.hpp"
+
+#include "byte_stream/byte_reader.hpp"
+#include "game_log/game_log.hpp"
+
+
+namespace {
+
+    /**
+     * @brief Returns the GameState at the keyframe of the given sync.
+     */
+    GameStatePtr loadKeyframe(const bindings::LockstepSync &sync) {
+        GameStatePtr pGameState =
+            GameLog::createGameState(sync.gameMode, sync.seed, sync.players);
+
+        if (!sync.snapshot.empty()) {
+            ByteReader snapshotReader{sync.snapshot};
+            pGameState->readSnapshot(snapshotReader);
+        }
+
+        return pGameState;
+    }
+
+} // namespace
+
+
+LockstepGame::LockstepGame(const bindings::LockstepSync &sync)
+    : selfID_{sync.selfID}, pGameState_{loadKeyframe(sync)},
+      engine_{pGameState_}, tick_{sync.keyframeTick} {
+    for (const bindings::LockstepSync::Input &input : sync.inputs) {
+        while (tick_ < input.tick) {
+            engine_.tick();
+            tick_++;
+        }
+        applyGameAction(engine_, input.userID, input.action);
+    }
+
+    while (tick_ < sync.numTicks) {
+        engine_.tick();
+        tick_++;
+    }
+
+    if (engine_.gameIsFinished()) {
+        pGameState_->setIsFinished();
+    }
+}
+
+bool LockstepGame::applyInput(size_t tick, UserID userID,
+                              const GameAction &action) {
+    if (tick != tick_) {
+        return false;
+    }
+
+    applyGameAction(engine_, userID, action);
+
+    if (engine_.gameIsFinished()) {
+        pGameState_->setIsFinished();
+    }
+
+    return true;
+}
+
+bool LockstepGame::tick(size_t tick) {
+    if (tick != tick_ + 1) {
+        return false;
+    }
+
+    engine_.tick();
+    tick_++;
+
+    if (engine_.gameIsFinished()) {
+        pGameState_->setIsFinished();
+    }
+
+    return true;
+}
+
+size_t LockstepGame::getTick() const { return tick_; }
+
+uint64_t LockstepGame::computeHash() const {
+    return pGameState_->computeHash();
+}
+
+std::variant<client::GameState, client::GameStateViewer>
+LockstepGame::getClientGameState() const {
+    if (selfID_.has_value()) {
+        client::GameState gameState;
+        gameState.deserialize(pGameState_->serializeForPlayer(*selfID_));
+
+        return gameState;
+    }
+
+    client::GameStateViewer gameStateViewer;
+    gameStateViewer.deserialize(pGameState_->serializeForViewer());
+
+    return gameStateViewer;
+}
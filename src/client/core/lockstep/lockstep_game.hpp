@@ -0,0 +1,95 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCKSTEP_GAME_HPP
+#define LOCKSTEP_GAME_HPP
+
+#include "../../../common/bindings/in_game/lockstep_sync.hpp"
+#include "../../../common/types/types.hpp"
+#include "../in_game/game_state/game_state.hpp"
+#include "../in_game/game_state/game_state_viewer.hpp"
+#include "game_engine/game_engine.hpp"
+#include "game_log/game_action.hpp"
+#include "game_state/game_state.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <variant>
+
+/**
+ * @class LockstepGame
+ *
+ * @brief Local simulation of an online game in lockstep mode: the server only
+ * sends the inputs it accepted and its engine ticks, which are applied here on
+ * a GameEngine seeded like the server's.
+ */
+class LockstepGame {
+  private:
+    // nullopt when viewing the game
+    std::optional<UserID> selfID_;
+
+    GameStatePtr pGameState_;
+    GameEngine engine_;
+
+    size_t tick_;
+
+  public:
+    /**
+     * @brief Rebuilds the current state of the game from the keyframe and
+     * the inputs sent by the server.
+     */
+    explicit LockstepGame(const bindings::LockstepSync &sync);
+    LockstepGame(const LockstepGame &) = delete;
+    LockstepGame(LockstepGame &&) = default;
+    LockstepGame &operator=(const LockstepGame &) = delete;
+    LockstepGame &operator=(LockstepGame &&) = default;
+
+    ~LockstepGame() = default;
+
+    /**
+     * @brief Applies an input accepted by the server.
+     *
+     * @return False if the input was stamped with another tick than the
+     * simulation's (i.e. the simulation is out of sync).
+     */
+    bool applyInput(size_t tick, UserID userID, const GameAction &action);
+
+    /**
+     * @brief Makes the engine tick.
+     *
+     * @return False if the server's tick isn't the next one.
+     */
+    bool tick(size_t tick);
+
+    size_t getTick() const;
+
+    /**
+     * @brief Returns the hash of the simulated GameState, see
+     * GameState::computeHash().
+     */
+    uint64_t computeHash() const;
+
+    /**
+     * @brief Returns the simulated GameState as the server would have sent
+     * it.
+     */
+    std::variant<client::GameState, client::GameStateViewer>
+    getClientGameState() const;
+};
+
+#endif // LOCKSTEP_GAME_HPP
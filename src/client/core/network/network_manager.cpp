@@ -17,7 +17,7 @@
 
 #include "network_manager.hpp"
 
-#include "../../../common/bindings/constants.hpp"
+#include "../../../common/bindings/framing.hpp"
 #include "core/server_info/server_info.hpp"
 
 #include <chrono>
@@ -49,6 +49,10 @@ bool NetworkManager::connect() {
     socket_.async_connect(endpoint, [this](asio::error_code ec) {
         if (!ec) {
             isConnected_ = true;
+            readBuf_.clear();
+            // asks for the length-prefixed framing
+            writeBytes(std::make_shared<const std::string>(
+                bindings::FRAMING_MAGIC));
             receive(); // Start reading once connected
         } else {
             retry(); // Retry if connection fails
@@ -94,15 +98,41 @@ void NetworkManager::setServerInfo(const config::ServerInfo &serverInfo) {
     }
 }
 
+std::size_t NetworkManager::handleFrames() {
+    std::size_t offset = 0;
+    std::size_t requiredSize = bindings::FRAME_HEADER_SIZE;
+
+    while (readBuf_.size() - offset >= bindings::FRAME_HEADER_SIZE) {
+        const uint32_t length = bindings::decodeFrameHeader(
+            std::span<const char, bindings::FRAME_HEADER_SIZE>{
+                readBuf_.data() + offset, bindings::FRAME_HEADER_SIZE});
+
+        const std::size_t frameSize = bindings::FRAME_HEADER_SIZE + length;
+        if (readBuf_.size() - offset < frameSize) {
+            requiredSize = frameSize;
+            break;
+        }
+
+        // parsed in place, straight from the read buffer
+        packetHandler_(std::string_view{
+            readBuf_.data() + offset + bindings::FRAME_HEADER_SIZE, length});
+        offset += frameSize;
+    }
+
+    // drops the handled frames all at once
+    readBuf_.erase(0, offset);
+
+    return requiredSize;
+}
+
 void NetworkManager::receive() {
-    asio::async_read_until(
+    const std::size_t requiredSize = handleFrames();
+
+    asio::async_read(
         socket_, asio::dynamic_buffer(readBuf_),
-        bindings::PACKET_DELIMITER,
-        [this](asio::error_code ec, std::size_t length) {
+        asio::transfer_at_least(requiredSize - readBuf_.size()),
+        [this](asio::error_code ec, std::size_t /*length*/) {
             if (!ec) {
-                std::string_view packetView{readBuf_.data(), length - 1};
-                packetHandler_(packetView);
-                readBuf_.erase(0, length);
                 receive(); // Continue listening for messages
             } else {
                 disconnect();
@@ -130,15 +160,23 @@ void NetworkManager::start(const config::ServerInfo &serverInfo) {
     connect();
 }
 
+void NetworkManager::writeBytes(std::shared_ptr<const std::string> bytes) {
+    asio::async_write(socket_, asio::buffer(*bytes),
+                      [bytes](asio::error_code ec, size_t /*length*/) {
+                          if (ec) {
+                              std::cerr << "error while sending packet: " << ec
+                                        << std::endl;
+                          }
+                      });
+}
+
 void NetworkManager::send(const std::string &message) {
-    asio::async_write(
-        socket_,
-        asio::buffer(message + std::string(bindings::PACKET_DELIMITER)),
-        [](asio::error_code ec, size_t /*length*/) {
-            if (ec) {
-                std::cerr << "error while sending packet: " << ec << std::endl;
-            }
-        });
+    const bindings::FrameHeader header =
+        bindings::encodeFrameHeader(static_cast<uint32_t>(message.size()));
+
+    auto package = std::make_shared<std::string>(header.begin(), header.end());
+    package->append(message);
+    writeBytes(std::move(package));
 }
 
 bool NetworkManager::isConnected() const { return isConnected_; }
@@ -20,6 +20,7 @@
 
 #include <asio.hpp>
 #include <functional>
+#include <memory>
 #include <stdint.h>
 #include <string>
 #include <string_view>
@@ -72,6 +73,18 @@ class NetworkManager {
      */
     void receive();
 
+    /**
+     * @brief Handles the frames at the front of the read buffer, then
+     * returns the size the read buffer must reach to hold the next one
+     */
+    std::size_t handleFrames();
+
+    /**
+     * @brief Writes the given bytes on the socket, they are kept alive until
+     * they are sent
+     */
+    void writeBytes(std::shared_ptr<const std::string> bytes);
+
     /**
      * @brief Attempt to connect again.
      */
@@ -0,0 +1,144 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "input_predictor.hpp"
+
+#include "effect/penalty/penalty_type.hpp"
+
+#include <nlohmann/json.hpp>
+#include <variant>
+
+namespace {
+
+    TetrominoMove invertTetrominoMove(TetrominoMove tetrominoMove) {
+        switch (tetrominoMove) {
+        case TetrominoMove::Left:
+            return TetrominoMove::Right;
+        case TetrominoMove::Right:
+            return TetrominoMove::Left;
+        default:
+            return tetrominoMove;
+        }
+    }
+
+} // namespace
+
+void InputPredictor::predict(const GameAction &gameAction) {
+    if (!isPredicting_) {
+        return;
+    }
+
+    const auto *pMoveActive = std::get_if<game_action::MoveActive>(&gameAction);
+    const auto *pRotateActive =
+        std::get_if<game_action::RotateActive>(&gameAction);
+
+    if (pMoveActive == nullptr && pRotateActive == nullptr) {
+        isPredicting_ = false;
+    } else if (ignoresInputs_) {
+        // the server won't move the tetromino
+        return;
+    } else if (!hasActiveTetromino_) {
+        // blacked out board
+        isPredicting_ = false;
+    } else if (pMoveActive != nullptr) {
+        const TetrominoMove tetrominoMove =
+            reverseControls_ ? invertTetrominoMove(pMoveActive->tetrominoMove)
+                             : pMoveActive->tetrominoMove;
+
+        if (tetrominoMove == TetrominoMove::Down
+            && !tetris_.checkCanDropActive()) {
+            // places the tetromino
+            isPredicting_ = false;
+            return;
+        }
+
+        tetris_.eventTryMoveActive(tetrominoMove);
+    } else {
+        tetris_.eventTryRotateActive(reverseControls_
+                                         ? !pRotateActive->rotateClockwise
+                                         : pRotateActive->rotateClockwise);
+    }
+}
+
+InputPredictor::InputPredictor()
+    : nextSeq_{1}, hasActiveTetromino_{false}, ignoresInputs_{false},
+      reverseControls_{false}, isPredicting_{false} {}
+
+bindings::InputSeq InputPredictor::pushInput(const GameAction &gameAction) {
+    const bindings::InputSeq seq = nextSeq_++;
+    if (nextSeq_ == 0) {
+        // 0 means "not numbered"
+        nextSeq_ = 1;
+    }
+
+    pendingInputs_.push_back(PendingInput{seq, gameAction});
+    predict(gameAction);
+
+    return seq;
+}
+
+void InputPredictor::reconcile(bindings::InputSeq lastInputSeq,
+                               const nlohmann::json &j_tetris,
+                               const client::PlayerStateSelf &playerState) {
+    while (!pendingInputs_.empty()
+           && pendingInputs_.front().seq <= lastInputSeq) {
+        pendingInputs_.pop_front();
+    }
+
+    tetris_.deserializeSelf(j_tetris);
+    hasActiveTetromino_ = !j_tetris.at("activeTetromino").is_null();
+
+    const bool hasActivePenalty = playerState.activePenalty.has_value();
+    ignoresInputs_ =
+        !playerState.isAlive
+        || (hasActivePenalty
+            && playerState.activePenalty->penaltyType == PenaltyType::InputLock);
+    reverseControls_ =
+        hasActivePenalty
+        && playerState.activePenalty->penaltyType
+               == PenaltyType::ReverseControls;
+
+    isPredicting_ = true;
+    for (const PendingInput &pendingInput : pendingInputs_) {
+        predict(pendingInput.gameAction);
+    }
+}
+
+void InputPredictor::applyTo(client::GameState &gameState) const {
+    if (pendingInputs_.empty() || !hasActiveTetromino_) {
+        // nothing predicted: the server's state is up to date
+        return;
+    }
+
+    const nlohmann::json j_tetris = tetris_.serializeSelf();
+    client::TetrisSelf &tetrisSelf = gameState.self.tetris;
+
+    tetrisSelf.activeTetromino = client::Tetromino{};
+    tetrisSelf.activeTetromino->deserialize(j_tetris.at("activeTetromino"));
+    tetrisSelf.previewTetromino = client::Tetromino{};
+    tetrisSelf.previewTetromino->deserialize(j_tetris.at("previewTetromino"));
+}
+
+size_t InputPredictor::getNumPendingInputs() const {
+    return pendingInputs_.size();
+}
+
+void InputPredictor::reset() {
+    pendingInputs_.clear();
+    hasActiveTetromino_ = false;
+    isPredicting_ = false;
+}
@@ -0,0 +1,119 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUT_PREDICTOR_HPP
+#define INPUT_PREDICTOR_HPP
+
+#include "../../../common/bindings/in_game/input_seq.hpp"
+#include "../in_game/game_state/game_state.hpp"
+#include "../in_game/player_state/player_state_self.hpp"
+#include "game_log/game_action.hpp"
+#include "tetris/tetris.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <nlohmann/json_fwd.hpp>
+
+/**
+ * @class InputPredictor
+ *
+ * @brief Client-side prediction of the player's own Tetris: the inputs are
+ * applied locally as soon as they are sent instead of after a round trip to
+ * the server.
+ *
+ * Every input gets a sequence number, and the server echoes the last one it
+ * applied in the player's GameState. When such a state arrives, the predicted
+ * Tetris is rebuilt from it and the inputs the server hasn't applied yet are
+ * applied again on top of it.
+ *
+ * Only the moves and rotations of the active Tetromino are predicted: the
+ * inputs that place it (BigDrop, a Down move at the bottom) or hold it need
+ * the tetrominoes queue, which the client doesn't know. The prediction stops
+ * at the first such input until the server has applied it.
+ */
+class InputPredictor {
+  private:
+    struct PendingInput {
+        bindings::InputSeq seq;
+        GameAction gameAction;
+    };
+
+    bindings::InputSeq nextSeq_;
+
+    // inputs sent but not applied in the last state received from the server
+    std::deque<PendingInput> pendingInputs_;
+
+    // last Tetris received from the server, with the pending inputs applied
+    Tetris tetris_;
+    bool hasActiveTetromino_;
+
+    // the server ignores the inputs of a dead player or with InputLock
+    bool ignoresInputs_;
+    bool reverseControls_;
+
+    // false once an input that can't be predicted was met
+    bool isPredicting_;
+
+    /**
+     * @brief Applies the given input to the predicted Tetris as the server's
+     * GameEngine would, or stops the prediction if it can't be predicted.
+     */
+    void predict(const GameAction &gameAction);
+
+  public:
+    InputPredictor();
+    InputPredictor(const InputPredictor &) = delete;
+    InputPredictor(InputPredictor &&) = default;
+    InputPredictor &operator=(const InputPredictor &) = delete;
+    InputPredictor &operator=(InputPredictor &&) = default;
+
+    ~InputPredictor() = default;
+
+    /**
+     * @brief Registers an input about to be sent to the server and predicts
+     * it.
+     *
+     * @return The sequence number to send along with the input.
+     */
+    bindings::InputSeq pushInput(const GameAction &gameAction);
+
+    /**
+     * @brief Rebuilds the prediction from a state received from the server.
+     *
+     * @param lastInputSeq The last input applied to that state.
+     * @param j_tetris The player's serialized Tetris (Tetris::serializeSelf()).
+     * @param playerState The player's state.
+     */
+    void reconcile(bindings::InputSeq lastInputSeq,
+                   const nlohmann::json &j_tetris,
+                   const client::PlayerStateSelf &playerState);
+
+    /**
+     * @brief Replaces the active and preview tetrominoes of the given
+     * GameState by the predicted ones.
+     */
+    void applyTo(client::GameState &gameState) const;
+
+    size_t getNumPendingInputs() const;
+
+    /**
+     * @brief Forgets the pending inputs (e.g. when leaving a game).
+     */
+    void reset();
+};
+
+#endif // INPUT_PREDICTOR_HPP
@@ -0,0 +1,128 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "replay_player.hpp"
+
+#include "game_log/game_log.hpp"
+
+#include <algorithm>
+#include <vector>
+
+ReplayPlayer::ReplayPlayer(ReplayReader &&reader)
+    : replayer_{std::move(reader)}, isPaused_{false},
+      speedIdx_{DEFAULT_SPEED_IDX}, positionMs_{0} {}
+
+void ReplayPlayer::update(std::chrono::steady_clock::duration elapsed) {
+    if (isPaused_) {
+        return;
+    }
+
+    const double durationMs =
+        static_cast<double>(replayer_.getReader().getDurationMs());
+
+    positionMs_ = std::min(
+        durationMs,
+        positionMs_
+            + std::chrono::duration<double, std::milli>(elapsed).count()
+                  * SPEEDS.at(speedIdx_));
+
+    replayer_.advanceTo(static_cast<uint64_t>(positionMs_));
+
+    if (positionMs_ >= durationMs) {
+        isPaused_ = true;
+    }
+}
+
+void ReplayPlayer::togglePause() {
+    // restart from the beginning when resuming at the end
+    if (isPaused_
+        && static_cast<uint64_t>(positionMs_)
+               >= replayer_.getReader().getDurationMs()) {
+        seek(0);
+    }
+
+    isPaused_ = !isPaused_;
+}
+
+void ReplayPlayer::speedUp() {
+    speedIdx_ = std::min(speedIdx_ + 1, SPEEDS.size() - 1);
+}
+
+void ReplayPlayer::slowDown() {
+    speedIdx_ = (speedIdx_ == 0) ? 0 : speedIdx_ - 1;
+}
+
+void ReplayPlayer::seek(uint64_t positionMs) {
+    positionMs = std::min(positionMs, replayer_.getReader().getDurationMs());
+
+    positionMs_ = static_cast<double>(positionMs);
+    replayer_.seekTimestamp(positionMs);
+}
+
+void ReplayPlayer::seekRelative(int64_t offsetMs) {
+    const int64_t positionMs = static_cast<int64_t>(positionMs_) + offsetMs;
+    seek(static_cast<uint64_t>(std::max<int64_t>(positionMs, 0)));
+}
+
+void ReplayPlayer::followNextPlayer() {
+    const std::vector<GameLogPlayer> &players =
+        replayer_.getReader().getPlayers();
+
+    auto it = std::find_if(players.begin(), players.end(),
+                           [this](const GameLogPlayer &player) {
+                               return followedPlayer_ == player.userID;
+                           });
+
+    if (!followedPlayer_.has_value()) {
+        it = players.begin();
+    } else if (it != players.end()) {
+        ++it;
+    }
+
+    followedPlayer_ = (it != players.end())
+                          ? std::make_optional(it->userID)
+                          : std::nullopt;
+}
+
+ReplayStatus ReplayPlayer::getStatus() const {
+    return ReplayStatus{
+        static_cast<uint64_t>(positionMs_),
+        replayer_.getReader().getDurationMs(),
+        SPEEDS.at(speedIdx_),
+        isPaused_,
+        followedPlayer_,
+    };
+}
+
+std::variant<client::GameState, client::GameStateViewer>
+ReplayPlayer::getClientGameState() const {
+    const GameStatePtr pGameState = replayer_.getGameState();
+
+    if (followedPlayer_.has_value()) {
+        client::GameState gameState;
+        gameState.deserialize(pGameState->serializeForPlayer(*followedPlayer_));
+        gameState.isFinished = false;
+
+        return gameState;
+    }
+
+    client::GameStateViewer gameStateViewer;
+    gameStateViewer.deserialize(pGameState->serializeForViewer());
+    gameStateViewer.isFinished = false;
+
+    return gameStateViewer;
+}
@@ -0,0 +1,127 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAY_PLAYER_HPP
+#define REPLAY_PLAYER_HPP
+
+#include "../../../common/types/types.hpp"
+#include "../in_game/game_state/game_state.hpp"
+#include "../in_game/game_state/game_state_viewer.hpp"
+#include "game_replayer/game_replayer.hpp"
+#include "replay/replay_reader.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <variant>
+
+/**
+ * @brief What the displays need to know to draw the replay controls.
+ */
+struct ReplayStatus {
+    uint64_t positionMs;
+    uint64_t durationMs;
+    double speed;
+    bool isPaused;
+    // nullopt when watching every player
+    std::optional<UserID> followedPlayer;
+};
+
+/**
+ * @class ReplayPlayer
+ *
+ * @brief Plays a replay file back in real time on a locally simulated
+ * GameEngine (see GameReplayer), without any server.
+ *
+ * The player keeps its own clock, scaled by the selected speed, and the
+ * replayer is advanced to it on each update(). Seeking goes through the
+ * replay's keyframes so scrubbing only re-simulates a few ticks.
+ */
+class ReplayPlayer {
+  public:
+    static constexpr std::array<double, 7> SPEEDS{0.25, 0.5, 1, 2, 4, 8, 16};
+
+  private:
+    static constexpr size_t DEFAULT_SPEED_IDX = 2;
+
+    GameReplayer replayer_;
+
+    bool isPaused_;
+    size_t speedIdx_;
+    double positionMs_;
+
+    std::optional<UserID> followedPlayer_;
+
+  public:
+    explicit ReplayPlayer(ReplayReader &&reader);
+    ReplayPlayer(const ReplayPlayer &) = delete;
+    ReplayPlayer(ReplayPlayer &&) = default;
+    ReplayPlayer &operator=(const ReplayPlayer &) = delete;
+    ReplayPlayer &operator=(ReplayPlayer &&) = default;
+
+    ~ReplayPlayer() = default;
+
+    /**
+     * @brief Advances the replay by the given amount of real time (scaled by
+     * the speed), unless paused. Pauses at the end of the replay.
+     */
+    void update(std::chrono::steady_clock::duration elapsed);
+
+    void togglePause();
+
+    /**
+     * @brief Selects the next faster speed (up to 16x).
+     */
+    void speedUp();
+
+    /**
+     * @brief Selects the next slower speed (down to 0.25x).
+     */
+    void slowDown();
+
+    /**
+     * @brief Moves the replay to the given time (clamped to its duration).
+     */
+    void seek(uint64_t positionMs);
+
+    /**
+     * @brief Moves the replay by the given offset (negative goes backwards).
+     */
+    void seekRelative(int64_t offsetMs);
+
+    /**
+     * @brief Cycles between watching every player and following each of them
+     * (seeing their hold, queue, score...).
+     */
+    void followNextPlayer();
+
+    ReplayStatus getStatus() const;
+
+    /**
+     * @brief Returns the replayed GameState as a live game would have sent it:
+     * as the followed player, or as a viewer.
+     *
+     * @note The state is never marked as finished so that the game display
+     * keeps showing the boards at the end of the replay.
+     */
+    std::variant<client::GameState, client::GameStateViewer>
+    getClientGameState() const;
+};
+
+#endif // REPLAY_PLAYER_HPP
@@ -103,6 +103,24 @@ namespace GUI {
                 &MessageMenu::updateAll);
         connect(&messageInput_, &QLineEdit::returnPressed, this,
                 &MessageMenu::onEnterKeyPressedInInput);
+        // only the player's scrolling, not the one of loadMessages()
+        connect(chatDisplay_.verticalScrollBar(),
+                &QScrollBar::actionTriggered, this,
+                &MessageMenu::onChatScrolled);
+    }
+
+    void MessageMenu::onChatScrolled() {
+        QScrollBar *scrollBar = chatDisplay_.verticalScrollBar();
+        if (scrollBar->sliderPosition() != scrollBar->minimum()) {
+            return;
+        }
+
+        int friendIndex = friendsList_.currentRow();
+        std::vector<bindings::User> friends = controller_.getFriendsList();
+        if (friendIndex < 0 || friendIndex >= static_cast<int>(friends.size()))
+            return;
+
+        controller_.requestOlderMessages(friends[friendIndex].userID);
     }
 
     void MessageMenu::onEnterKeyPressedInInput() {
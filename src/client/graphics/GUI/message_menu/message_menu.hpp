@@ -72,6 +72,12 @@ namespace GUI {
          */
         void onEnterKeyPressedInInput();
 
+        /**
+         * @brief Ask for the older messages when the player scrolls to the
+         * top of the chat
+         */
+        void onChatScrolled();
+
       public:
         MessageMenu(Controller &controller, TetrisWindow &tetrisWindow,
                     QWidget *parent = nullptr);
@@ -19,6 +19,7 @@
 
 #include "graphics/GUI/tetris_window.hpp"
 
+#include <QFont>
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QPushButton>
@@ -43,6 +44,8 @@ namespace GUI {
         }); 
     }
 
+    void Ranking::on_MoreButtonClicked() { controller_.requestRankingPage(); }
+
     /*--------------------------------------------------------
                         Private Methods
     ---------------------------------------------------------*/
@@ -58,6 +61,14 @@ namespace GUI {
         backButton->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
         backButton->setFixedWidth(500);
 
+        QPushButton *moreButton = new QPushButton(this);
+        moreButton->setAutoDefault(true);
+        moreButton->setText("Show more players");
+        moreButton->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+        moreButton->setFixedWidth(500);
+        connect(moreButton, &QPushButton::clicked, this,
+                &Ranking::on_MoreButtonClicked);
+
         setupRankingTable();
         updateRankingTable();
 
@@ -69,6 +80,7 @@ namespace GUI {
         scrollLayout->addItem(new QSpacerItem(20, 40, QSizePolicy::Minimum,
                                               QSizePolicy::Expanding));
         scrollLayout->addWidget(&rankingTable_, 0, Qt::AlignCenter);
+        scrollLayout->addWidget(moreButton, 0, Qt::AlignCenter);
         scrollLayout->addWidget(backButton, 0, Qt::AlignCenter);
         scrollLayout->addItem(new QSpacerItem(20, 40, QSizePolicy::Minimum,
                                               QSizePolicy::Expanding));
@@ -88,7 +100,7 @@ namespace GUI {
     }
 
     void Ranking::setupRankingTable() {
-        std::vector<std::pair<std::string, Score>> RankingGuiData =
+        std::vector<bindings::RankingEntry> RankingGuiData =
             controller_.getRanking();
 
         rankingTable_.setRowCount(RankingGuiData.size());
@@ -113,22 +125,37 @@ namespace GUI {
     }
 
     void Ranking::updateRankingTable() {
-        std::vector<std::pair<std::string, Score>> RankingGuiData =
+        std::vector<bindings::RankingEntry> RankingGuiData =
             controller_.getRanking();
+        const size_t ownRank = controller_.getOwnRank();
 
         rankingTable_.setRowCount(RankingGuiData.size());
 
+        QStringList ranks;
         for (size_t i = 0; i < RankingGuiData.size(); ++i) {
-            QTableWidgetItem *playerItem = new QTableWidgetItem(
-                QString::fromStdString(RankingGuiData[i].first));
+            const bindings::RankingEntry &entry = RankingGuiData[i];
+            ranks << QString::number(entry.rank);
+
+            QTableWidgetItem *playerItem =
+                new QTableWidgetItem(QString::fromStdString(entry.username));
             playerItem->setTextAlignment(Qt::AlignCenter);
             QTableWidgetItem *scoreItem =
-                new QTableWidgetItem(QString::number(RankingGuiData[i].second));
+                new QTableWidgetItem(QString::number(entry.score));
             scoreItem->setTextAlignment(Qt::AlignCenter);
 
+            if (entry.rank == ownRank) {
+                QFont font = playerItem->font();
+                font.setBold(true);
+                playerItem->setFont(font);
+                scoreItem->setFont(font);
+            }
+
             rankingTable_.setItem(i, 0, playerItem);
             rankingTable_.setItem(i, 1, scoreItem);
         }
+        // the ranks aren't contiguous between the top and the player's
+        // neighbours
+        rankingTable_.setVerticalHeaderLabels(ranks);
     }
 
 } // namespace GUI
@@ -72,6 +72,12 @@ namespace GUI {
          * @brief Action to perform when the user click on the back button
          */
         void on_BackButtonClicked();
+
+        /*
+         * @brief Action to perform when the user click on the show more
+         * button: ask for the next players of the ranking
+         */
+        void on_MoreButtonClicked();
     };
 
 } // namespace GUI
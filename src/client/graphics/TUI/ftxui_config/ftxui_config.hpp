@@ -61,11 +61,13 @@ namespace TUI {
         STR_WELCOME = "Welcome to the main menu of Tetris Royal !",
         STR_SCORE = "Score", STR_USER = "User",
         STR_ENDLESS_RANKING = "Endless mod Ranking",
+        STR_MORE_PLAYERS = "Show more players", STR_RANKING_GAP = "...",
         STR_NEW_PASSWORD = "New password", STR_NEW_USERNAME = "New username",
         STR_PROFILE_MANAGER = "Profile Manager",
         STR_CHANGE_INFO = "You can change your username and password here",
         STR_SEND = "Send", STR_WRITE_MESSAGE = "Write a message...",
         STR_NO_CONVERSATION = "No conversation",
+        STR_OLDER_MESSAGES = "(PageUp: older messages)",
         STR_FRIENDS_LIST_TITLE = " --- FRIENDS LIST --- ",
         STR_CONVERSATION_TITLE = " --- CONVERSATION --- ",
         STR_ADD_FRIEND_TITLE = "-- Add a friend --",
@@ -90,7 +92,9 @@ namespace TUI {
         STR_IP = "IP address",
         STR_PORT = "Port",
         STR_CONNECT_TO_SERVER = "Connect to server",
-        STR_PORT_INVALID = "Port must be a number between 1 and 65535. Port as not been saved in the config file.";
+        STR_PORT_INVALID = "Port must be a number between 1 and 65535. Port as not been saved in the config file.",
+        STR_REPLAY_CONTROLS = "[space] play/pause  [←/→] seek  [-/+] speed  "
+                              "[0-9] jump  [p] follow player  [q] quit";
 
     inline const ftxui::Element WELCOME_TITLE = ftxui::vbox({
         ftxui::text(
@@ -36,6 +36,7 @@
 
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <variant>
@@ -470,6 +471,52 @@ namespace TUI {
 
     ftxui::Component GameDisplay::rightPane() { return opponentsBoards(); }
 
+    //----------------------------------------------------------------------------
+    //                          Replay
+    //----------------------------------------------------------------------------
+
+    namespace {
+
+        std::string formatReplayTime(uint64_t timeMs) {
+            const uint64_t seconds = timeMs / 1000;
+            const std::string secondsStr = std::to_string(seconds % 60);
+
+            return std::to_string(seconds / 60) + ":"
+                   + (secondsStr.size() < 2 ? "0" : "") + secondsStr;
+        }
+
+    } // namespace
+
+    ftxui::Component GameDisplay::replayControls() {
+        return ftxui::Renderer([this] {
+            const ReplayStatus status = getReplayStatus().value();
+
+            std::ostringstream speed;
+            speed << status.speed << "x";
+
+            const float progress =
+                status.durationMs == 0
+                    ? 1.0f
+                    : static_cast<float>(status.positionMs)
+                          / static_cast<float>(status.durationMs);
+
+            return ftxui::vbox({
+                       ftxui::hbox({
+                           ftxui::text(status.isPaused ? "⏸ " : "▶ "),
+                           ftxui::text(formatReplayTime(status.positionMs)
+                                       + " / "
+                                       + formatReplayTime(status.durationMs)
+                                       + "  "),
+                           ftxui::gauge(progress) | ftxui::flex,
+                           ftxui::text("  " + speed.str()),
+                       }),
+                       ftxui::text(std::string(STR_REPLAY_CONTROLS))
+                           | ftxui::dim | ftxui::center,
+                   })
+                   | ftxui::borderRounded;
+        });
+    }
+
     ftxui::Component &GameDisplay::drawEndlessMode() {
         displayWindow_ = ftxui::Container::Horizontal({
                              leftPane(),
@@ -597,7 +644,10 @@ namespace TUI {
             updateGameState();
 
             if (gameIsFinished()) {
-                if (isWinner()) {
+                if (getReplayStatus().has_value()) {
+                    // the replay was quit
+                    mainTui_.stopRender();
+                } else if (isWinner()) {
                     gameContainer->Add(drawWin());
                 } else {
                     gameContainer->Add(drawGameOver());
@@ -617,6 +667,13 @@ namespace TUI {
                 }
             }
 
+            if (getReplayStatus().has_value()) {
+                displayWindow_ = ftxui::Container::Vertical({
+                    replayControls(),
+                    displayWindow_,
+                });
+            }
+
             handleKeys();
 
             gameContainer->Add(displayWindow_);
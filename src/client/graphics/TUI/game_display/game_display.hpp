@@ -76,6 +76,11 @@ namespace TUI {
 
         ftxui::Component rightPane();
 
+        /**
+         * @brief Returns the replay's progress bar and controls.
+         */
+        ftxui::Component replayControls();
+
         ftxui::Component &drawEndlessMode();
 
         ftxui::Component &drawMultiMode();
@@ -186,7 +186,13 @@ namespace TUI {
     }
 
     void MainMenu::displayRankingWindow() {
+        buttonMorePlayers_ =
+            ftxui::Button(std::string(STR_MORE_PLAYERS),
+                          [&] { controller_.requestRankingPage(); },
+                          GlobalButtonStyle());
+
         ftxui::Component container = ftxui::Container::Vertical({
+            buttonMorePlayers_,
             buttonBack_,
         });
 
@@ -216,13 +222,20 @@ namespace TUI {
             rows.push_back(ftxui::separator());
 
             // Ranking of the players
-            for (auto [rank, player] :
-                 std::views::enumerate(controller_.getRanking())) {
-                const auto &[user, score] = player;
+            const size_t ownRank = controller_.getOwnRank();
+            size_t previousRank = 0;
+            for (const auto &[rank, user, score, playerId] :
+                 controller_.getRanking()) {
+                // between the top and the player's neighbours
+                if (rank != previousRank + 1) {
+                    rows.push_back(ftxui::text(std::string(STR_RANKING_GAP))
+                                   | ftxui::center);
+                }
+                previousRank = rank;
 
                 rows.push_back(
                     ftxui::hbox({
-                        ftxui::text(std::to_string(rank + 1))
+                        ftxui::text(std::to_string(rank))
                             | size(ftxui::WIDTH, ftxui::EQUAL, widthRanking)
                             | ftxui::center,
                         ftxui::text("   "),
@@ -234,6 +247,7 @@ namespace TUI {
                             | size(ftxui::WIDTH, ftxui::EQUAL, widthScore)
                             | ftxui::center,
                     })
+                    | (rank == ownRank ? ftxui::bold : ftxui::nothing)
                     | ftxui::center);
             }
 
@@ -242,6 +256,7 @@ namespace TUI {
                            | ftxui::bold | ftxui::center,
                        ftxui::separator(),
                        ftxui::vbox(rows) | ftxui::borderHeavy,
+                       buttonMorePlayers_->Render(),
                        ftxui::separator(),
                        buttonBack_->Render(),
                    })
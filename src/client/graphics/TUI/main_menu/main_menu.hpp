@@ -80,6 +80,7 @@ namespace TUI {
 
         ftxui::Component buttonBack_;
         ftxui::Component buttonOK_;
+        ftxui::Component buttonMorePlayers_;
 
         ftxui::Elements rowsRanking_;
 
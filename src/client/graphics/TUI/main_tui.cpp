@@ -19,6 +19,7 @@
 
 #include "../../core/controller/controller.hpp"
 #include "ftxui_config/ftxui_config.hpp"
+#include "game_display/game_display.hpp"
 #include "graphics/TUI/login_menu/login_menu.hpp"
 #include "graphics/TUI/main_menu/main_menu.hpp"
 #include "graphics/common/abstract_display.hpp"
@@ -31,6 +32,12 @@ namespace TUI {
     }
 
     void MainTui::run() {
+        if (controller_.isReplaying()) {
+            GameDisplay replayDisplay(*this, controller_);
+            replayDisplay.render();
+            return;
+        }
+
         drawStartScreen();
 
         // Handle the login menu
@@ -78,6 +78,13 @@ namespace TUI {
                       }
                       return true;
                   }
+                  if (event == ftxui::Event::PageUp) {
+                      getSelectedFriendId().transform([&](UserID userID) {
+                          controller_.requestOlderMessages(userID);
+                          return 0;
+                      });
+                      return true;
+                  }
                   return false;
               });
         ;
@@ -116,6 +123,12 @@ namespace TUI {
                     auto [name, conversation] =
                         controller_.getConversationWith(id);
 
+                    if (conversation.firstIndex > 0) {
+                        chat_elements.push_back(
+                            ftxui::text(std::string(STR_OLDER_MESSAGES))
+                            | ftxui::dim | ftxui::center);
+                    }
+
                     if (conversation.senderMessages.empty()) {
                         chat_elements.push_back(
                             ftxui::text(std::string("No messages yet")));
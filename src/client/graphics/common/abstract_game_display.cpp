@@ -287,3 +287,7 @@ bool AbstractGameDisplay::gameIsFinished() const {
     return std::visit(
         [](const auto &gameState) { return gameState.isFinished; }, gameState_);
 }
+
+std::optional<ReplayStatus> AbstractGameDisplay::getReplayStatus() const {
+    return controller_.getReplayStatus();
+}
@@ -21,6 +21,7 @@
 #include "../../../common/types/types.hpp"
 #include "core/in_game/game_state/game_state.hpp"
 #include "core/in_game/game_state/game_state_viewer.hpp"
+#include "core/replay_player/replay_player.hpp"
 #include "effect/effect_type.hpp"
 #include "game_mode/game_mode.hpp"
 #include <optional>
@@ -255,6 +256,12 @@ class AbstractGameDisplay {
      * @brief Returns true if the gamestate indicates that the game is finished.
      */
     bool gameIsFinished() const;
+
+    /**
+     * @brief Returns the status of the replay being watched, nullopt when
+     * playing online.
+     */
+    std::optional<ReplayStatus> getReplayStatus() const;
 };
 
 #endif // ABSTRACT_GAME_DISPLAY_HPP
@@ -39,11 +39,29 @@ int main(int argc, char *argv[]) {
                 << "  " << argv[0] << "\n"
                 << "\n"
                 << "Options:\n"
-                << "  -v, --version   Show version\n"
-                << "  -h, --help      Show this help message\n";
+                << "  -v, --version          Show version\n"
+                << "  -h, --help             Show this help message\n"
+                << "  -r, --replay <file>    Watch a replay file offline\n";
         return 0;
     }
 
+    if (argc > 1 && (std::string(argv[1]) == "--replay" || std::string(argv[1]) == "-r")) {
+        if (argc < 3) {
+            std::cerr << "Missing replay file, see " << argv[0] << " --help" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        try {
+            Controller controller;
+            controller.runReplay(argv[2], std::make_unique<TUI::MainTui>(controller));
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
 
     try {
         Controller controller;
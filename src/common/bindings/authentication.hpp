@@ -19,6 +19,7 @@
 #define BINDINGS_AUTHENTICATION_HPP
 
 #include "binding_type.hpp"
+#include "client_features.hpp"
 #include "constants.hpp"
 
 #include <nlohmann/json.hpp>
@@ -37,6 +38,8 @@ namespace bindings {
     struct Authentication {
         std::string nickname;
         std::string password;
+        // optional protocol features supported by the client
+        ClientFeatures features = 0;
 
         nlohmann::json to_json() const {
             return nlohmann::json{
@@ -45,6 +48,7 @@ namespace bindings {
                  {
                      {"nickname", nickname},
                      {"password", password},
+                     {"features", features},
                  }}};
         }
 
@@ -55,7 +59,8 @@ namespace bindings {
 
             const auto &data = j.at("data");
             return Authentication{data.at("nickname").get<std::string>(),
-                                  data.at("password").get<std::string>()};
+                                  data.at("password").get<std::string>(),
+                                  data.value("features", ClientFeatures{0})};
         }
     };
 
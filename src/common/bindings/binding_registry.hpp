@@ -0,0 +1,172 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_BINDING_REGISTRY_HPP
+#define BINDINGS_BINDING_REGISTRY_HPP
+
+#include "binding_type.hpp"
+#include "constants.hpp"
+#include "flat_packet.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <variant>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Entry of a BindingRegistry: the binding struct of the given
+     * BindingType.
+     */
+    template <BindingType Type, typename Binding> struct BindingEntry {
+        static constexpr BindingType type = Type;
+        using BindingStruct = Binding;
+    };
+
+    /**
+     * @brief A binding that can also be read from a FlatPacket, without
+     * building a JSON DOM (the in-game inputs).
+     */
+    template <typename Binding>
+    concept FlatBinding = requires(const FlatPacket &packet) {
+        { Binding::from_flat(packet) } -> std::same_as<std::optional<Binding>>;
+    };
+
+    /**
+     * @brief Compile-time list of the bindings that can be received on one
+     * side of the connection.
+     *
+     * Gives the variant of those bindings and parses a packet into it through
+     * a table indexed by its BindingType, built at compile time. Adding a
+     * binding to the list is all it takes to receive it.
+     *
+     * The FlatBinding entries get a second table, to be read from a
+     * FlatPacket.
+     */
+    template <typename... Entries> class BindingRegistry {
+      public:
+        using Packet = std::variant<typename Entries::BindingStruct...>;
+
+      private:
+        using Parser = Packet (*)(const nlohmann::json &);
+        using FlatParser = std::optional<Packet> (*)(const FlatPacket &);
+
+        template <size_t Index>
+        using EntryAt = std::tuple_element_t<Index, std::tuple<Entries...>>;
+
+        static constexpr size_t numBindingTypes =
+            static_cast<size_t>(BindingType::NumBindingType);
+
+        /**
+         * @brief Returns a parser for the entry at the given index (several
+         * types may share a binding struct).
+         */
+        template <size_t Index> static constexpr Parser makeParser() {
+            return [](const nlohmann::json &j) -> Packet {
+                return Packet{std::in_place_index<Index>,
+                              EntryAt<Index>::BindingStruct::from_json(j)};
+            };
+        }
+
+        /**
+         * @brief Returns a FlatPacket parser for the entry at the given index,
+         * nullptr if it isn't a FlatBinding.
+         */
+        template <size_t Index> static constexpr FlatParser makeFlatParser() {
+            using Binding = typename EntryAt<Index>::BindingStruct;
+
+            if constexpr (FlatBinding<Binding>) {
+                return [](const FlatPacket &packet) -> std::optional<Packet> {
+                    std::optional<Binding> binding = Binding::from_flat(packet);
+                    if (!binding) {
+                        return std::nullopt;
+                    }
+
+                    return Packet{std::in_place_index<Index>,
+                                  std::move(*binding)};
+                };
+            } else {
+                return nullptr;
+            }
+        }
+
+        static constexpr std::array<Parser, numBindingTypes> parsers =
+            []<size_t... Indexes>(std::index_sequence<Indexes...>) {
+                std::array<Parser, numBindingTypes> table{};
+                ((table[static_cast<size_t>(Entries::type)] =
+                      makeParser<Indexes>()),
+                 ...);
+                return table;
+            }(std::index_sequence_for<Entries...>{});
+
+        static constexpr std::array<FlatParser, numBindingTypes> flatParsers =
+            []<size_t... Indexes>(std::index_sequence<Indexes...>) {
+                std::array<FlatParser, numBindingTypes> table{};
+                ((table[static_cast<size_t>(Entries::type)] =
+                      makeFlatParser<Indexes>()),
+                 ...);
+                return table;
+            }(std::index_sequence_for<Entries...>{});
+
+      public:
+        /**
+         * @brief Parses the given JSON packet into the binding of its type.
+         *
+         * @throws nlohmann::json::exception if it doesn't have the fields of
+         * its binding, std::runtime_error if its type isn't in the registry.
+         */
+        static Packet fromJson(const nlohmann::json &j) {
+            const auto index =
+                static_cast<size_t>(j.at(PACKET_TYPE_FIELD).get<int>());
+            if (index >= numBindingTypes || parsers[index] == nullptr) {
+                throw std::runtime_error("Unexpected binding type");
+            }
+
+            return parsers[index](j);
+        }
+
+        /**
+         * @brief Reads the given FlatPacket into the binding of its type.
+         *
+         * @return nullopt if its type isn't a FlatBinding of the registry or
+         * it doesn't have the fields of its binding (the packet must then be
+         * parsed with fromJson()).
+         */
+        static std::optional<Packet> fromFlat(const FlatPacket &packet) {
+            const FlatParser parser =
+                flatParsers[static_cast<size_t>(packet.getType())];
+            if (parser == nullptr) {
+                return std::nullopt;
+            }
+
+            return parser(packet);
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_BINDING_REGISTRY_HPP
@@ -65,10 +65,48 @@ namespace bindings {
         RotateActive,
         SelectTarget,
 
+        // lockstep (see client_features.hpp)
+        LockstepSync,
+        GameInput,
+        EngineTick,
+        StateHash,
+
+        // delta game states (see client_features.hpp)
+        GameStateDelta,
+        RequestGameStateSnapshot,
+
+        // conversations sync (see conversation.hpp)
+        NewMessage,
+        RequestConversationPage,
+        ConversationPage,
+
+        // ranking sync (see ranking.hpp)
+        RankingDelta,
+        RequestRankingPage,
+        RankingPage,
+
+        // heartbeats (see ping.hpp)
+        Ping,
+        Pong,
+
         // intern to server
         RemoveClient,
+
+        NumBindingType,
     };
 
+    /**
+     * @brief Returns true if the given in-game binding is a control one:
+     * leaving the game, asking for a snapshot or checking the state hash,
+     * which a client doesn't send again. They aren't dropped with the inputs
+     * but are rate limited on their own, as each may cost a full resync.
+     */
+    constexpr bool isGameControlBinding(BindingType type) {
+        return type == BindingType::QuitGame
+               || type == BindingType::RequestGameStateSnapshot
+               || type == BindingType::StateHash;
+    }
+
 } // namespace bindings
 
 #endif // BINDINGS_BINDING_TYPE_HPP
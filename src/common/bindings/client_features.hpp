@@ -0,0 +1,78 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_CLIENT_FEATURES_HPP
+#define BINDINGS_CLIENT_FEATURES_HPP
+
+#include <cstdint>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Bitmask of the optional protocol features a client supports,
+     * advertised in its Authentication binding. Clients that don't send it
+     * (older ones) support none of them.
+     */
+    using ClientFeatures = uint32_t;
+
+    enum class ClientFeature : ClientFeatures {
+        /**
+         * @brief The client simulates the game locally: instead of GameState
+         * bindings, it receives a LockstepSync binding (the game's seed, its
+         * last keyframe and the inputs since then) followed by the GameInput
+         * and EngineTick bindings, and sends StateHash bindings back.
+         */
+        Lockstep = 1 << 0,
+
+        /**
+         * @brief The client decodes the binary GameState encoding (see
+         * game_state_codec.hpp): the GameState bindings' "gameState" field is
+         * then the base64 of the encoded GameState instead of its JSON.
+         */
+        BinaryGameState = 1 << 1,
+
+        /**
+         * @brief The client applies GameStateDelta bindings (only along with
+         * BinaryGameState): the server numbers the GameStates it sends and
+         * then only sends the differences from the previous one, with a full
+         * GameState every now and then or on RequestGameStateSnapshot.
+         */
+        DeltaGameState = 1 << 2,
+    };
+
+    /**
+     * @brief Returns true if the given feature is part of the given features.
+     */
+    constexpr bool hasFeature(ClientFeatures features, ClientFeature feature) {
+        return (features & static_cast<ClientFeatures>(feature)) != 0;
+    }
+
+    /**
+     * @brief Returns the given features with the given feature added.
+     */
+    constexpr ClientFeatures withFeature(ClientFeatures features,
+                                         ClientFeature feature) {
+        return features | static_cast<ClientFeatures>(feature);
+    }
+
+} // namespace bindings
+
+#endif // BINDINGS_CLIENT_FEATURES_HPP
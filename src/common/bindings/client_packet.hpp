@@ -0,0 +1,135 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_CLIENT_PACKET_HPP
+#define BINDINGS_CLIENT_PACKET_HPP
+
+#include "abort_matchmaking.hpp"
+#include "authentication.hpp"
+#include "binding_registry.hpp"
+#include "binding_type.hpp"
+#include "change_password.hpp"
+#include "change_username.hpp"
+#include "create_game.hpp"
+#include "flat_packet.hpp"
+#include "friend_request.hpp"
+#include "handle_friend_request.hpp"
+#include "in_game/big_drop.hpp"
+#include "in_game/buy_bonus.hpp"
+#include "in_game/buy_penalty.hpp"
+#include "in_game/empty_penalty_stash.hpp"
+#include "in_game/hold_active_tetromino.hpp"
+#include "in_game/move_active.hpp"
+#include "in_game/quit_game.hpp"
+#include "in_game/request_game_state_snapshot.hpp"
+#include "in_game/rotate_active.hpp"
+#include "in_game/select_target.hpp"
+#include "in_game/state_hash.hpp"
+#include "join_game.hpp"
+#include "message.hpp"
+#include "pong.hpp"
+#include "registration.hpp"
+#include "remove_friend.hpp"
+#include "request_conversation_page.hpp"
+#include "request_ranking_page.hpp"
+#include "view_game.hpp"
+
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string_view>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief The bindings a client sends to the server.
+     */
+    using ClientBindings = BindingRegistry<
+        BindingEntry<BindingType::Authentication, Authentication>,
+        BindingEntry<BindingType::Registration, Registration>,
+        BindingEntry<BindingType::JoinGame, JoinGame>,
+        BindingEntry<BindingType::CreateGame, CreateGame>,
+        BindingEntry<BindingType::FriendRequest, FriendRequest>,
+        BindingEntry<BindingType::Message, Message>,
+        BindingEntry<BindingType::HandleFriendRequest, HandleFriendRequest>,
+        BindingEntry<BindingType::RemoveFriend, RemoveFriend>,
+        BindingEntry<BindingType::ChangePassword, ChangePassword>,
+        BindingEntry<BindingType::ChangeUsername, ChangeUsername>,
+        BindingEntry<BindingType::AbortMatchMaking, AbortMatchMaking>,
+        BindingEntry<BindingType::ViewGame, ViewGame>,
+        BindingEntry<BindingType::QuitGame, QuitGame>,
+        BindingEntry<BindingType::BigDrop, BigDrop>,
+        BindingEntry<BindingType::BuyBonus, BuyBonus>,
+        BindingEntry<BindingType::BuyPenalty, BuyPenalty>,
+        BindingEntry<BindingType::EmptyPenaltyStash, EmptyPenaltyStash>,
+        BindingEntry<BindingType::HoldActiveTetromino, HoldActiveTetromino>,
+        BindingEntry<BindingType::MoveActive, MoveActive>,
+        BindingEntry<BindingType::RotateActive, RotateActive>,
+        BindingEntry<BindingType::SelectTarget, SelectTarget>,
+        BindingEntry<BindingType::StateHash, StateHash>,
+        BindingEntry<BindingType::RequestGameStateSnapshot,
+                     RequestGameStateSnapshot>,
+        BindingEntry<BindingType::RequestConversationPage,
+                     RequestConversationPage>,
+        BindingEntry<BindingType::RequestRankingPage, RequestRankingPage>,
+        BindingEntry<BindingType::Pong, Pong>>;
+
+    /**
+     * @brief A packet sent by a client to the server, parsed into the binding
+     * of its type.
+     */
+    using ClientPacket = ClientBindings::Packet;
+
+    /**
+     * @brief Parses the given packet received from a client (without its
+     * delimiter), already read as a FlatPacket by the caller (nullopt if it
+     * isn't one).
+     *
+     * @throws nlohmann::json::exception if it isn't valid JSON or doesn't
+     * have the fields of its binding, std::runtime_error if its type isn't
+     * one a client sends.
+     */
+    inline ClientPacket
+    parseClientPacket(std::string_view packet,
+                      const std::optional<FlatPacket> &flatPacket) {
+        // the in-game inputs are read without building a JSON DOM
+        if (flatPacket.has_value()) {
+            if (std::optional<ClientPacket> clientPacket =
+                    ClientBindings::fromFlat(*flatPacket)) {
+                return std::move(*clientPacket);
+            }
+        }
+
+        return ClientBindings::fromJson(nlohmann::json::parse(packet));
+    }
+
+    /**
+     * @brief Parses the given packet received from a client (without its
+     * delimiter).
+     *
+     * @throws the same exceptions as the overload above.
+     */
+    inline ClientPacket parseClientPacket(std::string_view packet) {
+        return parseClientPacket(packet, FlatPacket::parse(packet));
+    }
+
+} // namespace bindings
+
+#endif // BINDINGS_CLIENT_PACKET_HPP
@@ -32,10 +32,18 @@ using SenderMessage = std::pair<UserID, std::string>;
 namespace bindings {
 
     /**
-     * @brief Binding representing a single conversation between two players.
+     * @brief Binding representing a single conversation between two players,
+     * or the part of it that starts at its message number firstIndex.
+     *
+     * The client receives the last page of each conversation at login, then
+     * a NewMessage binding for each new message. It asks for the older pages
+     * with RequestConversationPage.
      */
     struct Conversation {
+        static constexpr size_t PAGE_SIZE = 50;
+
         std::vector<SenderMessage> senderMessages;
+        size_t firstIndex = 0;
 
         nlohmann::json to_json() const {
             nlohmann::json j_senderMessages = nlohmann::json::array();
@@ -49,6 +57,7 @@ namespace bindings {
                 {"data",
                  {
                      {"senderMessages", j_senderMessages},
+                     {"firstIndex", firstIndex},
                  }}};
         }
 
@@ -65,6 +74,7 @@ namespace bindings {
                 conversation.senderMessages.push_back(
                     j_senderMsg.get<SenderMessage>());
             }
+            conversation.firstIndex = data.value("firstIndex", size_t{0});
 
             return conversation;
         }
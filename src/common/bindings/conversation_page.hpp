@@ -0,0 +1,69 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_CONVERSATION_PAGE_HPP
+#define BINDINGS_CONVERSATION_PAGE_HPP
+
+#include "binding_type.hpp"
+#include "constants.hpp"
+#include "conversation.hpp"
+
+#include "../../common/types/types.hpp"
+
+#include <nlohmann/json.hpp>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding sent by the server in answer to a
+     * RequestConversationPage: older messages of the conversation with the
+     * user userID, to prepend to the ones the client already has.
+     */
+    struct ConversationPage {
+        UserID userID;
+        Conversation conversation;
+
+        nlohmann::json to_json() const {
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::ConversationPage},
+                {"data",
+                 {
+                     {"userID", userID},
+                     {"conversation", conversation.to_json()},
+                 }}};
+        }
+
+        static ConversationPage from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::ConversationPage) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            const auto &data = j.at("data");
+            return ConversationPage{
+                data.at("userID").get<UserID>(),
+                Conversation::from_json(data.at("conversation")),
+            };
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_CONVERSATION_PAGE_HPP
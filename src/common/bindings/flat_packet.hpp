@@ -0,0 +1,287 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_FLAT_PACKET_HPP
+#define BINDINGS_FLAT_PACKET_HPP
+
+#include "binding_type.hpp"
+#include "constants.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief A packet whose data only holds a few unsigned integers and
+     * booleans (the in-game inputs), read straight from its text without
+     * building a JSON DOM nor allocating.
+     *
+     * Anything else (strings, nested objects, negative or floating-point
+     * numbers, escaped keys, ...) isn't a FlatPacket: such packets are parsed
+     * into a JSON DOM instead, which also reports their errors.
+     */
+    class FlatPacket {
+      public:
+        static constexpr size_t MAX_FIELDS = 4;
+
+      private:
+        enum class ValueKind { Unsigned, Boolean };
+
+        struct Value {
+            ValueKind kind;
+            uint64_t number;
+        };
+
+        struct Field {
+            std::string_view key;
+            Value value;
+        };
+
+        BindingType type_ = BindingType::NumBindingType;
+        std::array<Field, MAX_FIELDS> fields_{};
+        size_t numFields_ = 0;
+
+        /**
+         * @brief Skips the JSON whitespace at the front of the given text.
+         */
+        static void skipWhitespace(std::string_view &text) {
+            while (!text.empty()
+                   && (text.front() == ' ' || text.front() == '\t'
+                       || text.front() == '\n' || text.front() == '\r')) {
+                text.remove_prefix(1);
+            }
+        }
+
+        /**
+         * @brief Consumes the given character (after whitespace) if it is at
+         * the front of the given text.
+         */
+        static bool consume(std::string_view &text, char character) {
+            skipWhitespace(text);
+            if (text.empty() || text.front() != character) {
+                return false;
+            }
+
+            text.remove_prefix(1);
+            return true;
+        }
+
+        /**
+         * @brief Reads a key without escape sequences.
+         */
+        static std::optional<std::string_view> readKey(std::string_view &text) {
+            if (!consume(text, '"')) {
+                return std::nullopt;
+            }
+
+            for (size_t i = 0; i < text.size(); ++i) {
+                if (text[i] == '"') {
+                    const std::string_view key = text.substr(0, i);
+                    text.remove_prefix(i + 1);
+                    return key;
+                }
+                if (text[i] == '\\'
+                    || static_cast<unsigned char>(text[i]) < 0x20) {
+                    return std::nullopt;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Reads an unsigned integer or a boolean.
+         */
+        static std::optional<Value> readValue(std::string_view &text) {
+            skipWhitespace(text);
+
+            if (text.starts_with("true")) {
+                text.remove_prefix(4);
+                return Value{ValueKind::Boolean, 1};
+            }
+            if (text.starts_with("false")) {
+                text.remove_prefix(5);
+                return Value{ValueKind::Boolean, 0};
+            }
+
+            size_t numDigits = 0;
+            uint64_t number = 0;
+            while (numDigits < text.size() && text[numDigits] >= '0'
+                   && text[numDigits] <= '9') {
+                const uint64_t digit = text[numDigits] - '0';
+                if (number > (UINT64_MAX - digit) / 10) {
+                    return std::nullopt;
+                }
+                number = number * 10 + digit;
+                ++numDigits;
+            }
+
+            // no leading zeros, fractions nor exponents
+            if (numDigits == 0 || (text[0] == '0' && numDigits > 1)
+                || (numDigits < text.size()
+                    && (text[numDigits] == '.' || text[numDigits] == 'e'
+                        || text[numDigits] == 'E'))) {
+                return std::nullopt;
+            }
+
+            text.remove_prefix(numDigits);
+            return Value{ValueKind::Unsigned, number};
+        }
+
+        /**
+         * @brief Reads an object, calling readMember(key, text) to read the
+         * value of each of its members.
+         */
+        template <typename ReadMember>
+        static bool readObject(std::string_view &text,
+                               ReadMember &&readMember) {
+            if (!consume(text, '{')) {
+                return false;
+            }
+            if (consume(text, '}')) {
+                return true;
+            }
+
+            do {
+                const std::optional<std::string_view> key = readKey(text);
+                if (!key || !consume(text, ':') || !readMember(*key, text)) {
+                    return false;
+                }
+            } while (consume(text, ','));
+
+            return consume(text, '}');
+        }
+
+        /**
+         * @brief Adds the given data field, a duplicate key replaces the
+         * previous value (as in a JSON DOM).
+         */
+        bool addField(std::string_view key, Value value) {
+            for (size_t i = 0; i < numFields_; ++i) {
+                if (fields_[i].key == key) {
+                    fields_[i].value = value;
+                    return true;
+                }
+            }
+
+            if (numFields_ == MAX_FIELDS) {
+                return false;
+            }
+
+            fields_[numFields_++] = Field{key, value};
+            return true;
+        }
+
+        const Value *find(std::string_view key) const {
+            for (size_t i = 0; i < numFields_; ++i) {
+                if (fields_[i].key == key) {
+                    return &fields_[i].value;
+                }
+            }
+
+            return nullptr;
+        }
+
+      public:
+        /**
+         * @brief Reads the given packet, nullopt if it isn't a FlatPacket.
+         *
+         * The FlatPacket refers to the given text, which must outlive it.
+         */
+        static std::optional<FlatPacket> parse(std::string_view packet) {
+            FlatPacket flatPacket;
+            bool hasType = false;
+
+            auto readData = [&flatPacket](std::string_view key,
+                                          std::string_view &text) {
+                const std::optional<Value> value = readValue(text);
+                return value.has_value() && flatPacket.addField(key, *value);
+            };
+
+            auto readMember = [&](std::string_view key,
+                                  std::string_view &text) {
+                if (key == PACKET_TYPE_FIELD) {
+                    const std::optional<Value> value = readValue(text);
+                    if (!value || value->kind != ValueKind::Unsigned
+                        || value->number >= static_cast<uint64_t>(
+                               BindingType::NumBindingType)) {
+                        return false;
+                    }
+
+                    flatPacket.type_ = static_cast<BindingType>(value->number);
+                    hasType = true;
+                    return true;
+                }
+
+                return key == "data" && readObject(text, readData);
+            };
+
+            if (!readObject(packet, readMember) || !hasType) {
+                return std::nullopt;
+            }
+
+            skipWhitespace(packet);
+            if (!packet.empty()) {
+                return std::nullopt;
+            }
+
+            return flatPacket;
+        }
+
+        BindingType getType() const { return type_; }
+
+        /**
+         * @brief Returns true if the data has the given field.
+         */
+        bool contains(std::string_view key) const {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * @brief Returns the given data field as a T (a boolean, an unsigned
+         * integer or an enum), nullopt if it is missing or of another kind.
+         */
+        template <typename T> std::optional<T> get(std::string_view key) const {
+            const Value *value = find(key);
+            if (value == nullptr) {
+                return std::nullopt;
+            }
+
+            if constexpr (std::is_same_v<T, bool>) {
+                if (value->kind != ValueKind::Boolean) {
+                    return std::nullopt;
+                }
+            } else if (value->kind != ValueKind::Unsigned) {
+                return std::nullopt;
+            }
+
+            return static_cast<T>(value->number);
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_FLAT_PACKET_HPP
@@ -0,0 +1,80 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_FRAMING_HPP
+#define BINDINGS_FRAMING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * The packets are framed in one of two ways, chosen by the client when it
+ * connects:
+ * - newline framing (the default): each packet is followed by
+ *   PACKET_DELIMITER;
+ * - length-prefixed framing: the client first sends FRAMING_MAGIC, then each
+ *   packet (both ways) is preceded by its length, on FRAME_HEADER_SIZE bytes
+ *   in big endian.
+ *
+ * A newline client always starts with a JSON object, so the server tells them
+ * apart from the first bytes it receives.
+ */
+namespace bindings {
+
+    inline constexpr std::string_view FRAMING_MAGIC = "RBF1";
+
+    inline constexpr size_t FRAME_HEADER_SIZE = 4;
+
+    /**
+     * @brief Maximum size of a packet sent by a client (in both framings):
+     * the server drops the clients that send bigger ones.
+     */
+    inline constexpr size_t MAX_CLIENT_PACKET_SIZE = 64 * 1024;
+
+    using FrameHeader = std::array<char, FRAME_HEADER_SIZE>;
+
+    /**
+     * @brief Returns the header of a frame of the given length.
+     */
+    constexpr FrameHeader encodeFrameHeader(uint32_t length) {
+        return FrameHeader{
+            static_cast<char>(length >> 24),
+            static_cast<char>(length >> 16),
+            static_cast<char>(length >> 8),
+            static_cast<char>(length),
+        };
+    }
+
+    /**
+     * @brief Returns the length of the frame of the given header.
+     */
+    constexpr uint32_t
+    decodeFrameHeader(std::span<const char, FRAME_HEADER_SIZE> header) {
+        uint32_t length = 0;
+        for (char byte : header) {
+            length = (length << 8) | static_cast<uint8_t>(byte);
+        }
+
+        return length;
+    }
+
+} // namespace bindings
+
+#endif // BINDINGS_FRAMING_HPP
@@ -20,8 +20,11 @@
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
+#include "input_seq.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 /**
  * For an overview of the bindings system and the list of available binding, see
@@ -33,9 +36,12 @@ namespace bindings {
      * @brief Binding sent by the client to make a bigDrop action.
      */
     struct BigDrop {
+        InputSeq seq = 0;
+
         nlohmann::json to_json() const {
             return nlohmann::json{
                 {PACKET_TYPE_FIELD, BindingType::BigDrop},
+                {"data", {{"seq", seq}}},
             };
         }
 
@@ -44,7 +50,16 @@ namespace bindings {
                 throw std::runtime_error("Invalid type field in JSON");
             }
 
-            return BigDrop{};
+            return BigDrop{readInputSeq(j)};
+        }
+
+        static std::optional<BigDrop> from_flat(const FlatPacket &packet) {
+            const std::optional<InputSeq> seq = readInputSeq(packet);
+            if (!seq) {
+                return std::nullopt;
+            }
+
+            return BigDrop{*seq};
         }
     };
 
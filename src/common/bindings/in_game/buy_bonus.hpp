@@ -22,8 +22,10 @@
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 /**
  * For an overview of the bindings system and the list of available binding, see
@@ -53,6 +55,16 @@ namespace bindings {
             const auto &data = j.at("data");
             return BuyBonus{data.at("bonusType").get<BonusType>()};
         }
+
+        static std::optional<BuyBonus> from_flat(const FlatPacket &packet) {
+            const std::optional<BonusType> bonusType =
+                packet.get<BonusType>("bonusType");
+            if (!bonusType) {
+                return std::nullopt;
+            }
+
+            return BuyBonus{*bonusType};
+        }
     };
 
 } // namespace bindings
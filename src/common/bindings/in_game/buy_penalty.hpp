@@ -23,8 +23,10 @@
 #include "../binding_type.hpp"
 
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 /**
  * For an overview of the bindings system and the list of available binding, see
@@ -57,6 +59,18 @@ namespace bindings {
             return BuyPenalty{data.at("penaltyType").get<PenaltyType>(),
                               data.at("stashForLater").get<bool>()};
         }
+
+        static std::optional<BuyPenalty> from_flat(const FlatPacket &packet) {
+            const std::optional<PenaltyType> penaltyType =
+                packet.get<PenaltyType>("penaltyType");
+            const std::optional<bool> stashForLater =
+                packet.get<bool>("stashForLater");
+            if (!penaltyType || !stashForLater) {
+                return std::nullopt;
+            }
+
+            return BuyPenalty{*penaltyType, *stashForLater};
+        }
     };
 
 } // namespace bindings
@@ -20,8 +20,10 @@
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 /**
  * For an overview of the bindings system and the list of available binding, see
@@ -46,6 +48,11 @@ namespace bindings {
 
             return EmptyPenaltyStash{};
         }
+
+        static std::optional<EmptyPenaltyStash>
+        from_flat(const FlatPacket & /*packet*/) {
+            return EmptyPenaltyStash{};
+        }
     };
 
 } // namespace bindings
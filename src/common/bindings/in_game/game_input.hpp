@@ -0,0 +1,71 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_GAME_INPUT_HPP
+#define BINDINGS_GAME_INPUT_HPP
+
+#include "../../tetris_royal_lib/game_log/game_action.hpp"
+
+#include "../binding_type.hpp"
+#include "../constants.hpp"
+
+#include "../../types/types.hpp"
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding broadcast by the server to lockstep clients for every
+     * input it accepted, in the order it applied them.
+     */
+    struct GameInput {
+        // number of engine ticks elapsed before the input was applied
+        size_t tick;
+        UserID userID;
+        GameAction action;
+
+        nlohmann::json to_json() const {
+            return nlohmann::json{{PACKET_TYPE_FIELD, BindingType::GameInput},
+                                  {"data",
+                                   {
+                                       {"tick", tick},
+                                       {"userID", userID},
+                                       {"action", serializeGameAction(action)},
+                                   }}};
+        }
+
+        static GameInput from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::GameInput) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            const auto &data = j.at("data");
+            return GameInput{data.at("tick").get<size_t>(),
+                             data.at("userID").get<UserID>(),
+                             deserializeGameAction(data.at("action"))};
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_GAME_INPUT_HPP
@@ -21,11 +21,16 @@
 #include "../../../client/core/in_game/game_state/game_state.hpp"
 
 #include "../../../client/core/in_game/game_state/game_state_viewer.hpp"
+#include "../../tetris_lib/byte_stream/base64.hpp"
+#include "../../tetris_royal_lib/game_state/game_state_codec.hpp"
 
 #include "../binding_type.hpp"
 #include "../bindings/constants.hpp"
+#include "game_state_delta.hpp"
+#include "input_seq.hpp"
 
 #include <nlohmann/json.hpp>
+#include <stdexcept>
 
 /**
  * This file contains everything related to deserialization of GameState (used
@@ -44,39 +49,91 @@ namespace bindings {
      */
     namespace GameStateMessage {
 
+        /**
+         * @brief Returns the serialized GameState of the given GameState or
+         * GameStateViewer binding, decoding it if it was sent in binary.
+         */
+        inline nlohmann::json getSerializedGameState(const nlohmann::json &j) {
+            const auto &j_gameState = j.at("data").at("gameState");
+            if (!j_gameState.is_string()) {
+                return j_gameState;
+            }
+
+            return game_state_codec::decode(base64::decode(
+                j_gameState.get_ref<const std::string &>()));
+        };
+
         /**
          * @brief Deserializes the given GameState binding into a
          * client::GameState.
          */
-        client::GameState deserializeForPlayer(const nlohmann::json &j) {
+        inline client::GameState deserializeForPlayer(const nlohmann::json &j) {
             if (j.at(PACKET_TYPE_FIELD) != BindingType::GameState) {
                 throw std::runtime_error("Invalid type field in JSON");
             }
 
-            const auto &data = j.at("data");
             client::GameState gameStateBinding;
-            gameStateBinding.deserialize(data.at("gameState"));
+            gameStateBinding.deserialize(getSerializedGameState(j));
             return gameStateBinding;
         };
 
+        /**
+         * @brief Returns the sequence number of the last input of the player
+         * applied to the given GameState binding.
+         */
+        inline InputSeq getLastInputSeq(const nlohmann::json &j) {
+            return j.at("data").value("lastInputSeq", InputSeq{0});
+        };
+
+        /**
+         * @brief Returns the number of the given GameState or GameStateViewer
+         * binding, 0 if it isn't numbered (see GameStateDelta).
+         */
+        inline GameStateID getGameStateID(const nlohmann::json &j) {
+            return j.at("data").value("id", GameStateID{0});
+        };
+
         /**
          * @brief Deserializes the given GameState binding into a
          * client::GameStateViewer.
          */
-        client::GameStateViewer deserializeForViewer(const nlohmann::json &j) {
+        inline client::GameStateViewer
+        deserializeForViewer(const nlohmann::json &j) {
             if (j.at(PACKET_TYPE_FIELD) != BindingType::GameStateViewer) {
                 throw std::runtime_error("Invalid type field in JSON");
             }
 
-            const auto &data = j.at("data");
             client::GameStateViewer gameStateViewerBinding;
-            gameStateViewerBinding.deserialize(data.at("gameState"));
+            gameStateViewerBinding.deserialize(getSerializedGameState(j));
 
             return gameStateViewerBinding;
         };
 
     } // namespace GameStateMessage
 
+    /**
+     * @brief A GameState or GameStateViewer binding received by the client,
+     * with its GameState still serialized.
+     */
+    struct ReceivedGameState {
+        nlohmann::json gameState;
+        InputSeq lastInputSeq;
+        GameStateID id;
+
+        static ReceivedGameState from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::GameState
+                && j.at(PACKET_TYPE_FIELD) != BindingType::GameStateViewer) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            return ReceivedGameState{
+                GameStateMessage::getSerializedGameState(j),
+                GameStateMessage::getLastInputSeq(j),
+                GameStateMessage::getGameStateID(j),
+            };
+        }
+    };
+
 } // namespace bindings
 
 #endif // BINDING_GAME_STATE_CLIENT_HPP
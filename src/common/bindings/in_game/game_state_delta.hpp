@@ -0,0 +1,88 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_GAME_STATE_DELTA_HPP
+#define BINDINGS_GAME_STATE_DELTA_HPP
+
+#include "../../tetris_lib/byte_stream/base64.hpp"
+
+#include "../binding_type.hpp"
+#include "../constants.hpp"
+#include "input_seq.hpp"
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Number of a GameState sent to a client with the DeltaGameState
+     * feature, for the client to tell which one a GameStateDelta applies to.
+     *
+     * 0 means that the GameState isn't numbered.
+     */
+    using GameStateID = uint32_t;
+
+    /**
+     * @brief Binding sent by the server to the clients with the DeltaGameState
+     * feature instead of a GameState (or GameStateViewer) binding: the
+     * differences (see game_state_codec::encodeDelta()) between the GameState
+     * numbered id and the previous one sent to the client, numbered baseId.
+     *
+     * A client that doesn't have that base answers with a
+     * RequestGameStateSnapshot.
+     */
+    struct GameStateDelta {
+        GameStateID id;
+        GameStateID baseId;
+        std::vector<uint8_t> delta;
+        InputSeq lastInputSeq;
+
+        nlohmann::json to_json() const {
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::GameStateDelta},
+                {"data",
+                 {
+                     {"id", id},
+                     {"baseId", baseId},
+                     {"delta", base64::encode(delta)},
+                     {"lastInputSeq", lastInputSeq},
+                 }}};
+        }
+
+        static GameStateDelta from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::GameStateDelta) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            const auto &data = j.at("data");
+            return GameStateDelta{
+                data.at("id").get<GameStateID>(),
+                data.at("baseId").get<GameStateID>(),
+                base64::decode(data.at("delta").get_ref<const std::string &>()),
+                data.at("lastInputSeq").get<InputSeq>()};
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_GAME_STATE_DELTA_HPP
@@ -18,13 +18,21 @@
 #ifndef BINDINGS_GAME_STATE_SERVER_HPP
 #define BINDINGS_GAME_STATE_SERVER_HPP
 
+#include "../../tetris_lib/byte_stream/base64.hpp"
 #include "../../tetris_royal_lib/game_state/game_state.hpp"
+#include "../../tetris_royal_lib/game_state/game_state_codec.hpp"
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "game_state_delta.hpp"
+#include "input_seq.hpp"
 #include "player_state/player_state.hpp"
 
+#include <cstdint>
 #include <nlohmann/json.hpp>
+#include <span>
+#include <string>
+#include <string_view>
 
 /**
  * This file contains everything related to serialization of GameState (used by
@@ -45,23 +53,26 @@ namespace bindings {
 
         /**
          * @brief Serializes the given gamestate for a player in the JSON
-         * format.
+         * format, along with the sequence number of the last input of that
+         * player applied to it.
          */
-        nlohmann::json serializeForPlayer(const GameState &gameState,
-                                          UserID userID) {
+        inline nlohmann::json serializeForPlayer(const GameState &gameState,
+                                                 UserID userID,
+                                                 InputSeq lastInputSeq = 0) {
             return nlohmann::json{{PACKET_TYPE_FIELD, BindingType::GameState},
                                   {"data",
-                                   {{
-                                       "gameState",
-                                       gameState.serializeForPlayer(userID),
-                                   }}}};
+                                   {
+                                       {"gameState",
+                                        gameState.serializeForPlayer(userID)},
+                                       {"lastInputSeq", lastInputSeq},
+                                   }}};
         };
 
         /**
          * @brief Serializes the given gamestate for a viewer in the JSON
          * format.
          */
-        nlohmann::json serializeForViewer(const GameState &gameState) {
+        inline nlohmann::json serializeForViewer(const GameState &gameState) {
             return nlohmann::json{
                 {PACKET_TYPE_FIELD, BindingType::GameStateViewer},
                 {"data",
@@ -71,6 +82,124 @@ namespace bindings {
                  }}}};
         };
 
+        /**
+         * @brief Same as serializeForPlayer(), with the GameState in the
+         * binary encoding (for the clients with the BinaryGameState feature).
+         */
+        inline nlohmann::json encodeForPlayer(const GameState &gameState,
+                                              UserID userID,
+                                              InputSeq lastInputSeq = 0) {
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::GameState},
+                {"data",
+                 {
+                     {"gameState",
+                      base64::encode(game_state_codec::encode(
+                          gameState.serializeForPlayer(userID)))},
+                     {"lastInputSeq", lastInputSeq},
+                 }}};
+        };
+
+        /**
+         * @brief Same as serializeForViewer(), with the GameState in the
+         * binary encoding (for the clients with the BinaryGameState feature).
+         */
+        inline nlohmann::json encodeForViewer(const GameState &gameState) {
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::GameStateViewer},
+                {"data",
+                 {{
+                     "gameState",
+                     base64::encode(game_state_codec::encode(
+                         gameState.serializeForViewer())),
+                 }}}};
+        };
+
+        /**
+         * @brief Wraps the given GameState, already in the binary encoding,
+         * in a GameState (or GameStateViewer) binding.
+         *
+         * @param hasSelf If the GameState was encoded for a player.
+         * @param lastInputSeq See serializeForPlayer(), only for a player.
+         * @param id The number of the GameState for the clients with the
+         * DeltaGameState feature to apply the next GameStateDelta bindings
+         * to, 0 for the other clients.
+         */
+        inline nlohmann::json fromEncoded(std::span<const uint8_t> encoded,
+                                          bool hasSelf,
+                                          InputSeq lastInputSeq = 0,
+                                          GameStateID id = 0) {
+            nlohmann::json j{
+                {PACKET_TYPE_FIELD, hasSelf ? BindingType::GameState
+                                            : BindingType::GameStateViewer},
+                {"data", {{"gameState", base64::encode(encoded)}}}};
+
+            if (hasSelf) {
+                j["data"]["lastInputSeq"] = lastInputSeq;
+            }
+            if (id != 0) {
+                j["data"]["id"] = id;
+            }
+
+            return j;
+        };
+
+        /**
+         * @brief Wraps the given GameState, serialized for a player or a
+         * viewer, in a binary GameState (or GameStateViewer) binding, see
+         * fromEncoded().
+         */
+        inline nlohmann::json
+        encodeSerialized(const nlohmann::json &j_gameState,
+                         InputSeq lastInputSeq = 0, GameStateID id = 0) {
+            return fromEncoded(game_state_codec::encode(j_gameState),
+                               j_gameState.contains("self"), lastInputSeq,
+                               id);
+        };
+
+        /**
+         * @brief Same as serializeForPlayer().dump(), from the GameState
+         * already dumped: the text of the packet is spliced around it
+         * instead of dumping it again.
+         */
+        inline std::string dumpForPlayer(std::string_view gameStateText,
+                                  InputSeq lastInputSeq = 0) {
+            // same layout as nlohmann::json::dump(), which sorts the keys
+            std::string packet;
+            packet.reserve(gameStateText.size() + 64);
+            packet.append(R"({"data":{"gameState":)")
+                .append(gameStateText)
+                .append(R"(,"lastInputSeq":)")
+                .append(std::to_string(lastInputSeq))
+                .append(R"(},")")
+                .append(PACKET_TYPE_FIELD)
+                .append(R"(":)")
+                .append(std::to_string(
+                    static_cast<int>(BindingType::GameState)))
+                .append("}");
+
+            return packet;
+        };
+
+        /**
+         * @brief Same as serializeForViewer().dump(), from the GameState
+         * already dumped.
+         */
+        inline std::string dumpForViewer(std::string_view gameStateText) {
+            std::string packet;
+            packet.reserve(gameStateText.size() + 64);
+            packet.append(R"({"data":{"gameState":)")
+                .append(gameStateText)
+                .append(R"(},")")
+                .append(PACKET_TYPE_FIELD)
+                .append(R"(":)")
+                .append(std::to_string(
+                    static_cast<int>(BindingType::GameStateViewer)))
+                .append("}");
+
+            return packet;
+        };
+
     } // namespace GameStateMessage
 
 } // namespace bindings
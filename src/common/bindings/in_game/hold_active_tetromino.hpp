@@ -20,15 +20,21 @@
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
+#include "input_seq.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 namespace bindings {
 
     struct HoldActiveTetromino {
+        InputSeq seq = 0;
+
         nlohmann::json to_json() const {
             return nlohmann::json{
                 {PACKET_TYPE_FIELD, BindingType::HoldActiveTetromino},
+                {"data", {{"seq", seq}}},
             };
         }
 
@@ -37,7 +43,17 @@ namespace bindings {
                 throw std::runtime_error("Invalid type field in JSON");
             }
 
-            return HoldActiveTetromino{};
+            return HoldActiveTetromino{readInputSeq(j)};
+        }
+
+        static std::optional<HoldActiveTetromino>
+        from_flat(const FlatPacket &packet) {
+            const std::optional<InputSeq> seq = readInputSeq(packet);
+            if (!seq) {
+                return std::nullopt;
+            }
+
+            return HoldActiveTetromino{*seq};
         }
     };
 
@@ -0,0 +1,69 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_INPUT_SEQ_HPP
+#define BINDINGS_INPUT_SEQ_HPP
+
+#include "../flat_packet.hpp"
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <optional>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Sequence number of a Tetris input (MoveActive, RotateActive,
+     * BigDrop and HoldActiveTetromino) sent by the client. The server echoes
+     * the last one it applied in the player's GameState, so that the client can
+     * tell which of its predicted inputs are not part of that state yet.
+     *
+     * 0 means that the input isn't numbered (the client doesn't predict).
+     */
+    using InputSeq = uint32_t;
+
+    /**
+     * @brief Reads the sequence number of the given input binding, 0 if it
+     * has none.
+     */
+    inline InputSeq readInputSeq(const nlohmann::json &j) {
+        if (!j.contains("data")) {
+            return 0;
+        }
+
+        return j.at("data").value("seq", InputSeq{0});
+    }
+
+    /**
+     * @brief Reads the sequence number of the given input FlatPacket, 0 if it
+     * has none, nullopt if it isn't a number.
+     */
+    inline std::optional<InputSeq> readInputSeq(const FlatPacket &packet) {
+        if (!packet.contains("seq")) {
+            return InputSeq{0};
+        }
+
+        return packet.get<InputSeq>("seq");
+    }
+
+} // namespace bindings
+
+#endif // BINDINGS_INPUT_SEQ_HPP
@@ -0,0 +1,198 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_LOCKSTEP_SYNC_HPP
+#define BINDINGS_LOCKSTEP_SYNC_HPP
+
+#include "../../tetris_lib/byte_stream/base64.hpp"
+#include "../../tetris_lib/byte_stream/byte_reader.hpp"
+#include "../../tetris_lib/byte_stream/byte_writer.hpp"
+#include "../../tetris_royal_lib/game_log/game_action.hpp"
+#include "../../tetris_royal_lib/game_log/game_log.hpp"
+#include "../../tetris_royal_lib/game_mode/game_mode.hpp"
+
+#include "../binding_type.hpp"
+#include "../constants.hpp"
+
+#include "../../types/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding sent by the server to a lockstep client when it joins a
+     * game, and again whenever its simulation diverged: what the client needs
+     * to rebuild the current GameState without re-simulating the whole game.
+     *
+     * That is the game's parameters (mode, seed, players), the last keyframe
+     * of its log (see GameLogKeyframe) and the inputs accepted since then, so
+     * its size doesn't grow with the length of the game.
+     */
+    struct LockstepSync {
+        /**
+         * @brief An input accepted by the server, stamped with the number of
+         * engine ticks elapsed before it was applied.
+         */
+        struct Input {
+            size_t tick;
+            UserID userID;
+            GameAction action;
+        };
+
+        // nullopt for viewers
+        std::optional<UserID> selfID;
+        GameMode gameMode;
+        Seed seed;
+        std::vector<GameLogPlayer> players;
+        // the tick the simulation resumes from, 0 for the start of the game
+        size_t keyframeTick;
+        // the GameState at keyframeTick (see GameState::writeSnapshot()),
+        // empty at the start of the game
+        std::vector<uint8_t> snapshot;
+        // in order, from keyframeTick on
+        std::vector<Input> inputs;
+        // the number of times the server's engine ticked
+        size_t numTicks;
+
+        /**
+         * @brief Builds the binding from the game's log.
+         */
+        static LockstepSync fromGameLog(const GameLog &gameLog,
+                                        std::optional<UserID> selfID) {
+            const std::vector<GameLogKeyframe> &keyframes =
+                gameLog.getKeyframes();
+            const std::vector<GameLogEntry> &entries = gameLog.getEntries();
+
+            LockstepSync sync{selfID,
+                              gameLog.getGameMode(),
+                              gameLog.getSeed(),
+                              gameLog.getPlayers(),
+                              0,
+                              {},
+                              {},
+                              gameLog.getNumTicks()};
+
+            size_t entryIdx = 0;
+            if (!keyframes.empty()) {
+                sync.keyframeTick = keyframes.back().tick;
+                sync.snapshot = keyframes.back().snapshot;
+                entryIdx = keyframes.back().entryIdx;
+            }
+
+            sync.inputs.reserve(entries.size() - entryIdx);
+            for (; entryIdx < entries.size(); entryIdx++) {
+                const GameLogEntry &entry = entries.at(entryIdx);
+                sync.inputs.push_back(
+                    Input{entry.tick, entry.userID, entry.action});
+            }
+
+            return sync;
+        }
+
+        nlohmann::json to_json() const {
+            nlohmann::json j_data;
+
+            if (selfID) {
+                j_data["selfID"] = selfID.value();
+            } else {
+                j_data["selfID"] = nullptr;
+            }
+
+            nlohmann::json j_players = nlohmann::json::array();
+            for (const GameLogPlayer &player : players) {
+                j_players.push_back({{"userID", player.userID},
+                                     {"username", player.username}});
+            }
+
+            // each input's tick is written relative to the previous one
+            ByteWriter writer;
+            size_t prevTick = keyframeTick;
+            for (const Input &input : inputs) {
+                writer.writeVarint(input.tick - prevTick);
+                writer.writeVarint(input.userID);
+                writeGameAction(writer, input.action);
+                prevTick = input.tick;
+            }
+
+            j_data["gameMode"] = gameMode;
+            j_data["seed"] = seed;
+            j_data["players"] = j_players;
+            j_data["keyframeTick"] = keyframeTick;
+            j_data["snapshot"] = base64::encode(snapshot);
+            j_data["inputs"] = base64::encode(writer.release());
+            j_data["numTicks"] = numTicks;
+
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::LockstepSync},
+                {"data", j_data}};
+        }
+
+        static LockstepSync from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::LockstepSync) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            const auto &data = j.at("data");
+
+            std::vector<GameLogPlayer> players;
+            for (const nlohmann::json &j_player : data.at("players")) {
+                players.push_back(
+                    GameLogPlayer{j_player.at("userID").get<UserID>(),
+                                  j_player.at("username").get<std::string>()});
+            }
+
+            const size_t keyframeTick = data.at("keyframeTick").get<size_t>();
+
+            const std::vector<uint8_t> packedInputs = base64::decode(
+                data.at("inputs").get_ref<const std::string &>());
+            ByteReader reader{packedInputs};
+            std::vector<Input> inputs;
+            size_t tick = keyframeTick;
+            while (!reader.atEnd()) {
+                tick += reader.readVarint();
+                const auto userID = static_cast<UserID>(reader.readVarint());
+                inputs.push_back(Input{tick, userID, readGameAction(reader)});
+            }
+
+            return LockstepSync{
+                data.at("selfID").is_null()
+                    ? std::nullopt
+                    : std::make_optional(data.at("selfID").get<UserID>()),
+                data.at("gameMode").get<GameMode>(),
+                data.at("seed").get<Seed>(),
+                std::move(players),
+                keyframeTick,
+                base64::decode(
+                    data.at("snapshot").get_ref<const std::string &>()),
+                std::move(inputs),
+                data.at("numTicks").get<size_t>()};
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_LOCKSTEP_SYNC_HPP
@@ -22,8 +22,11 @@
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
+#include "input_seq.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 /**
  * For an overview of the bindings system and the list of available binding, see
@@ -37,12 +40,14 @@ namespace bindings {
      */
     struct MoveActive {
         TetrominoMove tetrominoMove;
+        InputSeq seq = 0;
 
         nlohmann::json to_json() const {
             return nlohmann::json{{PACKET_TYPE_FIELD, BindingType::MoveActive},
                                   {"data",
                                    {
                                        {"tetrominoMove", tetrominoMove},
+                                       {"seq", seq},
                                    }}};
         }
 
@@ -52,7 +57,19 @@ namespace bindings {
             }
 
             const auto &data = j.at("data");
-            return MoveActive{data.at("tetrominoMove").get<TetrominoMove>()};
+            return MoveActive{data.at("tetrominoMove").get<TetrominoMove>(),
+                              readInputSeq(j)};
+        }
+
+        static std::optional<MoveActive> from_flat(const FlatPacket &packet) {
+            const std::optional<TetrominoMove> tetrominoMove =
+                packet.get<TetrominoMove>("tetrominoMove");
+            const std::optional<InputSeq> seq = readInputSeq(packet);
+            if (!tetrominoMove || !seq) {
+                return std::nullopt;
+            }
+
+            return MoveActive{*tetrominoMove, *seq};
         }
     };
 
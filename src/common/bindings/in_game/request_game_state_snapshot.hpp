@@ -0,0 +1,63 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_REQUEST_GAME_STATE_SNAPSHOT_HPP
+#define BINDINGS_REQUEST_GAME_STATE_SNAPSHOT_HPP
+
+#include "../binding_type.hpp"
+#include "../constants.hpp"
+#include "../flat_packet.hpp"
+
+#include <nlohmann/json.hpp>
+#include <optional>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding sent by a client with the DeltaGameState feature when it
+     * can't apply a GameStateDelta (it doesn't have its base): the server
+     * answers with a full GameState.
+     */
+    struct RequestGameStateSnapshot {
+        nlohmann::json to_json() const {
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::RequestGameStateSnapshot},
+            };
+        }
+
+        static RequestGameStateSnapshot from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD)
+                != BindingType::RequestGameStateSnapshot) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            return RequestGameStateSnapshot{};
+        }
+
+        static std::optional<RequestGameStateSnapshot>
+        from_flat(const FlatPacket & /*packet*/) {
+            return RequestGameStateSnapshot{};
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_REQUEST_GAME_STATE_SNAPSHOT_HPP
@@ -20,8 +20,11 @@
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
+#include "input_seq.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 /**
  * For an overview of the bindings system and the list of available binding, see
@@ -35,6 +38,7 @@ namespace bindings {
      */
     struct RotateActive {
         bool rotateClockwise;
+        InputSeq seq = 0;
 
         nlohmann::json to_json() const {
             return nlohmann::json{
@@ -42,6 +46,7 @@ namespace bindings {
                 {"data",
                  {
                      {"rotateClockwise", rotateClockwise},
+                     {"seq", seq},
                  }}};
         }
 
@@ -51,7 +56,20 @@ namespace bindings {
             }
 
             const auto &data = j.at("data");
-            return RotateActive{data.at("rotateClockwise").get<bool>()};
+            return RotateActive{data.at("rotateClockwise").get<bool>(),
+                                readInputSeq(j)};
+        }
+
+        static std::optional<RotateActive>
+        from_flat(const FlatPacket &packet) {
+            const std::optional<bool> rotateClockwise =
+                packet.get<bool>("rotateClockwise");
+            const std::optional<InputSeq> seq = readInputSeq(packet);
+            if (!rotateClockwise || !seq) {
+                return std::nullopt;
+            }
+
+            return RotateActive{*rotateClockwise, *seq};
         }
     };
 
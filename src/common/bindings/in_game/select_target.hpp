@@ -20,10 +20,12 @@
 
 #include "../binding_type.hpp"
 #include "../constants.hpp"
+#include "../flat_packet.hpp"
 
 #include "../../types/types.hpp"
 
 #include <nlohmann/json.hpp>
+#include <optional>
 
 /**
  * For an overview of the bindings system and the list of available binding, see
@@ -54,6 +56,16 @@ namespace bindings {
             const auto &data = j.at("data");
             return SelectTarget{data.at("targetId").get<UserID>()};
         }
+
+        static std::optional<SelectTarget> from_flat(const FlatPacket &packet) {
+            const std::optional<UserID> targetId =
+                packet.get<UserID>("targetId");
+            if (!targetId) {
+                return std::nullopt;
+            }
+
+            return SelectTarget{*targetId};
+        }
     };
 
 } // namespace bindings
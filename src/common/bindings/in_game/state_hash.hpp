@@ -0,0 +1,79 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_STATE_HASH_HPP
+#define BINDINGS_STATE_HASH_HPP
+
+#include "../binding_type.hpp"
+#include "../constants.hpp"
+#include "../flat_packet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <optional>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding sent by a lockstep client every INTERVAL engine ticks:
+     * the hash (see GameState::computeHash()) of its simulation right after
+     * the given tick. The server answers a mismatch with a LockstepSync.
+     */
+    struct StateHash {
+        static constexpr size_t INTERVAL = 20;
+
+        size_t tick;
+        uint64_t hash;
+
+        nlohmann::json to_json() const {
+            return nlohmann::json{{PACKET_TYPE_FIELD, BindingType::StateHash},
+                                  {"data",
+                                   {
+                                       {"tick", tick},
+                                       {"hash", hash},
+                                   }}};
+        }
+
+        static StateHash from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::StateHash) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            const auto &data = j.at("data");
+            return StateHash{data.at("tick").get<size_t>(),
+                             data.at("hash").get<uint64_t>()};
+        }
+
+        static std::optional<StateHash> from_flat(const FlatPacket &packet) {
+            const std::optional<size_t> tick = packet.get<size_t>("tick");
+            const std::optional<uint64_t> hash = packet.get<uint64_t>("hash");
+            if (!tick || !hash) {
+                return std::nullopt;
+            }
+
+            return StateHash{*tick, *hash};
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_STATE_HASH_HPP
@@ -0,0 +1,70 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_NEW_MESSAGE_HPP
+#define BINDINGS_NEW_MESSAGE_HPP
+
+#include "binding_type.hpp"
+#include "constants.hpp"
+#include "conversation.hpp"
+
+#include "../../common/types/types.hpp"
+
+#include <nlohmann/json.hpp>
+#include <string>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding sent by the server to both users of a conversation when
+     * one of them sends a message: the message to append to the receiver's
+     * conversation with the user userID (named username).
+     */
+    struct NewMessage {
+        UserID userID;
+        std::string username;
+        SenderMessage senderMessage;
+
+        nlohmann::json to_json() const {
+            return nlohmann::json{{PACKET_TYPE_FIELD, BindingType::NewMessage},
+                                  {"data",
+                                   {
+                                       {"userID", userID},
+                                       {"username", username},
+                                       {"senderMessage", senderMessage},
+                                   }}};
+        }
+
+        static NewMessage from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::NewMessage) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            const auto &data = j.at("data");
+            return NewMessage{data.at("userID").get<UserID>(),
+                              data.at("username").get<std::string>(),
+                              data.at("senderMessage").get<SenderMessage>()};
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_NEW_MESSAGE_HPP
@@ -22,6 +22,7 @@
 
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
 
 #include "../types/types.hpp"
 #include "constants.hpp"
@@ -33,19 +34,65 @@
 namespace bindings {
 
     /**
-     * @brief Bindings that contains the ranking (each player and their
-     * associated score).
+     * @brief A player of the ranking, with their rank (1 for the best score,
+     * the ties being broken by seniority, i.e. by playerId).
+     *
+     * Its score and playerId are the position a RequestRankingPage starts
+     * after.
+     */
+    struct RankingEntry {
+        size_t rank;
+        std::string username;
+        Score score;
+        UserID playerId;
+
+        nlohmann::json to_json() const {
+            return nlohmann::json{
+                {"rank", rank},
+                {"username", username},
+                {"score", score},
+                {"playerId", playerId},
+            };
+        }
+
+        static RankingEntry from_json(const nlohmann::json &j) {
+            return RankingEntry{j.at("rank").get<size_t>(),
+                                j.at("username").get<std::string>(),
+                                j.at("score").get<Score>(),
+                                j.at("playerId").get<UserID>()};
+        }
+    };
+
+    /**
+     * @brief Bindings that contains the part of the ranking a player is
+     * interested in: the TOP_SIZE best players, then the NEIGHBOURS players
+     * ranked right before and after them.
+     *
+     * It is sent at login and when the player's best score improves. The
+     * other players' improvements are pushed as RankingDelta bindings, and
+     * the client asks for the rest of the ranking with RequestRankingPage.
      */
     struct Ranking {
-        using PlayerScore = std::pair<std::string, Score>;
+        static constexpr size_t TOP_SIZE = 10;
+        static constexpr size_t NEIGHBOURS = 2;
+        static constexpr size_t PAGE_SIZE = 20;
 
-        std::vector<PlayerScore> ranking;
+        // sorted by rank, with a gap between the top and the player's
+        // neighbours unless they overlap
+        std::vector<RankingEntry> ranking;
+        size_t ownRank;
 
         nlohmann::json to_json() const {
+            nlohmann::json j_ranking = nlohmann::json::array();
+            for (const RankingEntry &entry : ranking) {
+                j_ranking.push_back(entry.to_json());
+            }
+
             return nlohmann::json{{PACKET_TYPE_FIELD, BindingType::Ranking},
                                   {"data",
                                    {
-                                       {"ranking", ranking},
+                                       {"ranking", j_ranking},
+                                       {"ownRank", ownRank},
                                    }}};
         }
 
@@ -55,7 +102,13 @@ namespace bindings {
             }
 
             const auto &data = j.at("data");
-            return Ranking{data.at("ranking").get<std::vector<PlayerScore>>()};
+
+            Ranking ranking{{}, data.at("ownRank").get<size_t>()};
+            for (const auto &j_entry : data.at("ranking")) {
+                ranking.ranking.push_back(RankingEntry::from_json(j_entry));
+            }
+
+            return ranking;
         }
     };
 
@@ -0,0 +1,72 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_RANKING_PAGE_HPP
+#define BINDINGS_RANKING_PAGE_HPP
+
+#include "binding_type.hpp"
+#include "constants.hpp"
+#include "ranking.hpp"
+
+#include <nlohmann/json.hpp>
+#include <vector>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding sent by the server in answer to a RequestRankingPage:
+     * consecutive players of the ranking, to merge with the ones the client
+     * already has. It is empty past the last player.
+     */
+    struct RankingPage {
+        std::vector<RankingEntry> ranking;
+
+        nlohmann::json to_json() const {
+            nlohmann::json j_ranking = nlohmann::json::array();
+            for (const RankingEntry &entry : ranking) {
+                j_ranking.push_back(entry.to_json());
+            }
+
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::RankingPage},
+                {"data",
+                 {
+                     {"ranking", j_ranking},
+                 }}};
+        }
+
+        static RankingPage from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::RankingPage) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            RankingPage rankingPage;
+            for (const auto &j_entry : j.at("data").at("ranking")) {
+                rankingPage.ranking.push_back(RankingEntry::from_json(j_entry));
+            }
+
+            return rankingPage;
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_RANKING_PAGE_HPP
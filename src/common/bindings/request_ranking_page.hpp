@@ -0,0 +1,74 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_REQUEST_RANKING_PAGE_HPP
+#define BINDINGS_REQUEST_RANKING_PAGE_HPP
+
+#include "binding_type.hpp"
+#include "constants.hpp"
+
+#include <cstddef>
+#include <nlohmann/json.hpp>
+
+#include "../types/types.hpp"
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief Binding sent by the client to get the players of the ranking
+     * ranked after the last one it has, of rank firstRank - 1 (up to
+     * Ranking::PAGE_SIZE of them). The server answers with a RankingPage.
+     *
+     * The page starts after the score and playerId of that last player, which
+     * costs the server the same at any rank. A firstRank of 1 asks for the top
+     * of the ranking, the position is then ignored.
+     */
+    struct RequestRankingPage {
+        size_t firstRank;
+        Score afterScore;
+        UserID afterPlayerId;
+
+        nlohmann::json to_json() const {
+            return nlohmann::json{
+                {PACKET_TYPE_FIELD, BindingType::RequestRankingPage},
+                {"data",
+                 {
+                     {"firstRank", firstRank},
+                     {"afterScore", afterScore},
+                     {"afterPlayerId", afterPlayerId},
+                 }}};
+        }
+
+        static RequestRankingPage from_json(const nlohmann::json &j) {
+            if (j.at(PACKET_TYPE_FIELD) != BindingType::RequestRankingPage) {
+                throw std::runtime_error("Invalid type field in JSON");
+            }
+
+            const auto &data = j.at("data");
+            return RequestRankingPage{data.at("firstRank").get<size_t>(),
+                                      data.at("afterScore").get<Score>(),
+                                      data.at("afterPlayerId").get<UserID>()};
+        }
+    };
+
+} // namespace bindings
+
+#endif // BINDINGS_REQUEST_RANKING_PAGE_HPP
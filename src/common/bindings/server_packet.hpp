@@ -0,0 +1,95 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BINDINGS_SERVER_PACKET_HPP
+#define BINDINGS_SERVER_PACKET_HPP
+
+#include "authentication_response.hpp"
+#include "binding_registry.hpp"
+#include "binding_type.hpp"
+#include "conversation_page.hpp"
+#include "conversations.hpp"
+#include "friends_list.hpp"
+#include "in_game/engine_tick.hpp"
+#include "in_game/game_input.hpp"
+#include "in_game/game_state_client.hpp"
+#include "in_game/game_state_delta.hpp"
+#include "in_game/lockstep_sync.hpp"
+#include "new_message.hpp"
+#include "pending_friend_requests.hpp"
+#include "ping.hpp"
+#include "ranking.hpp"
+#include "ranking_delta.hpp"
+#include "ranking_page.hpp"
+#include "registration_response.hpp"
+#include "user.hpp"
+
+#include <nlohmann/json.hpp>
+#include <string_view>
+
+/**
+ * For an overview of the bindings system and the list of available binding, see
+ * bindings_type.hpp.
+ */
+namespace bindings {
+
+    /**
+     * @brief The bindings the server sends to a client (used by the client).
+     */
+    using ServerBindings = BindingRegistry<
+        BindingEntry<BindingType::AuthenticationResponse,
+                     AuthenticationResponse>,
+        BindingEntry<BindingType::RegistrationResponse, RegistrationResponse>,
+        BindingEntry<BindingType::FriendsList, FriendsList>,
+        BindingEntry<BindingType::Conversations, Conversations>,
+        BindingEntry<BindingType::NewMessage, NewMessage>,
+        BindingEntry<BindingType::ConversationPage, ConversationPage>,
+        BindingEntry<BindingType::User, User>,
+        BindingEntry<BindingType::PendingFriendRequests,
+                     PendingFriendRequests>,
+        BindingEntry<BindingType::Ranking, Ranking>,
+        BindingEntry<BindingType::RankingDelta, RankingDelta>,
+        BindingEntry<BindingType::RankingPage, RankingPage>,
+        BindingEntry<BindingType::GameState, ReceivedGameState>,
+        BindingEntry<BindingType::GameStateViewer, ReceivedGameState>,
+        BindingEntry<BindingType::GameStateDelta, GameStateDelta>,
+        BindingEntry<BindingType::LockstepSync, LockstepSync>,
+        BindingEntry<BindingType::GameInput, GameInput>,
+        BindingEntry<BindingType::EngineTick, EngineTick>,
+        BindingEntry<BindingType::Ping, Ping>>;
+
+    /**
+     * @brief A packet sent by the server to a client, parsed into the binding
+     * of its type.
+     */
+    using ServerPacket = ServerBindings::Packet;
+
+    /**
+     * @brief Parses the given packet received from the server (without its
+     * framing).
+     *
+     * @throws nlohmann::json::exception if it isn't valid JSON or doesn't
+     * have the fields of its binding, std::runtime_error if its type isn't
+     * one the server sends.
+     */
+    inline ServerPacket parseServerPacket(std::string_view packet) {
+        return ServerBindings::fromJson(nlohmann::json::parse(packet));
+    }
+
+} // namespace bindings
+
+#endif // BINDINGS_SERVER_PACKET_HPP
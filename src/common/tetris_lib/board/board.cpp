@@ -25,7 +25,7 @@
 #include <array>
 #include <cstddef>
 #include <memory>
-#include <random>
+#include <optional>
 
 /*--------------------------------------------------
                     PRIVATE
@@ -71,12 +71,10 @@ void Board::setPenaltyRow(std::array<GridCell, width_> &row) {
     constexpr int firstCol = 0;
     const int lastCol = getWidth() - 1;
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> distrib(firstCol, lastCol);
-
     // The empty block in the row
-    size_t emptyIndex = static_cast<size_t>(distrib(gen));
+    size_t emptyIndex = static_cast<size_t>(firstCol)
+                        + rng_.nextIndex(static_cast<size_t>(lastCol - firstCol)
+                                         + 1);
 
     // Fill all the GridCell with penaltyBlocksColor except one (empty state)
     for (size_t xCol = 0; xCol < getWidth(); xCol++) {
@@ -154,6 +152,10 @@ void Board::gravity() {
                     PUBLIC
 --------------------------------------------------*/
 
+// #### Constructors ####
+
+Board::Board(Seed seed) : rng_{seed} {}
+
 // #### Getters ####
 
 const GridCell &Board::get(int xCol, int yRow) const {
@@ -215,11 +217,8 @@ void Board::empty2By2Square(int x, int y) {
 }
 
 void Board::destroy2By2Occupied() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> distrib(0, Board::getHeight()
-                                                      * Board::getWidth());
-    int tmp = distrib(gen);
+    int tmp = static_cast<int>(
+        rng_.nextIndex(Board::getHeight() * Board::getWidth() + 1));
     int startY =
         static_cast<int>(static_cast<size_t>(tmp) / Board::getHeight());
     int startX = static_cast<int>(static_cast<size_t>(tmp) % Board::getWidth());
@@ -305,3 +304,33 @@ void Board::deserialize(const nlohmann::json &j) {
         }
     }
 }
+
+/* ------------------------------------------------
+ *          Snapshot
+ * ------------------------------------------------*/
+
+void Board::writeSnapshot(ByteWriter &writer) const {
+    writer.writeU64(rng_.getState());
+
+    for (const auto &row : grid_) {
+        for (const GridCell &cell : row) {
+            std::optional<unsigned> colorId = cell.getColorId();
+            writer.writeOptionalVarint(colorId);
+        }
+    }
+}
+
+void Board::readSnapshot(ByteReader &reader) {
+    rng_.setState(reader.readU64());
+
+    for (auto &row : grid_) {
+        for (GridCell &cell : row) {
+            std::optional<uint64_t> colorId = reader.readOptionalVarint();
+            if (colorId.has_value()) {
+                cell.setColorId(static_cast<unsigned>(*colorId));
+            } else {
+                cell.setEmpty();
+            }
+        }
+    }
+}
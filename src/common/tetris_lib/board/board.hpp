@@ -18,6 +18,7 @@
 #ifndef BOARD_HPP
 #define BOARD_HPP
 
+#include "../rng/rng.hpp"
 #include "../tetromino/abstract_tetromino.hpp"
 #include "../tetromino/tetromino_shapes.hpp"
 #include "board_update.hpp"
@@ -46,6 +47,9 @@ class Board {
     static constexpr size_t height_ = 20;
     std::array<std::array<GridCell, width_>, height_> grid_;
 
+    // used to pick the penalty rows holes and the destroyed squares
+    Rng rng_;
+
     // #### Internal helper ####
 
     /**
@@ -191,6 +195,13 @@ class Board {
     // #### Constructors ####
 
     Board() = default;
+
+    /**
+     * @brief Constructs an empty board whose random events (penalty rows
+     * holes, destroyed squares) are drawn from the given seed.
+     */
+    explicit Board(Seed seed);
+
     Board(const Board &) = default;
     Board(Board &&) = default;
 
@@ -301,6 +312,21 @@ class Board {
      */
     void deserialize(const nlohmann::json &j);
 
+    /* ------------------------------------------------
+     *          Snapshot
+     * ------------------------------------------------*/
+
+    /**
+     * @brief Writes the complete state of the board (cells and random
+     * generator) in binary.
+     */
+    void writeSnapshot(ByteWriter &writer) const;
+
+    /**
+     * @brief Restores a state written by writeSnapshot().
+     */
+    void readSnapshot(ByteReader &reader);
+
     /* ------------------------------------------------
      *          Test Fixture Class
      * ------------------------------------------------*/
@@ -0,0 +1,116 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "base64.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace {
+
+    constexpr std::string_view ALPHABET =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    constexpr char PADDING = '=';
+
+    constexpr uint8_t INVALID = 0xFF;
+
+    constexpr std::array<uint8_t, 256> DECODING_TABLE = [] {
+        std::array<uint8_t, 256> table;
+        table.fill(INVALID);
+        for (size_t i = 0; i < ALPHABET.size(); ++i) {
+            table.at(static_cast<uint8_t>(ALPHABET[i])) =
+                static_cast<uint8_t>(i);
+        }
+        return table;
+    }();
+
+} // namespace
+
+std::string base64::encode(std::span<const uint8_t> bytes) {
+    std::string text;
+    text.reserve((bytes.size() + 2) / 3 * 4);
+
+    size_t i = 0;
+    for (; i + 3 <= bytes.size(); i += 3) {
+        const uint32_t group = (static_cast<uint32_t>(bytes[i]) << 16)
+                               | (static_cast<uint32_t>(bytes[i + 1]) << 8)
+                               | bytes[i + 2];
+        text.push_back(ALPHABET[(group >> 18) & 0x3F]);
+        text.push_back(ALPHABET[(group >> 12) & 0x3F]);
+        text.push_back(ALPHABET[(group >> 6) & 0x3F]);
+        text.push_back(ALPHABET[group & 0x3F]);
+    }
+
+    const size_t remaining = bytes.size() - i;
+    if (remaining > 0) {
+        uint32_t group = static_cast<uint32_t>(bytes[i]) << 16;
+        if (remaining == 2) {
+            group |= static_cast<uint32_t>(bytes[i + 1]) << 8;
+        }
+
+        text.push_back(ALPHABET[(group >> 18) & 0x3F]);
+        text.push_back(ALPHABET[(group >> 12) & 0x3F]);
+        text.push_back(remaining == 2 ? ALPHABET[(group >> 6) & 0x3F]
+                                      : PADDING);
+        text.push_back(PADDING);
+    }
+
+    return text;
+}
+
+std::vector<uint8_t> base64::decode(std::string_view text) {
+    if (text.size() % 4 != 0) {
+        throw std::runtime_error("invalid base64 length");
+    }
+
+    size_t numPadding = 0;
+    while (numPadding < 2 && numPadding < text.size()
+           && text[text.size() - 1 - numPadding] == PADDING) {
+        ++numPadding;
+    }
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(text.size() / 4 * 3);
+
+    for (size_t i = 0; i < text.size(); i += 4) {
+        const bool isLast = i + 4 == text.size();
+        const size_t numChars = isLast ? 4 - numPadding : 4;
+
+        uint32_t group = 0;
+        for (size_t k = 0; k < 4; ++k) {
+            uint8_t value = 0;
+            if (k < numChars) {
+                value = DECODING_TABLE[static_cast<uint8_t>(text[i + k])];
+                if (value == INVALID) {
+                    throw std::runtime_error("invalid base64 character");
+                }
+            }
+            group = (group << 6) | value;
+        }
+
+        bytes.push_back(static_cast<uint8_t>(group >> 16));
+        if (numChars > 2) {
+            bytes.push_back(static_cast<uint8_t>(group >> 8));
+        }
+        if (numChars > 3) {
+            bytes.push_back(static_cast<uint8_t>(group));
+        }
+    }
+
+    return bytes;
+}
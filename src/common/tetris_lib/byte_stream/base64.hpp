@@ -0,0 +1,44 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BASE64_HPP
+#define BASE64_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Base64 (RFC 4648, with padding) conversion of binary buffers, to
+ * embed them in text (JSON) packets.
+ */
+namespace base64 {
+
+    std::string encode(std::span<const uint8_t> bytes);
+
+    /**
+     * @brief Decodes the given base64 text.
+     *
+     * @throws std::runtime_error if the text isn't valid base64.
+     */
+    std::vector<uint8_t> decode(std::string_view text);
+
+} // namespace base64
+
+#endif // BASE64_HPP
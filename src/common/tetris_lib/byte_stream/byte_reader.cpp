@@ -0,0 +1,124 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "byte_reader.hpp"
+
+#include <stdexcept>
+
+// --- private ---
+
+void ByteReader::require(size_t numBytes) const {
+    if (numBytes > remaining()) {
+        throw std::runtime_error("ByteReader: unexpected end of data");
+    }
+}
+
+// --- public ---
+
+ByteReader::ByteReader(std::span<const uint8_t> bytes, size_t pos)
+    : bytes_{bytes}, pos_{0} {
+    seek(pos);
+}
+
+// #### Fixed-size values ####
+
+uint8_t ByteReader::readU8() {
+    require(1);
+    return bytes_[pos_++];
+}
+
+bool ByteReader::readBool() { return readU8() != 0; }
+
+uint16_t ByteReader::readU16() {
+    require(sizeof(uint16_t));
+    uint16_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++) {
+        value |= static_cast<uint16_t>(bytes_[pos_++] << (8 * i));
+    }
+    return value;
+}
+
+uint32_t ByteReader::readU32() {
+    require(sizeof(uint32_t));
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++) {
+        value |= static_cast<uint32_t>(bytes_[pos_++]) << (8 * i);
+    }
+    return value;
+}
+
+uint64_t ByteReader::readU64() {
+    require(sizeof(uint64_t));
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++) {
+        value |= static_cast<uint64_t>(bytes_[pos_++]) << (8 * i);
+    }
+    return value;
+}
+
+// #### Variable-size values ####
+
+uint64_t ByteReader::readVarint() {
+    uint64_t value = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = readU8();
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    throw std::runtime_error("ByteReader: varint is too long");
+}
+
+int64_t ByteReader::readSignedVarint() {
+    uint64_t value = readVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+std::optional<uint64_t> ByteReader::readOptionalVarint() {
+    uint64_t value = readVarint();
+    return value == 0 ? std::nullopt : std::make_optional(value - 1);
+}
+
+std::string ByteReader::readString() {
+    std::span<const uint8_t> chars = readBytes(readVarint());
+    return std::string(chars.begin(), chars.end());
+}
+
+std::span<const uint8_t> ByteReader::readBytes(size_t numBytes) {
+    require(numBytes);
+    std::span<const uint8_t> ret = bytes_.subspan(pos_, numBytes);
+    pos_ += numBytes;
+    return ret;
+}
+
+// #### Position ####
+
+size_t ByteReader::getPosition() const noexcept { return pos_; }
+
+void ByteReader::seek(size_t pos) {
+    if (pos > bytes_.size()) {
+        throw std::runtime_error("ByteReader: seek out of the data");
+    }
+    pos_ = pos;
+}
+
+size_t ByteReader::remaining() const noexcept { return bytes_.size() - pos_; }
+
+bool ByteReader::atEnd() const noexcept { return pos_ >= bytes_.size(); }
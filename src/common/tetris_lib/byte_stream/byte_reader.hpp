@@ -0,0 +1,96 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BYTE_READER_HPP
+#define BYTE_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+/**
+ * @class ByteReader
+ *
+ * @brief Reads values written by a ByteWriter from a (non-owned) span of
+ * bytes.
+ *
+ * Every read checks the bounds of the span and throws a std::runtime_error if
+ * the data is truncated or malformed.
+ */
+class ByteReader {
+  private:
+    std::span<const uint8_t> bytes_;
+    size_t pos_;
+
+    /**
+     * @brief Throws if less than numBytes bytes are left.
+     */
+    void require(size_t numBytes) const;
+
+  public:
+    explicit ByteReader(std::span<const uint8_t> bytes, size_t pos = 0);
+    ByteReader(const ByteReader &) = default;
+    ByteReader(ByteReader &&) = default;
+    ByteReader &operator=(const ByteReader &) = default;
+    ByteReader &operator=(ByteReader &&) = default;
+
+    ~ByteReader() = default;
+
+    // #### Fixed-size values ####
+
+    uint8_t readU8();
+
+    bool readBool();
+
+    uint16_t readU16();
+
+    uint32_t readU32();
+
+    uint64_t readU64();
+
+    // #### Variable-size values ####
+
+    uint64_t readVarint();
+
+    int64_t readSignedVarint();
+
+    std::optional<uint64_t> readOptionalVarint();
+
+    std::string readString();
+
+    /**
+     * @brief Returns a view on the next numBytes bytes and skips them.
+     */
+    std::span<const uint8_t> readBytes(size_t numBytes);
+
+    // #### Position ####
+
+    size_t getPosition() const noexcept;
+
+    /**
+     * @brief Moves the read position to the given offset.
+     */
+    void seek(size_t pos);
+
+    size_t remaining() const noexcept;
+
+    bool atEnd() const noexcept;
+};
+
+#endif // BYTE_READER_HPP
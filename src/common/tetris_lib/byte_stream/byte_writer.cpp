@@ -0,0 +1,99 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "byte_writer.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+// #### Fixed-size values ####
+
+void ByteWriter::writeU8(uint8_t value) { bytes_.push_back(value); }
+
+void ByteWriter::writeBool(bool value) { writeU8(value ? 1 : 0); }
+
+void ByteWriter::writeU16(uint16_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        writeU8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void ByteWriter::writeU32(uint32_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        writeU8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void ByteWriter::writeU64(uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        writeU8(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+// #### Variable-size values ####
+
+void ByteWriter::writeVarint(uint64_t value) {
+    while (value >= 0x80) {
+        writeU8(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    writeU8(static_cast<uint8_t>(value));
+}
+
+void ByteWriter::writeSignedVarint(int64_t value) {
+    writeVarint((static_cast<uint64_t>(value) << 1)
+                ^ static_cast<uint64_t>(value >> 63));
+}
+
+void ByteWriter::writeOptionalVarint(std::optional<uint64_t> value) {
+    writeVarint(value.has_value() ? *value + 1 : 0);
+}
+
+void ByteWriter::writeString(std::string_view str) {
+    writeVarint(str.size());
+    bytes_.insert(bytes_.end(), str.begin(), str.end());
+}
+
+void ByteWriter::writeBytes(std::span<const uint8_t> bytes) {
+    bytes_.insert(bytes_.end(), bytes.begin(), bytes.end());
+}
+
+void ByteWriter::alignTo(size_t alignment) {
+    while (bytes_.size() % alignment != 0) {
+        writeU8(0);
+    }
+}
+
+void ByteWriter::patchU64(size_t offset, uint64_t value) {
+    if (offset + sizeof(value) > bytes_.size()) {
+        throw std::out_of_range("ByteWriter: patch out of the buffer");
+    }
+
+    for (size_t i = 0; i < sizeof(value); i++) {
+        bytes_.at(offset + i) = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+// #### Getters ####
+
+size_t ByteWriter::size() const noexcept { return bytes_.size(); }
+
+const std::vector<uint8_t> &ByteWriter::getBytes() const noexcept {
+    return bytes_;
+}
+
+std::vector<uint8_t> ByteWriter::release() { return std::move(bytes_); }
@@ -0,0 +1,106 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BYTE_WRITER_HPP
+#define BYTE_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class ByteWriter
+ *
+ * @brief Appends binary encoded values to a growing buffer.
+ *
+ * Fixed-size integers are written in little-endian order, varints use the
+ * LEB128 encoding (7 bits per byte) and signed varints are zigzag-encoded
+ * first so that small negative values stay small.
+ */
+class ByteWriter {
+  private:
+    std::vector<uint8_t> bytes_;
+
+  public:
+    ByteWriter() = default;
+    ByteWriter(const ByteWriter &) = default;
+    ByteWriter(ByteWriter &&) = default;
+    ByteWriter &operator=(const ByteWriter &) = default;
+    ByteWriter &operator=(ByteWriter &&) = default;
+
+    ~ByteWriter() = default;
+
+    // #### Fixed-size values ####
+
+    void writeU8(uint8_t value);
+
+    void writeBool(bool value);
+
+    void writeU16(uint16_t value);
+
+    void writeU32(uint32_t value);
+
+    void writeU64(uint64_t value);
+
+    // #### Variable-size values ####
+
+    void writeVarint(uint64_t value);
+
+    void writeSignedVarint(int64_t value);
+
+    /**
+     * @brief Writes 0 for nullopt, value + 1 otherwise (as a varint).
+     */
+    void writeOptionalVarint(std::optional<uint64_t> value);
+
+    /**
+     * @brief Writes the string's length (varint) followed by its characters.
+     */
+    void writeString(std::string_view str);
+
+    /**
+     * @brief Writes the given bytes as is.
+     */
+    void writeBytes(std::span<const uint8_t> bytes);
+
+    /**
+     * @brief Pads the buffer with zeros until its size is a multiple of the
+     * given alignment.
+     */
+    void alignTo(size_t alignment);
+
+    /**
+     * @brief Overwrites the 8 bytes at the given offset with the given value.
+     */
+    void patchU64(size_t offset, uint64_t value);
+
+    // #### Getters ####
+
+    size_t size() const noexcept;
+
+    const std::vector<uint8_t> &getBytes() const noexcept;
+
+    /**
+     * @brief Moves the buffer out of the writer, leaving it empty.
+     */
+    std::vector<uint8_t> release();
+};
+
+#endif // BYTE_WRITER_HPP
@@ -0,0 +1,58 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "rng.hpp"
+
+#include <random>
+
+// #### Constructors ####
+
+Rng::Rng(Seed seed) : state_{seed} {}
+
+// #### Generation ####
+
+uint64_t Rng::next() {
+    state_ += 0x9E3779B97F4A7C15ULL;
+
+    uint64_t z = state_;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+size_t Rng::nextIndex(size_t bound) {
+    // the modulo bias is negligible for the small bounds used by the game
+    return static_cast<size_t>(next() % bound);
+}
+
+// #### State ####
+
+uint64_t Rng::getState() const noexcept { return state_; }
+
+void Rng::setState(uint64_t state) noexcept { state_ = state; }
+
+// #### Seeding ####
+
+Seed Rng::randomSeed() {
+    std::random_device rd;
+    return (static_cast<Seed>(rd()) << 32) | static_cast<Seed>(rd());
+}
+
+Seed Rng::deriveSeed(Seed seed, uint64_t salt) {
+    Rng rng{seed ^ (salt * 0xD1B54A32D192ED03ULL)};
+    return rng.next();
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include "../../types/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @class Rng
+ *
+ * @brief Small seedable pseudo-random number generator (SplitMix64).
+ *
+ * Unlike the standard distributions, the sequence produced for a given seed is
+ * the same on every platform and standard library, which is what makes games
+ * reproducible from their seed.
+ */
+class Rng {
+  private:
+    uint64_t state_;
+
+  public:
+    // #### Constructors ####
+
+    /**
+     * @brief Constructs a generator seeded with the given seed.
+     */
+    explicit Rng(Seed seed = 0);
+    Rng(const Rng &) = default;
+    Rng(Rng &&) = default;
+
+    // #### Assignment ####
+
+    Rng &operator=(const Rng &) = default;
+    Rng &operator=(Rng &&) = default;
+
+    // #### Destructor ####
+
+    ~Rng() = default;
+
+    // #### Generation ####
+
+    /**
+     * @brief Returns the next raw 64 bits value of the sequence.
+     */
+    uint64_t next();
+
+    /**
+     * @brief Returns a value uniformly picked in [0, bound).
+     *
+     * @param bound The exclusive upper bound, must be strictly positive.
+     */
+    size_t nextIndex(size_t bound);
+
+    /**
+     * @brief Shuffles the given random-access range (Fisher-Yates).
+     */
+    template <typename RandomIt> void shuffle(RandomIt first, RandomIt last) {
+        const auto size = last - first;
+        for (auto i = size - 1; i > 0; --i) {
+            auto j = static_cast<decltype(i)>(
+                nextIndex(static_cast<size_t>(i) + 1));
+            std::swap(first[i], first[j]);
+        }
+    }
+
+    // #### State ####
+
+    /**
+     * @brief Returns the internal state, it can be used to restore the
+     * generator later on.
+     */
+    uint64_t getState() const noexcept;
+
+    /**
+     * @brief Restores a state previously returned by getState().
+     */
+    void setState(uint64_t state) noexcept;
+
+    // #### Seeding ####
+
+    /**
+     * @brief Returns a non-deterministic seed (from std::random_device).
+     */
+    static Seed randomSeed();
+
+    /**
+     * @brief Derives a seed from the given seed and salt, e.g. to give each
+     * player of a game its own sequence.
+     */
+    static Seed deriveSeed(Seed seed, uint64_t salt);
+};
+
+#endif // RNG_HPP
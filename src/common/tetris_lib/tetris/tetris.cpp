@@ -78,8 +78,12 @@ bool Tetris::checkEmptyCell(size_t xCol, size_t yRow) const {
 
 // #### Constructors ####
 
-Tetris::Tetris()
-    : lockDelayTicksNum_{DEFAULT_LOCK_DELAY_TICKS_NUM}, ticksSinceLockStart_{0},
+Tetris::Tetris() : Tetris(Rng::randomSeed()) {}
+
+Tetris::Tetris(Seed seed)
+    : board_{Rng::deriveSeed(seed, 0)},
+      tetrominoQueue_{Rng::deriveSeed(seed, 1)},
+      lockDelayTicksNum_{DEFAULT_LOCK_DELAY_TICKS_NUM}, ticksSinceLockStart_{0},
       canHold_{true} {
     activeTetromino_ = tetrominoQueue_.fetchNext();
 }
@@ -244,6 +248,10 @@ Vec2 Tetris::getTetrominoInitialAnchorPoint(TetrominoShape tetrominoShape) {
 
 void Tetris::destroy2By2Occupied() { board_.destroy2By2Occupied(); }
 
+bool Tetris::checkCanDropActive() const {
+    return checkCanDrop(*activeTetromino_);
+}
+
 /* ------------------------------------------------
  *          Serialization
  * ------------------------------------------------*/
@@ -272,3 +280,64 @@ nlohmann::json Tetris::serializeExternal() const {
         {"board", board_.serialize()},
     };
 }
+
+void Tetris::deserializeSelf(const nlohmann::json &j) {
+    auto tetrominoDeserialize = [](const nlohmann::json &j_tetromino) {
+        return j_tetromino.is_null() ? nullptr
+                                     : ATetromino::deserialize(j_tetromino);
+    };
+
+    board_.deserialize(j.at("board"));
+    holdTetromino_ = tetrominoDeserialize(j.at("holdTetromino"));
+    activeTetromino_ = tetrominoDeserialize(j.at("activeTetromino"));
+
+    if (activeTetromino_ != nullptr) {
+        updatePreviewTetromino();
+    } else {
+        previewTetromino_ = nullptr;
+    }
+}
+
+/* ------------------------------------------------
+ *          Snapshot
+ * ------------------------------------------------*/
+
+void Tetris::writeSnapshot(ByteWriter &writer) const {
+    auto writeTetromino = [&writer](const TetrominoPtr &pTetromino) {
+        writer.writeBool(pTetromino != nullptr);
+        if (pTetromino != nullptr) {
+            pTetromino->writeSnapshot(writer);
+        }
+    };
+
+    writeTetromino(activeTetromino_);
+    writeTetromino(holdTetromino_);
+    board_.writeSnapshot(writer);
+    tetrominoQueue_.writeSnapshot(writer);
+
+    writer.writeVarint(lockDelayTicksNum_);
+    writer.writeVarint(ticksSinceLockStart_);
+    writer.writeBool(canHold_);
+}
+
+void Tetris::readSnapshot(ByteReader &reader) {
+    auto readTetromino = [&reader]() -> TetrominoPtr {
+        return reader.readBool() ? ATetromino::readSnapshot(reader) : nullptr;
+    };
+
+    activeTetromino_ = readTetromino();
+    holdTetromino_ = readTetromino();
+    board_.readSnapshot(reader);
+    tetrominoQueue_.readSnapshot(reader);
+
+    lockDelayTicksNum_ = static_cast<uint32_t>(reader.readVarint());
+    ticksSinceLockStart_ = static_cast<uint32_t>(reader.readVarint());
+    canHold_ = reader.readBool();
+
+    // the preview is entirely determined by the active tetromino and the board
+    if (activeTetromino_ != nullptr) {
+        updatePreviewTetromino();
+    } else {
+        previewTetromino_.reset();
+    }
+}
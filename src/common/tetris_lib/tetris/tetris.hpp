@@ -93,6 +93,13 @@ class Tetris {
     // #### Constructors ####
 
     Tetris();
+
+    /**
+     * @brief Constructs a Tetris whose random events (tetrominoes order,
+     * penalty rows, ...) are fully determined by the given seed.
+     */
+    explicit Tetris(Seed seed);
+
     Tetris(const Tetris &) = delete;
     Tetris(Tetris &&) = default;
 
@@ -195,6 +202,12 @@ class Tetris {
      */
     void destroy2By2Occupied();
 
+    /**
+     * @brief Returns true if the active Tetromino can move down without being
+     * placed.
+     */
+    bool checkCanDropActive() const;
+
     /* ------------------------------------------------
      *          Serialization
      * ------------------------------------------------*/
@@ -203,6 +216,30 @@ class Tetris {
 
     nlohmann::json serializeExternal() const;
 
+    /**
+     * @brief Restores the board and the active and hold tetrominoes from the
+     * output of serializeSelf(). The queue isn't part of it: the restored
+     * Tetris can only be used to move and rotate its active Tetromino (e.g.
+     * to predict the server's response to these inputs).
+     */
+    void deserializeSelf(const nlohmann::json &j);
+
+    /* ------------------------------------------------
+     *          Snapshot
+     * ------------------------------------------------*/
+
+    /**
+     * @brief Writes the complete state of the Tetris (tetrominoes, board,
+     * queue and lock delay) in binary. Observers are not part of the
+     * snapshot.
+     */
+    void writeSnapshot(ByteWriter &writer) const;
+
+    /**
+     * @brief Restores a state written by writeSnapshot().
+     */
+    void readSnapshot(ByteReader &reader);
+
     /* ------------------------------------------------
      *          Test Fixture Class
      * ------------------------------------------------*/
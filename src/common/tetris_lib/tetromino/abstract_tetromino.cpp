@@ -235,3 +235,63 @@ std::ostream &operator<<(std::ostream &os, const ATetromino &tetromino) {
     std::cout << "}";
     return os;
 }
+
+/* ------------------------------------------------
+ *          Serialization
+ * ------------------------------------------------*/
+
+TetrominoPtr ATetromino::deserialize(const nlohmann::json &j) {
+    Vec2 anchorPoint;
+    anchorPoint.deserialize(j.at("anchorPoint"));
+
+    TetrominoPtr pTetromino = makeTetromino(
+        static_cast<TetrominoShape>(j.at("colorId").get<unsigned>()),
+        std::move(anchorPoint));
+    if (pTetromino == nullptr) {
+        throw std::runtime_error("invalid tetromino shape in JSON");
+    }
+
+    const size_t rotationIdx =
+        j.at("rotationIdx").get<size_t>() % NUM_ROTATIONS;
+    while (static_cast<size_t>(pTetromino->rotationIdx_) != rotationIdx) {
+        pTetromino->rotate(true);
+    }
+
+    return pTetromino;
+}
+
+/* ------------------------------------------------
+ *          Snapshot
+ * ------------------------------------------------*/
+
+void ATetromino::writeSnapshot(ByteWriter &writer) const {
+    writer.writeU8(static_cast<uint8_t>(shape_));
+    writer.writeSignedVarint(anchorPoint_.getX());
+    writer.writeSignedVarint(anchorPoint_.getY());
+    writer.writeU8(static_cast<uint8_t>(static_cast<size_t>(rotationIdx_)));
+    writer.writeU8(static_cast<uint8_t>(static_cast<size_t>(prevRotationIdx_)));
+}
+
+TetrominoPtr ATetromino::readSnapshot(ByteReader &reader) {
+    TetrominoShape shape = static_cast<TetrominoShape>(reader.readU8());
+    int x = static_cast<int>(reader.readSignedVarint());
+    int y = static_cast<int>(reader.readSignedVarint());
+    size_t rotationIdx = reader.readU8() % NUM_ROTATIONS;
+    size_t prevRotationIdx = reader.readU8() % NUM_ROTATIONS;
+
+    TetrominoPtr pTetromino = makeTetromino(shape, Vec2{x, y});
+    if (pTetromino == nullptr) {
+        throw std::runtime_error("invalid tetromino shape in snapshot");
+    }
+
+    // Rotating doesn't move the anchor point: replay the rotations so that
+    // the body and both rotation indexes end up as they were.
+    while (static_cast<size_t>(pTetromino->rotationIdx_) != prevRotationIdx) {
+        pTetromino->rotate(true);
+    }
+    if (rotationIdx != prevRotationIdx) {
+        pTetromino->rotate(rotationIdx == (prevRotationIdx + 1) % NUM_ROTATIONS);
+    }
+
+    return pTetromino;
+}
@@ -18,6 +18,8 @@
 #ifndef ABSTRACT_TETROMINO_HPP
 #define ABSTRACT_TETROMINO_HPP
 
+#include "../byte_stream/byte_reader.hpp"
+#include "../byte_stream/byte_writer.hpp"
 #include "../vec2/vec2.hpp"
 #include "cyclic_index/cyclic_index.hpp"
 
@@ -294,9 +296,31 @@ class ATetromino {
             {"anchorPoint", anchorPoint_.serialize()},
             {"body", j_body},
             {"colorId", getColorId()},
+            {"rotationIdx", static_cast<size_t>(rotationIdx_)},
         };
     }
 
+    /**
+     * @brief Creates a tetromino from the output of serialize() (the colorId
+     * being the shape).
+     */
+    static TetrominoPtr deserialize(const nlohmann::json &j);
+
+    /* ------------------------------------------------
+     *          Snapshot
+     * ------------------------------------------------*/
+
+    /**
+     * @brief Writes the complete state of the tetromino (shape, position and
+     * rotation) in binary.
+     */
+    void writeSnapshot(ByteWriter &writer) const;
+
+    /**
+     * @brief Creates a tetromino from a snapshot written by writeSnapshot().
+     */
+    static TetrominoPtr readSnapshot(ByteReader &reader);
+
     /* ------------------------------------------------
      *          Test Fixture Class
      * ------------------------------------------------*/
@@ -20,9 +20,9 @@
 #include "../tetromino/tetromino_shapes.hpp"
 #include "tetromino/abstract_tetromino.hpp"
 
-#include <random>
+TetrominoQueue::TetrominoQueue() : TetrominoQueue(Rng::randomSeed()) {}
 
-TetrominoQueue::TetrominoQueue() { refill(); }
+TetrominoQueue::TetrominoQueue(Seed seed) : rng_{seed} { refill(); }
 
 size_t TetrominoQueue::size() const noexcept { return queue_.size(); };
 
@@ -43,9 +43,7 @@ void TetrominoQueue::refill() {
             Tetris::createTetromino(static_cast<TetrominoShape>(i));
     }
 
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(tetrominoes.begin(), tetrominoes.end(), g);
+    rng_.shuffle(tetrominoes.begin(), tetrominoes.end());
 
     for (auto &tetromino : tetrominoes) {
         queue_.push_back(std::move(tetromino));
@@ -73,3 +71,22 @@ nlohmann::json TetrominoQueue::serialize() const {
 
     return j_queue;
 }
+
+void TetrominoQueue::writeSnapshot(ByteWriter &writer) const {
+    writer.writeU64(rng_.getState());
+    writer.writeVarint(queue_.size());
+
+    for (const TetrominoPtr &pTetromino : queue_) {
+        pTetromino->writeSnapshot(writer);
+    }
+}
+
+void TetrominoQueue::readSnapshot(ByteReader &reader) {
+    rng_.setState(reader.readU64());
+    queue_.clear();
+
+    size_t size = reader.readVarint();
+    for (size_t i = 0; i < size; i++) {
+        queue_.push_back(ATetromino::readSnapshot(reader));
+    }
+}
@@ -20,15 +20,26 @@
 
 #include <deque>
 
+#include "../rng/rng.hpp"
 #include "../tetromino/abstract_tetromino.hpp"
 
 class TetrominoQueue {
   private:
     std::deque<TetrominoPtr> queue_;
+    Rng rng_;
     static constexpr size_t NUM_SERIALIZED_TETROMINOES = 6;
 
   public:
+    /**
+     * @brief Constructs a queue shuffled from a non-deterministic seed.
+     */
     TetrominoQueue();
+
+    /**
+     * @brief Constructs a queue whose shuffles are drawn from the given seed.
+     */
+    explicit TetrominoQueue(Seed seed);
+
     TetrominoQueue(const TetrominoQueue &) = default;
     TetrominoQueue(TetrominoQueue &&) = default;
     TetrominoQueue &operator=(const TetrominoQueue &) = default;
@@ -69,6 +80,21 @@ class TetrominoQueue {
      * ------------------------------------------------*/
 
     nlohmann::json serialize() const;
+
+    /* ------------------------------------------------
+     *          Snapshot
+     * ------------------------------------------------*/
+
+    /**
+     * @brief Writes the complete queue (not only the visible tetrominoes) and
+     * the state of its random generator in binary.
+     */
+    void writeSnapshot(ByteWriter &writer) const;
+
+    /**
+     * @brief Restores a state written by writeSnapshot().
+     */
+    void readSnapshot(ByteReader &reader);
 };
 
 #endif // TETROMINO_QUEUE_HPP
@@ -18,6 +18,7 @@
 #ifndef ABSTRACT_TIMED_EFFECT_HPP
 #define ABSTRACT_TIMED_EFFECT_HPP
 
+#include <cstddef>
 #include <memory>
 
 #include <nlohmann/json.hpp>
@@ -54,6 +55,18 @@ class ATimedEffect {
      */
     virtual double getElapsedTime() const = 0;
 
+    /**
+     * @brief Returns how much of the effect's duration is left (in ticks or
+     * placements depending on the effect).
+     */
+    virtual size_t getRemainingDuration() const = 0;
+
+    /**
+     * @brief Sets how much of the effect's duration is left, e.g. when
+     * restoring a snapshot.
+     */
+    virtual void setRemainingDuration(size_t remainingDuration) = 0;
+
     /* ------------------------------------------------
      *          Serialization
      * ------------------------------------------------*/
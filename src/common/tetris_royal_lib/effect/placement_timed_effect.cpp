@@ -44,6 +44,12 @@ double PlacementTimedEffect::getElapsedTime() const {
                  / static_cast<double>(numPlacements_);
 }
 
+size_t PlacementTimedEffect::getRemainingDuration() const { return remainingPlacements_; }
+
+void PlacementTimedEffect::setRemainingDuration(size_t remainingDuration) {
+    remainingPlacements_ = remainingDuration;
+}
+
 std::ostream &operator<<(std::ostream &os,
                          const PlacementTimedEffect &placementTimedEffect) {
     os << "placementTimedEffect(" << placementTimedEffect.remainingPlacements_
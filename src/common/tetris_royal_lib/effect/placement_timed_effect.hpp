@@ -50,6 +50,10 @@ class PlacementTimedEffect : public virtual ATimedEffect {
 
     double getElapsedTime() const override;
 
+    size_t getRemainingDuration() const override;
+
+    void setRemainingDuration(size_t remainingDuration) override;
+
     /**
      * @brief Outputs the PlacementTimedEffect to a stream.
      *
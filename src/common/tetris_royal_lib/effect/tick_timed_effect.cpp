@@ -41,6 +41,12 @@ double TickTimedEffect::getElapsedTime() const {
                  / static_cast<double>(numTicks_);
 }
 
+size_t TickTimedEffect::getRemainingDuration() const { return remainingTicks_; }
+
+void TickTimedEffect::setRemainingDuration(size_t remainingDuration) {
+    remainingTicks_ = remainingDuration;
+}
+
 std::ostream &operator<<(std::ostream &os,
                          const TickTimedEffect &tickTimedEffect) {
     os << "placementTimedEffect(" << tickTimedEffect.remainingTicks_
@@ -0,0 +1,200 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "game_action.hpp"
+
+#include "../../types/overloaded.hpp"
+#include "../game_engine/game_engine.hpp"
+
+#include <stdexcept>
+
+namespace {
+
+    // default-constructs the alternative at the given index, used to
+    // deserialize the actions which don't hold any data
+    template <size_t Index = 0>
+    GameAction makeGameAction(size_t actionIndex) {
+        if constexpr (Index < std::variant_size_v<GameAction>) {
+            if (actionIndex == Index) {
+                return GameAction{std::in_place_index<Index>};
+            }
+            return makeGameAction<Index + 1>(actionIndex);
+        } else {
+            throw std::runtime_error("invalid game action type");
+        }
+    }
+
+} // namespace
+
+void applyGameAction(GameEngine &engine, UserID userID,
+                     const GameAction &gameAction) {
+    std::visit(
+        Overloaded{
+            [&](const game_action::MoveActive &action) {
+                engine.tryMoveActive(userID, action.tetrominoMove);
+            },
+            [&](const game_action::RotateActive &action) {
+                engine.tryRotateActive(userID, action.rotateClockwise);
+            },
+            [&](const game_action::BigDrop &) { engine.bigDrop(userID); },
+            [&](const game_action::HoldActiveTetromino &) {
+                engine.holdActiveTetromino(userID);
+            },
+            [&](const game_action::BuyEffect &action) {
+                engine.tryBuyEffect(userID, action.effectType,
+                                    action.stashForLater);
+            },
+            [&](const game_action::EmptyPenaltyStash &) {
+                engine.emptyPenaltyStash(userID);
+            },
+            [&](const game_action::SelectTarget &action) {
+                engine.selectTarget(userID, action.targetID);
+            },
+            [&](const game_action::QuitGame &) { engine.quitGame(userID); },
+        },
+        gameAction);
+}
+
+/* ------------------------------------------------
+ *          Serialization
+ * ------------------------------------------------*/
+
+nlohmann::json serializeGameAction(const GameAction &gameAction) {
+    nlohmann::json data = std::visit(
+        Overloaded{
+            [](const game_action::MoveActive &action) -> nlohmann::json {
+                return {{"tetrominoMove", action.tetrominoMove}};
+            },
+            [](const game_action::RotateActive &action) -> nlohmann::json {
+                return {{"rotateClockwise", action.rotateClockwise}};
+            },
+            [](const game_action::BuyEffect &action) -> nlohmann::json {
+                nlohmann::json j{{"stashForLater", action.stashForLater}};
+                if (const BonusType *pBonus =
+                        std::get_if<BonusType>(&action.effectType)) {
+                    j["bonusType"] = *pBonus;
+                } else {
+                    j["penaltyType"] = std::get<PenaltyType>(action.effectType);
+                }
+                return j;
+            },
+            [](const game_action::SelectTarget &action) -> nlohmann::json {
+                return {{"targetID", action.targetID}};
+            },
+            [](const auto &) -> nlohmann::json {
+                return nlohmann::json::object();
+            },
+        },
+        gameAction);
+
+    return nlohmann::json{{"type", gameAction.index()}, {"data", data}};
+}
+
+GameAction deserializeGameAction(const nlohmann::json &j) {
+    GameAction gameAction = makeGameAction(j.at("type").get<size_t>());
+    const nlohmann::json &data = j.at("data");
+
+    std::visit(Overloaded{
+                   [&](game_action::MoveActive &action) {
+                       action.tetrominoMove =
+                           data.at("tetrominoMove").get<TetrominoMove>();
+                   },
+                   [&](game_action::RotateActive &action) {
+                       action.rotateClockwise =
+                           data.at("rotateClockwise").get<bool>();
+                   },
+                   [&](game_action::BuyEffect &action) {
+                       action.stashForLater =
+                           data.at("stashForLater").get<bool>();
+                       if (data.contains("bonusType")) {
+                           action.effectType =
+                               data.at("bonusType").get<BonusType>();
+                       } else {
+                           action.effectType =
+                               data.at("penaltyType").get<PenaltyType>();
+                       }
+                   },
+                   [&](game_action::SelectTarget &action) {
+                       action.targetID = data.at("targetID").get<UserID>();
+                   },
+                   [](auto &) {},
+               },
+               gameAction);
+
+    return gameAction;
+}
+
+void writeGameAction(ByteWriter &writer, const GameAction &gameAction) {
+    writer.writeU8(static_cast<uint8_t>(gameAction.index()));
+
+    std::visit(
+        Overloaded{
+            [&](const game_action::MoveActive &action) {
+                writer.writeU8(static_cast<uint8_t>(action.tetrominoMove));
+            },
+            [&](const game_action::RotateActive &action) {
+                writer.writeBool(action.rotateClockwise);
+            },
+            [&](const game_action::BuyEffect &action) {
+                const BonusType *pBonus =
+                    std::get_if<BonusType>(&action.effectType);
+                writer.writeBool(pBonus == nullptr);
+                writer.writeU8(
+                    pBonus != nullptr
+                        ? static_cast<uint8_t>(*pBonus)
+                        : static_cast<uint8_t>(
+                              std::get<PenaltyType>(action.effectType)));
+                writer.writeBool(action.stashForLater);
+            },
+            [&](const game_action::SelectTarget &action) {
+                writer.writeVarint(action.targetID);
+            },
+            [](const auto &) {},
+        },
+        gameAction);
+}
+
+GameAction readGameAction(ByteReader &reader) {
+    GameAction gameAction = makeGameAction(reader.readU8());
+
+    std::visit(Overloaded{
+                   [&](game_action::MoveActive &action) {
+                       action.tetrominoMove =
+                           static_cast<TetrominoMove>(reader.readU8());
+                   },
+                   [&](game_action::RotateActive &action) {
+                       action.rotateClockwise = reader.readBool();
+                   },
+                   [&](game_action::BuyEffect &action) {
+                       bool isPenalty = reader.readBool();
+                       uint8_t effect = reader.readU8();
+                       if (isPenalty) {
+                           action.effectType = static_cast<PenaltyType>(effect);
+                       } else {
+                           action.effectType = static_cast<BonusType>(effect);
+                       }
+                       action.stashForLater = reader.readBool();
+                   },
+                   [&](game_action::SelectTarget &action) {
+                       action.targetID = reader.readVarint();
+                   },
+                   [](auto &) {},
+               },
+               gameAction);
+
+    return gameAction;
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAME_ACTION_HPP
+#define GAME_ACTION_HPP
+
+#include "../../tetris_lib/byte_stream/byte_reader.hpp"
+#include "../../tetris_lib/byte_stream/byte_writer.hpp"
+#include "../../types/types.hpp"
+#include "../effect/effect_type.hpp"
+#include "tetromino/abstract_tetromino.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <variant>
+
+class GameEngine;
+
+/**
+ * @brief The player inputs a GameEngine can receive. Each of them maps to one
+ * method of the GameEngine's public API.
+ */
+namespace game_action {
+
+    struct MoveActive {
+        TetrominoMove tetrominoMove;
+    };
+
+    struct RotateActive {
+        bool rotateClockwise;
+    };
+
+    struct BigDrop {};
+
+    struct HoldActiveTetromino {};
+
+    struct BuyEffect {
+        EffectType effectType;
+        bool stashForLater;
+    };
+
+    struct EmptyPenaltyStash {};
+
+    struct SelectTarget {
+        UserID targetID;
+    };
+
+    struct QuitGame {};
+
+} // namespace game_action
+
+/**
+ * @note The order of the alternatives is part of the serialized format, new
+ * actions must be appended at the end.
+ */
+using GameAction =
+    std::variant<game_action::MoveActive, game_action::RotateActive,
+                 game_action::BigDrop, game_action::HoldActiveTetromino,
+                 game_action::BuyEffect, game_action::EmptyPenaltyStash,
+                 game_action::SelectTarget, game_action::QuitGame>;
+
+/**
+ * @brief Applies the given action of the given player to the engine.
+ */
+void applyGameAction(GameEngine &engine, UserID userID,
+                     const GameAction &gameAction);
+
+/* ------------------------------------------------
+ *          Serialization
+ * ------------------------------------------------*/
+
+/**
+ * @brief Serializes the given GameAction to json.
+ */
+nlohmann::json serializeGameAction(const GameAction &gameAction);
+
+/**
+ * @brief Deserializes a GameAction from json.
+ *
+ * @throws nlohmann::json::exception or std::runtime_error if the json does not
+ * describe a valid action.
+ */
+GameAction deserializeGameAction(const nlohmann::json &j);
+
+/**
+ * @brief Writes the given GameAction in binary (a type byte followed by the
+ * action's parameters).
+ */
+void writeGameAction(ByteWriter &writer, const GameAction &gameAction);
+
+/**
+ * @brief Reads a GameAction written by writeGameAction().
+ *
+ * @throws std::runtime_error if the data does not describe a valid action.
+ */
+GameAction readGameAction(ByteReader &reader);
+
+#endif // GAME_ACTION_HPP
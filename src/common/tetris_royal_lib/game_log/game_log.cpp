@@ -0,0 +1,161 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "game_log.hpp"
+
+#include "../player_state/player_state.hpp"
+#include "byte_stream/byte_writer.hpp"
+
+#include <algorithm>
+#include <memory>
+
+// --- private ---
+
+uint64_t GameLog::getElapsedMs() const {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime_)
+            .count());
+}
+
+// --- public ---
+
+GameLog::GameLog(GameMode gameMode, Seed seed,
+                 std::vector<GameLogPlayer> &&players, size_t keyframeInterval)
+    : gameMode_{gameMode}, seed_{seed},
+      keyframeInterval_{std::max<size_t>(keyframeInterval, 1)},
+      players_{std::move(players)},
+      startTime_{std::chrono::steady_clock::now()} {}
+
+GameStatePtr
+GameLog::createGameState(GameMode gameMode, Seed seed,
+                         const std::vector<GameLogPlayer> &players) {
+    std::vector<PlayerState> playerStates;
+    playerStates.reserve(players.size());
+
+    for (const GameLogPlayer &player : players) {
+        playerStates.emplace_back(player.userID, player.username);
+    }
+
+    return std::make_shared<GameState>(gameMode, std::move(playerStates), seed);
+}
+
+GameStatePtr GameLog::createInitialGameState() const {
+    return createGameState(gameMode_, seed_, players_);
+}
+
+// #### Recording ####
+
+void GameLog::recordAction(UserID userID, const GameAction &gameAction) {
+    entries_.push_back(
+        GameLogEntry{getNumTicks(), getElapsedMs(), userID, gameAction});
+}
+
+void GameLog::recordTick(const GameState &gameState) {
+    tickTimestampsMs_.push_back(getElapsedMs());
+
+    if (getNumTicks() % keyframeInterval_ == 0) {
+        ByteWriter writer;
+        gameState.writeSnapshot(writer);
+        keyframes_.push_back(
+            GameLogKeyframe{getNumTicks(), entries_.size(), writer.release()});
+    }
+}
+
+// #### Getters ####
+
+GameMode GameLog::getGameMode() const { return gameMode_; }
+
+Seed GameLog::getSeed() const { return seed_; }
+
+const std::vector<GameLogPlayer> &GameLog::getPlayers() const {
+    return players_;
+}
+
+const std::vector<GameLogEntry> &GameLog::getEntries() const {
+    return entries_;
+}
+
+size_t GameLog::getKeyframeInterval() const { return keyframeInterval_; }
+
+const std::vector<GameLogKeyframe> &GameLog::getKeyframes() const {
+    return keyframes_;
+}
+
+size_t GameLog::getNumTicks() const { return tickTimestampsMs_.size(); }
+
+uint64_t GameLog::getTickTimestampMs(size_t tick) const {
+    return tick == 0 ? 0 : tickTimestampsMs_.at(tick - 1);
+}
+
+/* ------------------------------------------------
+ *          Serialization
+ * ------------------------------------------------*/
+
+nlohmann::json GameLog::serialize() const {
+    nlohmann::json j_players = nlohmann::json::array();
+    for (const GameLogPlayer &player : players_) {
+        j_players.push_back(
+            {{"userID", player.userID}, {"username", player.username}});
+    }
+
+    nlohmann::json j_entries = nlohmann::json::array();
+    for (const GameLogEntry &entry : entries_) {
+        j_entries.push_back({
+            {"tick", entry.tick},
+            {"timestampMs", entry.timestampMs},
+            {"userID", entry.userID},
+            {"action", serializeGameAction(entry.action)},
+        });
+    }
+
+    return nlohmann::json{
+        {"gameMode", gameMode_},
+        {"seed", seed_},
+        {"keyframeInterval", keyframeInterval_},
+        {"players", j_players},
+        {"entries", j_entries},
+        {"tickTimestampsMs", tickTimestampsMs_},
+    };
+}
+
+GameLog GameLog::deserialize(const nlohmann::json &j) {
+    std::vector<GameLogPlayer> players;
+    for (const nlohmann::json &j_player : j.at("players")) {
+        players.push_back(
+            GameLogPlayer{j_player.at("userID").get<UserID>(),
+                          j_player.at("username").get<std::string>()});
+    }
+
+    GameLog gameLog{j.at("gameMode").get<GameMode>(), j.at("seed").get<Seed>(),
+                    std::move(players),
+                    j.value("keyframeInterval", DEFAULT_KEYFRAME_INTERVAL)};
+
+    for (const nlohmann::json &j_entry : j.at("entries")) {
+        gameLog.entries_.push_back(GameLogEntry{
+            j_entry.at("tick").get<size_t>(),
+            j_entry.at("timestampMs").get<uint64_t>(),
+            j_entry.at("userID").get<UserID>(),
+            deserializeGameAction(j_entry.at("action")),
+        });
+    }
+
+    gameLog.tickTimestampsMs_ =
+        j.at("tickTimestampsMs").get<std::vector<uint64_t>>();
+
+    return gameLog;
+}
@@ -0,0 +1,167 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAME_LOG_HPP
+#define GAME_LOG_HPP
+
+#include "../../types/types.hpp"
+#include "../game_mode/game_mode.hpp"
+#include "../game_state/game_state.hpp"
+#include "game_action.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A player taking part in a logged game.
+ */
+struct GameLogPlayer {
+    UserID userID;
+    std::string username;
+};
+
+/**
+ * @brief An action received by the game, stamped with the number of engine
+ * ticks elapsed before it was applied and the milliseconds elapsed since the
+ * start of the game.
+ */
+struct GameLogEntry {
+    size_t tick;
+    uint64_t timestampMs;
+    UserID userID;
+    GameAction action;
+};
+
+/**
+ * @brief A full snapshot of the GameState (see GameState::writeSnapshot()),
+ * taken right after the engine's tick-th tick, before the actions stamped with
+ * that tick were applied.
+ */
+struct GameLogKeyframe {
+    size_t tick;
+    // number of entries applied before the snapshot was taken
+    size_t entryIdx;
+    std::vector<uint8_t> snapshot;
+};
+
+/**
+ * @class GameLog
+ *
+ * @brief Event log of a game: its initial parameters (mode, players, seed)
+ * followed by every action applied to its engine, in order.
+ *
+ * As the whole game is determined by its seed, replaying the entries on top of
+ * createInitialGameState() rebuilds the exact same GameState at any tick (see
+ * GameReplayer). Keyframes are recorded every keyframeInterval ticks so that
+ * a replay doesn't need to be re-simulated from the start to be seeked.
+ */
+class GameLog {
+  public:
+    static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 60;
+
+  private:
+    GameMode gameMode_;
+    Seed seed_;
+    size_t keyframeInterval_;
+    std::vector<GameLogPlayer> players_;
+    std::vector<GameLogEntry> entries_;
+    std::vector<uint64_t> tickTimestampsMs_;
+    std::vector<GameLogKeyframe> keyframes_;
+
+    std::chrono::steady_clock::time_point startTime_;
+
+    uint64_t getElapsedMs() const;
+
+  public:
+    GameLog(GameMode gameMode, Seed seed, std::vector<GameLogPlayer> &&players,
+            size_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+    GameLog(const GameLog &) = default;
+    GameLog(GameLog &&) = default;
+    GameLog &operator=(const GameLog &) = default;
+    GameLog &operator=(GameLog &&) = default;
+
+    ~GameLog() = default;
+
+    /**
+     * @brief Creates the GameState a game with the given parameters starts
+     * from.
+     */
+    static GameStatePtr createGameState(GameMode gameMode, Seed seed,
+                                        const std::vector<GameLogPlayer> &players);
+
+    /**
+     * @brief Creates the GameState the logged game started from.
+     */
+    GameStatePtr createInitialGameState() const;
+
+    // #### Recording ####
+
+    /**
+     * @brief Appends the given action, stamped with the current tick.
+     */
+    void recordAction(UserID userID, const GameAction &gameAction);
+
+    /**
+     * @brief Records that the engine ticked, and takes a keyframe of the
+     * given (ticked) GameState every keyframeInterval ticks.
+     */
+    void recordTick(const GameState &gameState);
+
+    // #### Getters ####
+
+    GameMode getGameMode() const;
+
+    Seed getSeed() const;
+
+    const std::vector<GameLogPlayer> &getPlayers() const;
+
+    const std::vector<GameLogEntry> &getEntries() const;
+
+    size_t getKeyframeInterval() const;
+
+    const std::vector<GameLogKeyframe> &getKeyframes() const;
+
+    /**
+     * @brief Returns how many times the engine ticked.
+     */
+    size_t getNumTicks() const;
+
+    /**
+     * @brief Returns the timestamp (in milliseconds since the start of the
+     * game) at which the engine ticked for the nth time (n >= 1).
+     */
+    uint64_t getTickTimestampMs(size_t tick) const;
+
+    /* ------------------------------------------------
+     *          Serialization
+     * ------------------------------------------------*/
+
+    /**
+     * @brief Serializes the log to json, without its keyframes (which can be
+     * rebuilt by replaying it). See ReplayWriter for the compact binary
+     * format.
+     */
+    nlohmann::json serialize() const;
+
+    static GameLog deserialize(const nlohmann::json &j);
+};
+
+#endif // GAME_LOG_HPP
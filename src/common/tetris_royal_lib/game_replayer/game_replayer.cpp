@@ -0,0 +1,157 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "game_replayer.hpp"
+
+#include "../replay/replay_writer.hpp"
+#include "byte_stream/byte_reader.hpp"
+
+#include <stdexcept>
+
+// --- private ---
+
+void GameReplayer::loadKeyframe(const std::optional<ReplayKeyframe> &keyframe) {
+    pGameState_ = reader_.createInitialGameState();
+
+    if (keyframe.has_value()) {
+        ByteReader snapshotReader{keyframe->snapshot};
+        pGameState_->readSnapshot(snapshotReader);
+
+        currentTick_ = keyframe->tick;
+        streamPos_ = keyframe->streamOffset;
+        timestampMs_ = keyframe->timestampMs;
+    } else {
+        currentTick_ = 0;
+        streamPos_ = reader_.getStreamBegin();
+        timestampMs_ = 0;
+    }
+
+    engine_ = GameEngine{pGameState_};
+
+    applyCurrentTickActions();
+}
+
+void GameReplayer::applyCurrentTickActions() {
+    while (streamPos_ < reader_.getStreamEnd()) {
+        size_t pos = streamPos_;
+        uint64_t timestampMs = timestampMs_;
+        const ReplayEvent event = reader_.readEvent(pos, timestampMs);
+
+        if (event.type == ReplayEvent::Type::Tick) {
+            break;
+        }
+
+        applyGameAction(engine_, event.userID, event.action);
+        streamPos_ = pos;
+        timestampMs_ = timestampMs;
+    }
+
+    if (isFinished() && engine_.gameIsFinished()) {
+        pGameState_->setIsFinished();
+    }
+}
+
+std::optional<uint64_t> GameReplayer::peekNextTickTimestampMs() const {
+    if (currentTick_ >= reader_.getNumTicks()) {
+        return std::nullopt;
+    }
+
+    size_t pos = streamPos_;
+    uint64_t timestampMs = timestampMs_;
+
+    return reader_.readEvent(pos, timestampMs).timestampMs;
+}
+
+// --- public ---
+
+GameReplayer::GameReplayer(ReplayReader &&reader)
+    : reader_{std::move(reader)},
+      pGameState_{reader_.createInitialGameState()}, engine_{pGameState_},
+      currentTick_{0}, streamPos_{reader_.getStreamBegin()}, timestampMs_{0} {
+    applyCurrentTickActions();
+}
+
+GameReplayer::GameReplayer(const GameLog &gameLog)
+    : GameReplayer{ReplayReader{encodeReplay(gameLog)}} {}
+
+void GameReplayer::restart() { loadKeyframe(std::nullopt); }
+
+bool GameReplayer::stepTick() {
+    if (currentTick_ >= reader_.getNumTicks()) {
+        return false;
+    }
+
+    const ReplayEvent event = reader_.readEvent(streamPos_, timestampMs_);
+    if (event.type != ReplayEvent::Type::Tick) {
+        throw std::runtime_error{"Replay input stream out of sync"};
+    }
+
+    engine_.tick();
+    currentTick_++;
+
+    applyCurrentTickActions();
+
+    return true;
+}
+
+void GameReplayer::seekTick(size_t tick) {
+    const std::optional<ReplayKeyframe> keyframe = reader_.findKeyframe(tick);
+
+    if (tick < currentTick_
+        || (keyframe.has_value() && keyframe->tick > currentTick_)) {
+        loadKeyframe(keyframe);
+    }
+
+    while (currentTick_ < tick && stepTick()) {
+    }
+}
+
+void GameReplayer::advanceTo(uint64_t timestampMs) {
+    std::optional<uint64_t> nextTickTimestampMs;
+
+    while ((nextTickTimestampMs = peekNextTickTimestampMs()).has_value()
+           && *nextTickTimestampMs <= timestampMs) {
+        stepTick();
+    }
+}
+
+void GameReplayer::seekTimestamp(uint64_t timestampMs) {
+    const std::optional<ReplayKeyframe> keyframe =
+        reader_.findKeyframeByTimestamp(timestampMs);
+
+    if (timestampMs < timestampMs_
+        || (keyframe.has_value() && keyframe->tick > currentTick_)) {
+        loadKeyframe(keyframe);
+    }
+
+    advanceTo(timestampMs);
+}
+
+// #### Getters ####
+
+const ReplayReader &GameReplayer::getReader() const { return reader_; }
+
+size_t GameReplayer::getCurrentTick() const { return currentTick_; }
+
+uint64_t GameReplayer::getTimestampMs() const { return timestampMs_; }
+
+bool GameReplayer::isFinished() const {
+    return currentTick_ >= reader_.getNumTicks()
+           && streamPos_ >= reader_.getStreamEnd();
+}
+
+GameStatePtr GameReplayer::getGameState() const { return pGameState_; }
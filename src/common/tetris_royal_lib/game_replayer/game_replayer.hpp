@@ -0,0 +1,137 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAME_REPLAYER_HPP
+#define GAME_REPLAYER_HPP
+
+#include "../game_engine/game_engine.hpp"
+#include "../game_log/game_log.hpp"
+#include "../game_state/game_state.hpp"
+#include "../replay/replay_reader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @class GameReplayer
+ *
+ * @brief Headless re-simulation of a recorded game: rebuilds the GameState the
+ * game had at any tick by replaying its input stream on a GameEngine.
+ *
+ * The state "at tick t" is the state after t engine ticks and every action the
+ * game received before its (t + 1)th tick. Seeking restores the closest
+ * keyframe at or before the target tick and only re-simulates from there.
+ */
+class GameReplayer {
+  private:
+    ReplayReader reader_;
+
+    GameStatePtr pGameState_;
+    GameEngine engine_;
+
+    size_t currentTick_;
+    size_t streamPos_;
+    uint64_t timestampMs_;
+
+    /**
+     * @brief Resets the replay to the given keyframe, or to the start of the
+     * game if nullopt.
+     */
+    void loadKeyframe(const std::optional<ReplayKeyframe> &keyframe);
+
+    /**
+     * @brief Applies the recorded actions up to the next tick record.
+     */
+    void applyCurrentTickActions();
+
+    /**
+     * @brief Returns the timestamp of the next tick record, nullopt at the end
+     * of the replay.
+     */
+    std::optional<uint64_t> peekNextTickTimestampMs() const;
+
+  public:
+    explicit GameReplayer(ReplayReader &&reader);
+
+    /**
+     * @brief Replays a log that was just recorded (encodes it first, see
+     * encodeReplay()).
+     */
+    explicit GameReplayer(const GameLog &gameLog);
+    GameReplayer(const GameReplayer &) = delete;
+    GameReplayer(GameReplayer &&) = default;
+    GameReplayer &operator=(const GameReplayer &) = delete;
+    GameReplayer &operator=(GameReplayer &&) = default;
+
+    ~GameReplayer() = default;
+
+    /**
+     * @brief Goes back to the state at tick 0.
+     */
+    void restart();
+
+    /**
+     * @brief Advances the replay by one tick.
+     *
+     * @return False if the end of the replay was already reached.
+     */
+    bool stepTick();
+
+    /**
+     * @brief Moves the replay to the given tick (clamped to the number of
+     * recorded ticks).
+     */
+    void seekTick(size_t tick);
+
+    /**
+     * @brief Replays every tick recorded at or before the given time (in
+     * milliseconds since the start of the game). Never goes backwards.
+     */
+    void advanceTo(uint64_t timestampMs);
+
+    /**
+     * @brief Moves the replay to the last tick recorded at or before the given
+     * time, in either direction.
+     */
+    void seekTimestamp(uint64_t timestampMs);
+
+    // #### Getters ####
+
+    const ReplayReader &getReader() const;
+
+    size_t getCurrentTick() const;
+
+    /**
+     * @brief Returns the time of the last replayed record, in milliseconds
+     * since the start of the game.
+     */
+    uint64_t getTimestampMs() const;
+
+    /**
+     * @brief Returns true once the last recorded tick was replayed.
+     */
+    bool isFinished() const;
+
+    /**
+     * @brief Returns the replayed GameState. The pointer is replaced when
+     * seeking, callers shouldn't keep it around.
+     */
+    GameStatePtr getGameState() const;
+};
+
+#endif // GAME_REPLAYER_HPP
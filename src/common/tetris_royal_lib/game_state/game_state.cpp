@@ -26,10 +26,12 @@
 
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <vector>
 
-GameState::GameState(GameMode gameMode, std::vector<PlayerState> &&playerStates)
-    : isFinished_{false}, gameMode_{gameMode} {
+GameState::GameState(GameMode gameMode, std::vector<PlayerState> &&playerStates,
+                     Seed seed)
+    : isFinished_{false}, gameMode_{gameMode}, seed_{seed} {
 
     size_t numPlayers = playerStates.size();
     for (size_t i = 0; i < playerStates.size(); i++) {
@@ -43,12 +45,17 @@ GameState::GameState(GameMode gameMode, std::vector<PlayerState> &&playerStates)
 
         userToPlayerTetris_.emplace(
             playerState.getUserID(),
-            PlayerTetris{std::make_shared<PlayerState>(playerState)});
+            PlayerTetris{std::make_shared<PlayerState>(playerState),
+                         Rng::deriveSeed(seed, playerState.getUserID())});
     }
 }
 
 GameMode GameState::getGameMode() const { return gameMode_; }
 
+Seed GameState::getSeed() const { return seed_; }
+
+bool GameState::getIsFinished() const { return isFinished_; }
+
 std::optional<UserID> GameState::getWinner() const {
     if (gameMode_ == GameMode::Endless) {
         // There can't be any winner in Endless mode
@@ -87,6 +94,11 @@ std::map<UserID, PlayerTetris> &GameState::getUserToPlayerTetris() {
     return userToPlayerTetris_;
 }
 
+const std::map<UserID, PlayerTetris> &
+GameState::getUserToPlayerTetris() const {
+    return userToPlayerTetris_;
+}
+
 void GameState::setIsFinished(bool isFinished) { isFinished_ = isFinished; }
 
 /* ------------------------------------------------
@@ -107,11 +119,17 @@ nlohmann::json GameState::serializeForPlayer(UserID userID) const {
         }
     }
 
+    serializeEffectPrices(gameMode_, j);
+
+    return j;
+}
+
+void GameState::serializeEffectPrices(GameMode gameMode, nlohmann::json &j) {
     // add the effects that the players can buy with their price
     j["bonusToPrice"] = nlohmann::json::array();
     j["penaltyToPrice"] = nlohmann::json::array();
 
-    if (GameEngine::checkFeatureEnabled(gameMode_,
+    if (GameEngine::checkFeatureEnabled(gameMode,
                                         GameEngine::GameModeFeature::Effects)) {
         // bonuses
         for (size_t i = 0; i < static_cast<size_t>(BonusType::NumBonusType);
@@ -127,8 +145,6 @@ nlohmann::json GameState::serializeForPlayer(UserID userID) const {
                 {penaltyType, getEffectPrice(penaltyType)});
         }
     }
-
-    return j;
 }
 
 nlohmann::json GameState::serializeForViewer() const {
@@ -145,3 +161,56 @@ nlohmann::json GameState::serializeForViewer() const {
 
     return j;
 }
+
+/* ------------------------------------------------
+ *          Snapshot
+ * ------------------------------------------------*/
+
+void GameState::writeSnapshot(ByteWriter &writer) const {
+    writer.writeBool(isFinished_);
+    writer.writeVarint(userToPlayerTetris_.size());
+
+    for (const auto &[userID, playerTetris] : userToPlayerTetris_) {
+        writer.writeVarint(userID);
+        playerTetris.pPlayerState->writeSnapshot(writer);
+        playerTetris.pTetris->writeSnapshot(writer);
+    }
+}
+
+uint64_t GameState::computeHash() const {
+    constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+    constexpr uint64_t FNV_PRIME = 0x100000001b3;
+
+    ByteWriter writer;
+    for (const auto &[userID, playerTetris] : userToPlayerTetris_) {
+        writer.writeVarint(userID);
+        playerTetris.pPlayerState->writeSnapshot(writer);
+        playerTetris.pTetris->writeSnapshot(writer);
+    }
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (uint8_t byte : writer.getBytes()) {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+void GameState::readSnapshot(ByteReader &reader) {
+    isFinished_ = reader.readBool();
+
+    if (reader.readVarint() != userToPlayerTetris_.size()) {
+        throw std::runtime_error("snapshot doesn't match the game's players");
+    }
+
+    for (size_t i = 0; i < userToPlayerTetris_.size(); i++) {
+        auto it = userToPlayerTetris_.find(reader.readVarint());
+        if (it == userToPlayerTetris_.end()) {
+            throw std::runtime_error("snapshot doesn't match the game's players");
+        }
+
+        it->second.pPlayerState->readSnapshot(reader);
+        it->second.pTetris->readSnapshot(reader);
+    }
+}
@@ -21,10 +21,12 @@
 #include "../game_mode/game_mode.hpp"
 #include "../player_state/player_state.hpp"
 #include "../player_tetris/player_tetris.hpp"
+#include "rng/rng.hpp"
 #include "tetris/tetris.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -32,14 +34,21 @@ class GameState {
   private:
     bool isFinished_;
     const GameMode gameMode_;
+    const Seed seed_;
     std::map<UserID, PlayerTetris> userToPlayerTetris_;
 
   public:
     /**
      * @brief Constructs a GameState object with given game-mode.
      * @param gameMode The game-mode
+     * @param playerStates The players, in the order used to assign their
+     * initial penalty target.
+     * @param seed The seed every random event of the game derives from: two
+     * games created with the same arguments evolve identically when given the
+     * same inputs.
      */
-    GameState(GameMode gameMode, std::vector<PlayerState> &&playerStates);
+    GameState(GameMode gameMode, std::vector<PlayerState> &&playerStates,
+              Seed seed = Rng::randomSeed());
     GameState(const GameState &) = default;
     GameState(GameState &&) = default;
     GameState &operator=(const GameState &) = delete;
@@ -52,6 +61,16 @@ class GameState {
      */
     GameMode getGameMode() const;
 
+    /**
+     * @brief Returns the seed the game was created with.
+     */
+    Seed getSeed() const;
+
+    /**
+     * @brief Returns the `isFinished_` flag (see setIsFinished()).
+     */
+    bool getIsFinished() const;
+
     /**
      * @brief Returns the winner if there's one, nullopt otherwise.
      */
@@ -81,6 +100,7 @@ class GameState {
      * @brief Returns the user to playerTetris map.
      */
     std::map<UserID, PlayerTetris> &getUserToPlayerTetris();
+    const std::map<UserID, PlayerTetris> &getUserToPlayerTetris() const;
 
     /**
      * @brief Sets the `isFinished_` flag to the specified value.
@@ -111,6 +131,38 @@ class GameState {
      * excluding all secret information specific to the player themself.
      */
     nlohmann::json serializeForViewer() const;
+
+    /**
+     * @brief Adds the prices of the effects the players can buy in the given
+     * GameMode to the given serialized GameState ("bonusToPrice" and
+     * "penaltyToPrice", empty without effects).
+     */
+    static void serializeEffectPrices(GameMode gameMode, nlohmann::json &j);
+
+    /* ------------------------------------------------
+     *          Snapshot
+     * ------------------------------------------------*/
+
+    /**
+     * @brief Writes the complete state of the game (every player's state and
+     * Tetris) in binary.
+     */
+    void writeSnapshot(ByteWriter &writer) const;
+
+    /**
+     * @brief Restores a state written by writeSnapshot() on a GameState
+     * created with the same players.
+     */
+    void readSnapshot(ByteReader &reader);
+
+    /**
+     * @brief Returns a (FNV-1a) hash of the players' snapshots, used to check
+     * that two simulations of the same game didn't diverge.
+     *
+     * @note The finished flag isn't part of the hash as it is set by whoever
+     * manages the GameState, not by the simulation.
+     */
+    uint64_t computeHash() const;
 };
 
 using GameStatePtr = std::shared_ptr<GameState>;
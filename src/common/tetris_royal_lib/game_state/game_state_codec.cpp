@@ -0,0 +1,640 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "game_state_codec.hpp"
+
+#include "board/board.hpp"
+#include "byte_stream/byte_reader.hpp"
+#include "byte_stream/byte_writer.hpp"
+#include "game_mode/game_mode.hpp"
+#include "game_state.hpp"
+#include "tetromino/abstract_tetromino.hpp"
+#include "tetromino/tetromino_shapes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+    enum GameStateFlag : uint8_t {
+        IsFinished = 1 << 0,
+        HasSelf = 1 << 1,
+    };
+
+    // a board cell is 0 when empty, colorId + 1 otherwise
+    constexpr uint8_t CELL_BITS = 4;
+    constexpr uint8_t CELL_MASK = (1 << CELL_BITS) - 1;
+    constexpr size_t PACKED_ROW_SIZE = (Board::getWidth() + 1) / 2;
+
+    static_assert(PENALTY_BLOCKS_COLOR_ID + 1 <= CELL_MASK,
+                  "the colorIds must fit in a board cell");
+
+    // effects' elapsed time (a proportion) as a 16 bits fixed-point value
+    constexpr double ELAPSED_TIME_SCALE = 0xFFFF;
+
+    // delta flags of the self Tetris
+    enum TetrisDeltaFlag : uint8_t {
+        ActiveTetromino = 1 << 0,
+        PreviewTetromino = 1 << 1,
+        HoldTetromino = 1 << 2,
+        TetrominoQueue = 1 << 3,
+    };
+
+    // #### Encoding ####
+
+    /**
+     * @brief Returns the "self" of the given serialized GameState, null for a
+     * viewer.
+     */
+    const nlohmann::json &getSelf(const nlohmann::json &j_gameState) {
+        static const nlohmann::json J_NO_SELF;
+
+        auto it = j_gameState.find("self");
+        return it != j_gameState.end() ? *it : J_NO_SELF;
+    }
+
+    uint8_t getCell(const nlohmann::json &j_row, size_t xCol) {
+        const nlohmann::json &j_colorId = j_row.at(xCol).at("colorId");
+        return j_colorId.is_null()
+                   ? 0
+                   : static_cast<uint8_t>(j_colorId.get<unsigned>() + 1);
+    }
+
+    void encodeRow(ByteWriter &writer, const nlohmann::json &j_row) {
+        std::array<uint8_t, PACKED_ROW_SIZE> packedRow{};
+        for (size_t xCol = 0; xCol < Board::getWidth(); ++xCol) {
+            packedRow.at(xCol / 2) |= getCell(j_row, xCol)
+                                      << (CELL_BITS * (xCol % 2));
+        }
+        writer.writeBytes(packedRow);
+    }
+
+    void encodeBoard(ByteWriter &writer, const nlohmann::json &j_board) {
+        auto isEmptyRow = [&j_board](size_t yRow) {
+            for (size_t xCol = 0; xCol < Board::getWidth(); ++xCol) {
+                if (getCell(j_board.at(yRow), xCol) != 0) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        // [number of empty rows][packed row] ... until the top of the board
+        size_t yRow = 0;
+        while (yRow < Board::getHeight()) {
+            size_t numEmptyRows = 0;
+            while (yRow < Board::getHeight() && isEmptyRow(yRow)) {
+                ++numEmptyRows;
+                ++yRow;
+            }
+            writer.writeVarint(numEmptyRows);
+
+            if (yRow == Board::getHeight()) {
+                break;
+            }
+
+            encodeRow(writer, j_board.at(yRow));
+            ++yRow;
+        }
+    }
+
+    void encodeTetromino(ByteWriter &writer,
+                         const nlohmann::json &j_tetromino) {
+        if (j_tetromino.is_null()) {
+            writer.writeU8(0);
+            return;
+        }
+
+        writer.writeU8(
+            static_cast<uint8_t>(j_tetromino.at("colorId").get<unsigned>() + 1));
+        writer.writeU8(j_tetromino.at("rotationIdx").get<uint8_t>());
+        writer.writeSignedVarint(
+            j_tetromino.at("anchorPoint").at("x").get<int>());
+        writer.writeSignedVarint(
+            j_tetromino.at("anchorPoint").at("y").get<int>());
+    }
+
+    void encodeTimedEffect(ByteWriter &writer, const nlohmann::json &j_effect,
+                           const char *typeField) {
+        if (j_effect.is_null()) {
+            writer.writeU8(0);
+            return;
+        }
+
+        writer.writeU8(
+            static_cast<uint8_t>(j_effect.at(typeField).get<unsigned>() + 1));
+
+        const double elapsedTime =
+            std::clamp(j_effect.at("elapsedTime").get<double>(), 0.0, 1.0);
+        writer.writeU16(
+            static_cast<uint16_t>(std::lround(elapsedTime * ELAPSED_TIME_SCALE)));
+    }
+
+    void encodeOptionalVarint(ByteWriter &writer, const nlohmann::json &j) {
+        writer.writeOptionalVarint(
+            j.is_null() ? std::nullopt
+                        : std::make_optional(j.get<uint64_t>()));
+    }
+
+    void encodePlayerStateExternal(ByteWriter &writer,
+                                   const nlohmann::json &j_playerState) {
+        writer.writeVarint(j_playerState.at("playerID").get<uint64_t>());
+        writer.writeVarint(j_playerState.at("score").get<uint64_t>());
+        writer.writeBool(j_playerState.at("isAlive").get<bool>());
+        writer.writeString(
+            j_playerState.at("username").get_ref<const std::string &>());
+    }
+
+    void encodePlayerStateSelf(ByteWriter &writer,
+                               const nlohmann::json &j_playerState) {
+        encodePlayerStateExternal(writer, j_playerState);
+
+        encodeOptionalVarint(writer, j_playerState.at("penaltyTarget"));
+        encodeOptionalVarint(writer, j_playerState.at("energy"));
+
+        const nlohmann::json &j_stashedPenalties =
+            j_playerState.at("stashedPenalties");
+        writer.writeVarint(j_stashedPenalties.size());
+        for (const nlohmann::json &j_penalty : j_stashedPenalties) {
+            writer.writeU8(j_penalty.get<uint8_t>());
+        }
+
+        encodeTimedEffect(writer, j_playerState.at("activeBonus"), "bonusType");
+        encodeTimedEffect(writer, j_playerState.at("activePenalty"),
+                          "penaltyType");
+    }
+
+    void encodeTetrominoQueue(ByteWriter &writer,
+                              const nlohmann::json &j_tetrominoQueue) {
+        writer.writeVarint(j_tetrominoQueue.size());
+        for (const nlohmann::json &j_tetromino : j_tetrominoQueue) {
+            encodeTetromino(writer, j_tetromino);
+        }
+    }
+
+    void encodeTetrisSelf(ByteWriter &writer, const nlohmann::json &j_tetris) {
+        encodeTetromino(writer, j_tetris.at("activeTetromino"));
+        encodeTetromino(writer, j_tetris.at("previewTetromino"));
+        encodeTetromino(writer, j_tetris.at("holdTetromino"));
+        encodeTetrominoQueue(writer, j_tetris.at("tetrominoQueue"));
+        encodeBoard(writer, j_tetris.at("board"));
+    }
+
+    /**
+     * @brief Writes the rows of the board that changed since the base.
+     */
+    void encodeBoardDelta(ByteWriter &writer, const nlohmann::json &j_base,
+                          const nlohmann::json &j_board) {
+        std::vector<size_t> changedRows;
+        for (size_t yRow = 0; yRow < Board::getHeight(); ++yRow) {
+            if (j_board.at(yRow) != j_base.at(yRow)) {
+                changedRows.push_back(yRow);
+            }
+        }
+
+        writer.writeVarint(changedRows.size());
+        for (size_t yRow : changedRows) {
+            writer.writeU8(static_cast<uint8_t>(yRow));
+            encodeRow(writer, j_board.at(yRow));
+        }
+    }
+
+    /**
+     * @brief Writes a bool telling whether the value changed since the base,
+     * followed by the value if it did.
+     */
+    template <typename Encoder>
+    void encodeIfChanged(ByteWriter &writer, const nlohmann::json &j_base,
+                         const nlohmann::json &j, Encoder encoder) {
+        const bool hasChanged = j != j_base;
+        writer.writeBool(hasChanged);
+        if (hasChanged) {
+            encoder(writer, j);
+        }
+    }
+
+    void encodeTetrisSelfDelta(ByteWriter &writer, const nlohmann::json &j_base,
+                               const nlohmann::json &j_tetris) {
+        constexpr std::array<std::pair<TetrisDeltaFlag, const char *>, 3>
+            tetrominoFields = {{
+                {TetrisDeltaFlag::ActiveTetromino, "activeTetromino"},
+                {TetrisDeltaFlag::PreviewTetromino, "previewTetromino"},
+                {TetrisDeltaFlag::HoldTetromino, "holdTetromino"},
+            }};
+
+        uint8_t flags = 0;
+        for (const auto &[flag, field] : tetrominoFields) {
+            if (j_tetris.at(field) != j_base.at(field)) {
+                flags |= flag;
+            }
+        }
+        if (j_tetris.at("tetrominoQueue") != j_base.at("tetrominoQueue")) {
+            flags |= TetrisDeltaFlag::TetrominoQueue;
+        }
+
+        writer.writeU8(flags);
+        for (const auto &[flag, field] : tetrominoFields) {
+            if (flags & flag) {
+                encodeTetromino(writer, j_tetris.at(field));
+            }
+        }
+        if (flags & TetrisDeltaFlag::TetrominoQueue) {
+            encodeTetrominoQueue(writer, j_tetris.at("tetrominoQueue"));
+        }
+
+        encodeBoardDelta(writer, j_base.at("board"), j_tetris.at("board"));
+    }
+
+    // #### Decoding ####
+
+    nlohmann::json decodeRow(ByteReader &reader) {
+        std::span<const uint8_t> packedRow = reader.readBytes(PACKED_ROW_SIZE);
+
+        nlohmann::json j_row = nlohmann::json::array();
+        for (size_t xCol = 0; xCol < Board::getWidth(); ++xCol) {
+            const uint8_t cell =
+                (packedRow[xCol / 2] >> (CELL_BITS * (xCol % 2))) & CELL_MASK;
+            j_row.push_back(cell == 0
+                                ? nlohmann::json{{"colorId", nullptr}}
+                                : nlohmann::json{{"colorId", cell - 1}});
+        }
+
+        return j_row;
+    }
+
+    nlohmann::json decodeBoard(ByteReader &reader) {
+        nlohmann::json j_emptyRow = nlohmann::json::array();
+        for (size_t xCol = 0; xCol < Board::getWidth(); ++xCol) {
+            j_emptyRow.push_back(nlohmann::json{{"colorId", nullptr}});
+        }
+
+        nlohmann::json j_board = nlohmann::json::array();
+        while (j_board.size() < Board::getHeight()) {
+            const uint64_t numEmptyRows = reader.readVarint();
+            if (numEmptyRows > Board::getHeight() - j_board.size()) {
+                throw std::runtime_error("too many rows in encoded board");
+            }
+
+            for (uint64_t i = 0; i < numEmptyRows; ++i) {
+                j_board.push_back(j_emptyRow);
+            }
+
+            if (j_board.size() == Board::getHeight()) {
+                break;
+            }
+
+            j_board.push_back(decodeRow(reader));
+        }
+
+        return j_board;
+    }
+
+    nlohmann::json decodeTetromino(ByteReader &reader) {
+        const uint8_t shape = reader.readU8();
+        if (shape == 0) {
+            return nullptr;
+        }
+
+        const size_t rotationIdx = reader.readU8() % ATetromino::NUM_ROTATIONS;
+        const int x = static_cast<int>(reader.readSignedVarint());
+        const int y = static_cast<int>(reader.readSignedVarint());
+
+        if (shape - 1 >= static_cast<int>(TetrominoShape::NumTetrominoShape)) {
+            throw std::runtime_error("invalid tetromino shape");
+        }
+
+        TetrominoPtr pTetromino = ATetromino::makeTetromino(
+            static_cast<TetrominoShape>(shape - 1), Vec2{x, y});
+        if (pTetromino == nullptr) {
+            throw std::runtime_error("invalid tetromino shape");
+        }
+
+        while (static_cast<size_t>(pTetromino->getRotationIndex())
+               != rotationIdx) {
+            pTetromino->rotate(true);
+        }
+
+        return pTetromino->serialize();
+    }
+
+    nlohmann::json decodeTimedEffect(ByteReader &reader,
+                                     const char *typeField) {
+        const uint8_t type = reader.readU8();
+        if (type == 0) {
+            return nullptr;
+        }
+
+        return {{typeField, type - 1},
+                {"elapsedTime", reader.readU16() / ELAPSED_TIME_SCALE}};
+    }
+
+    nlohmann::json decodeOptionalVarint(ByteReader &reader) {
+        std::optional<uint64_t> value = reader.readOptionalVarint();
+        return value.has_value() ? nlohmann::json(*value) : nullptr;
+    }
+
+    nlohmann::json decodePlayerStateExternal(ByteReader &reader) {
+        nlohmann::json j;
+        j["playerID"] = reader.readVarint();
+        j["score"] = reader.readVarint();
+        j["isAlive"] = reader.readBool();
+        j["username"] = reader.readString();
+
+        return j;
+    }
+
+    nlohmann::json decodePlayerStateSelf(ByteReader &reader) {
+        nlohmann::json j = decodePlayerStateExternal(reader);
+
+        j["penaltyTarget"] = decodeOptionalVarint(reader);
+        j["energy"] = decodeOptionalVarint(reader);
+
+        nlohmann::json j_stashedPenalties = nlohmann::json::array();
+        for (uint64_t i = reader.readVarint(); i > 0; --i) {
+            j_stashedPenalties.push_back(reader.readU8());
+        }
+        j["stashedPenalties"] = std::move(j_stashedPenalties);
+
+        j["activeBonus"] = decodeTimedEffect(reader, "bonusType");
+        j["activePenalty"] = decodeTimedEffect(reader, "penaltyType");
+
+        return j;
+    }
+
+    void decodeBoardDelta(ByteReader &reader, nlohmann::json &j_board) {
+        for (uint64_t i = reader.readVarint(); i > 0; --i) {
+            const uint8_t yRow = reader.readU8();
+            if (yRow >= Board::getHeight()) {
+                throw std::runtime_error("invalid row in encoded board delta");
+            }
+            j_board.at(yRow) = decodeRow(reader);
+        }
+    }
+
+    nlohmann::json decodeTetrominoQueue(ByteReader &reader) {
+        nlohmann::json j_tetrominoQueue = nlohmann::json::array();
+        for (uint64_t i = reader.readVarint(); i > 0; --i) {
+            j_tetrominoQueue.push_back(decodeTetromino(reader));
+        }
+
+        return j_tetrominoQueue;
+    }
+
+    void decodeTetrisSelfDelta(ByteReader &reader, nlohmann::json &j_tetris) {
+        const uint8_t flags = reader.readU8();
+
+        if (flags & TetrisDeltaFlag::ActiveTetromino) {
+            j_tetris["activeTetromino"] = decodeTetromino(reader);
+        }
+        if (flags & TetrisDeltaFlag::PreviewTetromino) {
+            j_tetris["previewTetromino"] = decodeTetromino(reader);
+        }
+        if (flags & TetrisDeltaFlag::HoldTetromino) {
+            j_tetris["holdTetromino"] = decodeTetromino(reader);
+        }
+        if (flags & TetrisDeltaFlag::TetrominoQueue) {
+            j_tetris["tetrominoQueue"] = decodeTetrominoQueue(reader);
+        }
+
+        decodeBoardDelta(reader, j_tetris.at("board"));
+    }
+
+    nlohmann::json decodeTetrisSelf(ByteReader &reader) {
+        nlohmann::json j;
+        j["activeTetromino"] = decodeTetromino(reader);
+        j["previewTetromino"] = decodeTetromino(reader);
+        j["holdTetromino"] = decodeTetromino(reader);
+
+        j["tetrominoQueue"] = decodeTetrominoQueue(reader);
+        j["board"] = decodeBoard(reader);
+
+        return j;
+    }
+
+} // namespace
+
+std::vector<uint8_t>
+game_state_codec::encode(const nlohmann::json &j_gameState) {
+    const nlohmann::json &j_externals = j_gameState.at("externals");
+
+    std::vector<std::vector<uint8_t>> encodedExternals;
+    encodedExternals.reserve(j_externals.size());
+    for (const nlohmann::json &j_external : j_externals) {
+        encodedExternals.push_back(encodeExternal(j_external));
+    }
+
+    return encodeFromParts(
+        j_gameState.at("isFinished").get<bool>(),
+        j_gameState.at("gameMode").get<GameMode>(),
+        getSelf(j_gameState),
+        std::vector<std::span<const uint8_t>>(encodedExternals.begin(),
+                                              encodedExternals.end()));
+}
+
+std::vector<uint8_t>
+game_state_codec::encodeExternal(const nlohmann::json &j_external) {
+    ByteWriter writer;
+    encodePlayerStateExternal(writer, j_external.at("playerState"));
+    encodeBoard(writer, j_external.at("tetris").at("board"));
+
+    return writer.release();
+}
+
+std::vector<uint8_t>
+game_state_codec::encodeExternalDelta(const nlohmann::json &j_base,
+                                      const nlohmann::json &j_external) {
+    ByteWriter writer;
+    encodeIfChanged(writer, j_base.at("playerState"),
+                    j_external.at("playerState"), encodePlayerStateExternal);
+    encodeBoardDelta(writer, j_base.at("tetris").at("board"),
+                     j_external.at("tetris").at("board"));
+
+    return writer.release();
+}
+
+std::vector<uint8_t> game_state_codec::encodeFromParts(
+    bool isFinished, GameMode gameMode, const nlohmann::json &j_self,
+    std::span<const std::span<const uint8_t>> externals) {
+    ByteWriter writer;
+
+    const bool hasSelf = !j_self.is_null();
+
+    uint8_t flags = 0;
+    if (isFinished) {
+        flags |= GameStateFlag::IsFinished;
+    }
+    if (hasSelf) {
+        flags |= GameStateFlag::HasSelf;
+    }
+
+    writer.writeU8(FORMAT_VERSION);
+    writer.writeU8(flags);
+    writer.writeU8(static_cast<uint8_t>(gameMode));
+
+    if (hasSelf) {
+        encodePlayerStateSelf(writer, j_self.at("playerState"));
+        encodeTetrisSelf(writer, j_self.at("tetris"));
+    }
+
+    writer.writeVarint(externals.size());
+    for (std::span<const uint8_t> external : externals) {
+        writer.writeBytes(external);
+    }
+
+    return writer.release();
+}
+
+nlohmann::json game_state_codec::decode(std::span<const uint8_t> bytes) {
+    ByteReader reader{bytes};
+
+    if (reader.readU8() != FORMAT_VERSION) {
+        throw std::runtime_error("unsupported GameState encoding version");
+    }
+
+    const uint8_t flags = reader.readU8();
+    const uint8_t gameMode = reader.readU8();
+    if (gameMode >= static_cast<uint8_t>(GameMode::NumGameMode)) {
+        throw std::runtime_error("invalid GameMode in encoded GameState");
+    }
+
+    nlohmann::json j;
+    j["isFinished"] = (flags & GameStateFlag::IsFinished) != 0;
+    j["gameMode"] = gameMode;
+
+    if (flags & GameStateFlag::HasSelf) {
+        nlohmann::json j_self;
+        j_self["playerState"] = decodePlayerStateSelf(reader);
+        j_self["tetris"] = decodeTetrisSelf(reader);
+        j["self"] = std::move(j_self);
+    }
+
+    nlohmann::json j_externals = nlohmann::json::array();
+    for (uint64_t i = reader.readVarint(); i > 0; --i) {
+        nlohmann::json j_external;
+        j_external["playerState"] = decodePlayerStateExternal(reader);
+        j_external["tetris"] = {{"board", decodeBoard(reader)}};
+        j_externals.push_back(std::move(j_external));
+    }
+    j["externals"] = std::move(j_externals);
+
+    if (flags & GameStateFlag::HasSelf) {
+        // only the players get the prices
+        GameState::serializeEffectPrices(static_cast<GameMode>(gameMode), j);
+    }
+
+    return j;
+}
+
+std::optional<std::vector<uint8_t>>
+game_state_codec::encodeDelta(const nlohmann::json &j_base,
+                              const nlohmann::json &j_gameState) {
+    const nlohmann::json &j_externals = j_gameState.at("externals");
+    const nlohmann::json &j_baseExternals = j_base.at("externals");
+
+    if (j_gameState.at("gameMode") != j_base.at("gameMode")
+        || j_externals.size() != j_baseExternals.size()) {
+        return std::nullopt;
+    }
+
+    std::vector<std::vector<uint8_t>> encodedExternals;
+    encodedExternals.reserve(j_externals.size());
+    for (size_t i = 0; i < j_externals.size(); ++i) {
+        encodedExternals.push_back(
+            encodeExternalDelta(j_baseExternals.at(i), j_externals.at(i)));
+    }
+
+    return encodeDeltaFromParts(
+        j_gameState.at("isFinished").get<bool>(),
+        getSelf(j_base), getSelf(j_gameState),
+        std::vector<std::span<const uint8_t>>(encodedExternals.begin(),
+                                              encodedExternals.end()));
+}
+
+std::optional<std::vector<uint8_t>> game_state_codec::encodeDeltaFromParts(
+    bool isFinished, const nlohmann::json &j_baseSelf,
+    const nlohmann::json &j_self,
+    std::span<const std::span<const uint8_t>> externals) {
+    const bool hasSelf = !j_self.is_null();
+    if (hasSelf == j_baseSelf.is_null()) {
+        return std::nullopt;
+    }
+
+    ByteWriter writer;
+
+    uint8_t flags = 0;
+    if (isFinished) {
+        flags |= GameStateFlag::IsFinished;
+    }
+    if (hasSelf) {
+        flags |= GameStateFlag::HasSelf;
+    }
+
+    writer.writeU8(FORMAT_VERSION);
+    writer.writeU8(flags);
+
+    if (hasSelf) {
+        encodeIfChanged(writer, j_baseSelf.at("playerState"),
+                        j_self.at("playerState"), encodePlayerStateSelf);
+        encodeTetrisSelfDelta(writer, j_baseSelf.at("tetris"),
+                              j_self.at("tetris"));
+    }
+
+    for (std::span<const uint8_t> external : externals) {
+        writer.writeBytes(external);
+    }
+
+    return writer.release();
+}
+
+nlohmann::json game_state_codec::decodeDelta(const nlohmann::json &j_base,
+                                             std::span<const uint8_t> bytes) {
+    ByteReader reader{bytes};
+
+    if (reader.readU8() != FORMAT_VERSION) {
+        throw std::runtime_error("unsupported GameState encoding version");
+    }
+
+    const uint8_t flags = reader.readU8();
+    if (((flags & GameStateFlag::HasSelf) != 0) != j_base.contains("self")) {
+        throw std::runtime_error("GameState delta doesn't match its base");
+    }
+
+    nlohmann::json j = j_base;
+    j["isFinished"] = (flags & GameStateFlag::IsFinished) != 0;
+
+    if (flags & GameStateFlag::HasSelf) {
+        nlohmann::json &j_self = j.at("self");
+        if (reader.readBool()) {
+            j_self["playerState"] = decodePlayerStateSelf(reader);
+        }
+        decodeTetrisSelfDelta(reader, j_self.at("tetris"));
+    }
+
+    for (nlohmann::json &j_external : j.at("externals")) {
+        if (reader.readBool()) {
+            j_external["playerState"] = decodePlayerStateExternal(reader);
+        }
+        decodeBoardDelta(reader, j_external.at("tetris").at("board"));
+    }
+
+    return j;
+}
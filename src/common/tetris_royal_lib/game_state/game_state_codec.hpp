@@ -0,0 +1,129 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAME_STATE_CODEC_HPP
+#define GAME_STATE_CODEC_HPP
+
+#include "../game_mode/game_mode.hpp"
+
+#include <cstdint>
+#include <nlohmann/json_fwd.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Compact binary encoding of the serialized GameState (the output of
+ * GameState::serializeForPlayer() and GameState::serializeForViewer()), for
+ * the clients that support it.
+ *
+ * Compared to the JSON text:
+ * - the board cells take 4 bits each, and runs of empty rows a single varint;
+ * - the tetrominoes are only their shape, rotation and anchor point (the body
+ *   is rebuilt when decoding);
+ * - the ids, scores and energy are varints, the enums a single byte;
+ * - the effects' prices are not sent, they only depend on the GameMode.
+ *
+ * Decoding gives back the same JSON, so that the client deserializes both
+ * encodings the same way (only the effects' elapsed time, a proportion, is
+ * rounded to 16 bits).
+ *
+ * A GameState can also be encoded as a delta from a previous one (its base),
+ * which only contains the changed player states, tetrominoes and board rows.
+ *
+ * The external views of the players are encoded one after the other, so a
+ * server sending the same views to several clients can encode each of them
+ * once (see encodeExternal()) and splice them into each client's GameState
+ * (see encodeFromParts()).
+ */
+namespace game_state_codec {
+
+    inline constexpr uint8_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Encodes the given serialized GameState.
+     */
+    std::vector<uint8_t> encode(const nlohmann::json &j_gameState);
+
+    /**
+     * @brief Decodes a GameState encoded by encode() back to JSON.
+     *
+     * @throws std::runtime_error if the bytes are not a valid encoding.
+     */
+    nlohmann::json decode(std::span<const uint8_t> bytes);
+
+    /**
+     * @brief Encodes the given serialized GameState as a delta from the given
+     * base (a GameState serialized for the same player or viewer).
+     *
+     * @return nullopt if the GameStates can't be compared (e.g. not the same
+     * number of players), a full GameState has to be sent instead.
+     */
+    std::optional<std::vector<uint8_t>>
+    encodeDelta(const nlohmann::json &j_base,
+                const nlohmann::json &j_gameState);
+
+    /**
+     * @brief Encodes the given external view of a player (an element of a
+     * serialized GameState's "externals"), see encodeFromParts().
+     */
+    std::vector<uint8_t> encodeExternal(const nlohmann::json &j_external);
+
+    /**
+     * @brief Encodes the given external view of a player as a delta from the
+     * given base (the same player's view), see encodeDeltaFromParts().
+     */
+    std::vector<uint8_t> encodeExternalDelta(const nlohmann::json &j_base,
+                                             const nlohmann::json &j_external);
+
+    /**
+     * @brief Same as encode(), from the parts of the serialized GameState:
+     * the external views are already encoded by encodeExternal().
+     *
+     * @param j_self The "self" of the GameState, null for a viewer.
+     */
+    std::vector<uint8_t>
+    encodeFromParts(bool isFinished, GameMode gameMode,
+                    const nlohmann::json &j_self,
+                    std::span<const std::span<const uint8_t>> externals);
+
+    /**
+     * @brief Same as encodeDelta(), from the parts of the serialized
+     * GameStates: the external views are already encoded as deltas from the
+     * base's by encodeExternalDelta(), in the same order.
+     *
+     * @param j_baseSelf The "self" of the base, null for a viewer.
+     * @param j_self The "self" of the GameState, null for a viewer.
+     * @return nullopt if only one of the GameStates has a "self".
+     */
+    std::optional<std::vector<uint8_t>>
+    encodeDeltaFromParts(bool isFinished, const nlohmann::json &j_baseSelf,
+                         const nlohmann::json &j_self,
+                         std::span<const std::span<const uint8_t>> externals);
+
+    /**
+     * @brief Applies a delta encoded by encodeDelta() to its base.
+     *
+     * @throws std::runtime_error if the bytes are not a valid delta of the
+     * given base.
+     */
+    nlohmann::json decodeDelta(const nlohmann::json &j_base,
+                               std::span<const uint8_t> bytes);
+
+} // namespace game_state_codec
+
+#endif // GAME_STATE_CODEC_HPP
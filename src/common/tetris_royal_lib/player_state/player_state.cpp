@@ -20,6 +20,7 @@
 #include "../effect/penalty/speed_up.hpp"
 
 #include <optional>
+#include <stdexcept>
 
 PlayerState::PlayerState(UserID userID, std::string username, Score score)
     : TetrisObserver{}, userID_{userID}, score_{score}, isAlive_{true},
@@ -230,3 +231,91 @@ nlohmann::json PlayerState::serializeSelf() const {
 
     return j;
 }
+
+/* ------------------------------------------------
+ *          Snapshot
+ * ------------------------------------------------*/
+
+void PlayerState::writeSnapshot(ByteWriter &writer) const {
+    writer.writeVarint(score_);
+    writer.writeBool(isAlive_);
+    writer.writeOptionalVarint(penaltyTarget_);
+    writer.writeOptionalVarint(energy_);
+
+    std::queue<PenaltyType> receivedPenalties = receivedPenaltiesQueue_;
+    writer.writeVarint(receivedPenalties.size());
+    for (; !receivedPenalties.empty(); receivedPenalties.pop()) {
+        writer.writeU8(static_cast<uint8_t>(receivedPenalties.front()));
+    }
+
+    std::queue<BonusType> grantedBonuses = grantedBonusesQueue_;
+    writer.writeVarint(grantedBonuses.size());
+    for (; !grantedBonuses.empty(); grantedBonuses.pop()) {
+        writer.writeU8(static_cast<uint8_t>(grantedBonuses.front()));
+    }
+
+    writer.writeVarint(stashedPenalties_.size());
+    for (PenaltyType penaltyType : stashedPenalties_) {
+        writer.writeU8(static_cast<uint8_t>(penaltyType));
+    }
+
+    writer.writeBool(pActiveBonus_ != nullptr);
+    if (pActiveBonus_ != nullptr) {
+        writer.writeU8(static_cast<uint8_t>(pActiveBonus_->getBonusType()));
+        writer.writeVarint(pActiveBonus_->getRemainingDuration());
+    }
+
+    writer.writeBool(pActivePenalty_ != nullptr);
+    if (pActivePenalty_ != nullptr) {
+        writer.writeU8(static_cast<uint8_t>(pActivePenalty_->getPenaltyType()));
+        writer.writeVarint(pActivePenalty_->getRemainingDuration());
+    }
+
+    writer.writeOptionalVarint(engineTicksSinceLastTick_);
+}
+
+void PlayerState::readSnapshot(ByteReader &reader) {
+    score_ = reader.readVarint();
+    isAlive_ = reader.readBool();
+    penaltyTarget_ = reader.readOptionalVarint();
+    energy_ = reader.readOptionalVarint();
+
+    receivedPenaltiesQueue_ = {};
+    for (size_t i = reader.readVarint(); i > 0; i--) {
+        receivedPenaltiesQueue_.push(static_cast<PenaltyType>(reader.readU8()));
+    }
+
+    grantedBonusesQueue_ = {};
+    for (size_t i = reader.readVarint(); i > 0; i--) {
+        grantedBonusesQueue_.push(static_cast<BonusType>(reader.readU8()));
+    }
+
+    stashedPenalties_.clear();
+    for (size_t i = reader.readVarint(); i > 0; i--) {
+        stashedPenalties_.push_back(static_cast<PenaltyType>(reader.readU8()));
+    }
+
+    pActiveBonus_ = nullptr;
+    if (reader.readBool()) {
+        pActiveBonus_ =
+            TimedBonus::makeBonus(static_cast<BonusType>(reader.readU8()));
+        size_t remainingDuration = reader.readVarint();
+        if (pActiveBonus_ == nullptr) {
+            throw std::runtime_error("invalid bonus type in snapshot");
+        }
+        pActiveBonus_->setRemainingDuration(remainingDuration);
+    }
+
+    pActivePenalty_ = nullptr;
+    if (reader.readBool()) {
+        pActivePenalty_ =
+            TimedPenalty::makePenalty(static_cast<PenaltyType>(reader.readU8()));
+        size_t remainingDuration = reader.readVarint();
+        if (pActivePenalty_ == nullptr) {
+            throw std::runtime_error("invalid penalty type in snapshot");
+        }
+        pActivePenalty_->setRemainingDuration(remainingDuration);
+    }
+
+    engineTicksSinceLastTick_ = reader.readOptionalVarint();
+}
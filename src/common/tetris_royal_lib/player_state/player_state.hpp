@@ -18,6 +18,8 @@
 #ifndef PLAYER_STATE_HPP
 #define PLAYER_STATE_HPP
 
+#include "../../tetris_lib/byte_stream/byte_reader.hpp"
+#include "../../tetris_lib/byte_stream/byte_writer.hpp"
 #include "../../tetris_lib/tetris/tetris_observer.hpp"
 #include "../../types/types.hpp"
 #include "../effect/bonus/timed_bonus.hpp"
@@ -254,6 +256,22 @@ class PlayerState final : public TetrisObserver {
      * hiding information).
      */
     nlohmann::json serializeSelf() const;
+
+    /* ------------------------------------------------
+     *          Snapshot
+     * ------------------------------------------------*/
+
+    /**
+     * @brief Writes the complete mutable state of the player (score, energy,
+     * effects queues, active effects, ...) in binary. The user ID and username
+     * never change during a game and are not part of the snapshot.
+     */
+    void writeSnapshot(ByteWriter &writer) const;
+
+    /**
+     * @brief Restores a state written by writeSnapshot().
+     */
+    void readSnapshot(ByteReader &reader);
 };
 
 using PlayerStatePtr = std::shared_ptr<PlayerState>;
@@ -19,8 +19,8 @@
 
 #include <memory>
 
-PlayerTetris::PlayerTetris(PlayerStatePtr &&pPlayerState)
-    : pPlayerState{pPlayerState}, pTetris{std::make_shared<Tetris>()} {
+PlayerTetris::PlayerTetris(PlayerStatePtr &&pPlayerState, Seed seed)
+    : pPlayerState{pPlayerState}, pTetris{std::make_shared<Tetris>(seed)} {
 
     // Register the player state as an observer of the Tetris instance.
     // This allows the player state to be notified of game events such as
@@ -27,8 +27,10 @@ struct PlayerTetris {
 
     /**
      * @brief PlayerTetris Constructor
+     *
+     * @param seed The seed the player's Tetris random events are drawn from.
      */
-    PlayerTetris(PlayerStatePtr &&pPlayerState);
+    PlayerTetris(PlayerStatePtr &&pPlayerState, Seed seed);
 
     /* ------------------------------------------------
      *          Serialization
@@ -0,0 +1,103 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mapped_file.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// --- private ---
+
+void MappedFile::unmap() noexcept {
+#ifndef _WIN32
+    if (data_ != nullptr && buffer_.empty() && size_ > 0) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+}
+
+// --- public ---
+
+MappedFile::MappedFile(const std::filesystem::path &path) {
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error{"Failed to open " + path.string()};
+    }
+
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+        void *addr = mmap(nullptr, static_cast<size_t>(fileStat.st_size),
+                          PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (addr != MAP_FAILED) {
+            data_ = static_cast<const uint8_t *>(addr);
+            size_ = static_cast<size_t>(fileStat.st_size);
+        }
+    }
+
+    ::close(fd);
+
+    if (data_ != nullptr) {
+        return;
+    }
+#endif
+
+    // Fallback: read the whole file
+    std::ifstream file{path, std::ios::binary};
+    if (!file) {
+        throw std::runtime_error{"Failed to open " + path.string()};
+    }
+
+    buffer_.assign(std::istreambuf_iterator<char>{file},
+                   std::istreambuf_iterator<char>{});
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)}, buffer_{std::move(other.buffer_)} {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        unmap();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        buffer_ = std::move(other.buffer_);
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+std::span<const uint8_t> MappedFile::getBytes() const noexcept {
+    return {data_, size_};
+}
@@ -0,0 +1,61 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+/**
+ * @class MappedFile
+ *
+ * @brief Read-only view of a whole file. The file is memory-mapped on POSIX
+ * systems (so only the pages actually read are loaded) and read into memory
+ * elsewhere.
+ */
+class MappedFile {
+  private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+
+    // fallback storage when the file can't be mapped
+    std::vector<uint8_t> buffer_;
+
+    void unmap() noexcept;
+
+  public:
+    /**
+     * @brief Maps the given file.
+     *
+     * @throws std::runtime_error if the file can't be opened.
+     */
+    explicit MappedFile(const std::filesystem::path &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    ~MappedFile();
+
+    std::span<const uint8_t> getBytes() const noexcept;
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,68 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAY_FORMAT_HPP
+#define REPLAY_FORMAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Layout of a binary replay file (".rbr"), all integers little-endian:
+ *
+ * - Header: magic "RBRP", u16 version, u16 reserved, u64 seed,
+ *   u32 keyframeInterval, u8 gameMode, varint numPlayers then per player a
+ *   varint userID and a string username; padded to ALIGNMENT.
+ * - Input stream: one record per engine tick or received action, in the order
+ *   the game saw them. A record starts with a u8 RecordType and the signed
+ *   varint delta of its timestamp (ms) with the previous record; actions then
+ *   hold a varint userID and the action itself (see writeGameAction()).
+ * - Keyframes: GameState snapshots, each starting at an ALIGNMENT boundary.
+ * - Seek index: one INDEX_ENTRY_SIZE entry per keyframe, sorted by tick:
+ *   u64 tick, u64 entryIdx, u64 timestampMs, u64 streamOffset (just after the
+ *   keyframe's tick record), u64 snapshotOffset, u64 snapshotSize.
+ * - Footer (last FOOTER_SIZE bytes): u64 streamOffset, u64 streamSize,
+ *   u64 indexOffset, u64 numKeyframes, u64 numTicks, u64 durationMs,
+ *   u32 reserved, magic "RBIX".
+ *
+ * Readers start from the footer, so the index can be located without
+ * scanning the stream.
+ */
+namespace replay_format {
+
+constexpr std::array<uint8_t, 4> HEADER_MAGIC{'R', 'B', 'R', 'P'};
+constexpr std::array<uint8_t, 4> FOOTER_MAGIC{'R', 'B', 'I', 'X'};
+
+constexpr uint16_t VERSION = 1;
+
+constexpr size_t ALIGNMENT = 8;
+
+constexpr size_t INDEX_ENTRY_SIZE = 6 * sizeof(uint64_t);
+constexpr size_t FOOTER_SIZE =
+    6 * sizeof(uint64_t) + sizeof(uint32_t) + FOOTER_MAGIC.size();
+
+constexpr const char *FILE_EXTENSION = ".rbr";
+
+enum class RecordType : uint8_t {
+    Tick,
+    Action,
+};
+
+} // namespace replay_format
+
+#endif // REPLAY_FORMAT_HPP
@@ -0,0 +1,236 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "replay_reader.hpp"
+
+#include "byte_stream/byte_reader.hpp"
+#include "replay_format.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+// --- private ---
+
+void ReplayReader::parse() {
+    using namespace replay_format;
+
+    if (bytes_.size() < HEADER_MAGIC.size() + FOOTER_SIZE) {
+        throw std::runtime_error{"Replay too small"};
+    }
+
+    // Footer
+    ByteReader footer{bytes_, bytes_.size() - FOOTER_SIZE};
+
+    streamOffset_ = footer.readU64();
+    const size_t streamSize = footer.readU64();
+    indexOffset_ = footer.readU64();
+    numKeyframes_ = footer.readU64();
+    numTicks_ = footer.readU64();
+    durationMs_ = footer.readU64();
+    footer.readU32();
+
+    if (!std::ranges::equal(footer.readBytes(FOOTER_MAGIC.size()),
+                            FOOTER_MAGIC)) {
+        throw std::runtime_error{"Invalid replay footer"};
+    }
+
+    // checked before any sum, which could wrap around
+    const size_t footerOffset = bytes_.size() - FOOTER_SIZE;
+    if (streamOffset_ > footerOffset
+        || streamSize > footerOffset - streamOffset_
+        || indexOffset_ > footerOffset
+        || numKeyframes_ > (footerOffset - indexOffset_) / INDEX_ENTRY_SIZE) {
+        throw std::runtime_error{"Invalid replay footer"};
+    }
+
+    streamEnd_ = streamOffset_ + streamSize;
+
+    // Header
+    ByteReader header{bytes_.first(streamOffset_)};
+
+    if (!std::ranges::equal(header.readBytes(HEADER_MAGIC.size()),
+                            HEADER_MAGIC)) {
+        throw std::runtime_error{"Not a replay file"};
+    }
+
+    if (header.readU16() != VERSION) {
+        throw std::runtime_error{"Unsupported replay version"};
+    }
+    header.readU16();
+
+    seed_ = header.readU64();
+    keyframeInterval_ = header.readU32();
+
+    const uint8_t gameMode = header.readU8();
+    if (gameMode >= static_cast<uint8_t>(GameMode::NumGameMode)) {
+        throw std::runtime_error{"Invalid replay game mode"};
+    }
+    gameMode_ = static_cast<GameMode>(gameMode);
+
+    const size_t numPlayers = header.readVarint();
+    players_.clear();
+    for (size_t i = 0; i < numPlayers; i++) {
+        const UserID userID = static_cast<UserID>(header.readVarint());
+        players_.push_back(GameLogPlayer{userID, header.readString()});
+    }
+}
+
+uint64_t ReplayReader::readIndexField(size_t keyframeIdx,
+                                      size_t fieldIdx) const {
+    return ByteReader{bytes_, indexOffset_
+                                  + keyframeIdx
+                                        * replay_format::INDEX_ENTRY_SIZE
+                                  + fieldIdx * sizeof(uint64_t)}
+        .readU64();
+}
+
+std::optional<ReplayKeyframe>
+ReplayReader::findLastKeyframe(size_t fieldIdx, uint64_t value) const {
+    // index of the first keyframe past the given value
+    size_t low = 0;
+    size_t high = numKeyframes_;
+
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+
+        if (readIndexField(mid, fieldIdx) <= value) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == 0) {
+        return std::nullopt;
+    }
+
+    return getKeyframe(low - 1);
+}
+
+// --- public ---
+
+ReplayReader::ReplayReader(std::vector<uint8_t> &&bytes)
+    : ownedBytes_{std::move(bytes)}, bytes_{ownedBytes_} {
+    parse();
+}
+
+ReplayReader::ReplayReader(std::unique_ptr<MappedFile> &&pMappedFile)
+    : pMappedFile_{std::move(pMappedFile)}, bytes_{pMappedFile_->getBytes()} {
+    parse();
+}
+
+ReplayReader ReplayReader::open(const std::filesystem::path &path) {
+    return ReplayReader{std::make_unique<MappedFile>(path)};
+}
+
+// #### Getters ####
+
+GameMode ReplayReader::getGameMode() const { return gameMode_; }
+
+Seed ReplayReader::getSeed() const { return seed_; }
+
+size_t ReplayReader::getKeyframeInterval() const { return keyframeInterval_; }
+
+const std::vector<GameLogPlayer> &ReplayReader::getPlayers() const {
+    return players_;
+}
+
+size_t ReplayReader::getNumTicks() const { return numTicks_; }
+
+uint64_t ReplayReader::getDurationMs() const { return durationMs_; }
+
+size_t ReplayReader::getNumKeyframes() const { return numKeyframes_; }
+
+ReplayKeyframe ReplayReader::getKeyframe(size_t keyframeIdx) const {
+    if (keyframeIdx >= numKeyframes_) {
+        throw std::out_of_range{"Invalid keyframe index"};
+    }
+
+    ByteReader reader{bytes_, indexOffset_
+                                  + keyframeIdx
+                                        * replay_format::INDEX_ENTRY_SIZE};
+
+    ReplayKeyframe keyframe;
+    keyframe.tick = reader.readU64();
+    keyframe.entryIdx = reader.readU64();
+    keyframe.timestampMs = reader.readU64();
+    keyframe.streamOffset = reader.readU64();
+
+    const size_t snapshotOffset = reader.readU64();
+    const size_t snapshotSize = reader.readU64();
+
+    if (snapshotOffset > bytes_.size()
+        || snapshotSize > bytes_.size() - snapshotOffset
+        || keyframe.streamOffset < streamOffset_
+        || keyframe.streamOffset > streamEnd_) {
+        throw std::runtime_error{"Invalid replay keyframe"};
+    }
+
+    keyframe.snapshot = bytes_.subspan(snapshotOffset, snapshotSize);
+
+    return keyframe;
+}
+
+std::optional<ReplayKeyframe> ReplayReader::findKeyframe(size_t tick) const {
+    return findLastKeyframe(0, tick);
+}
+
+std::optional<ReplayKeyframe>
+ReplayReader::findKeyframeByTimestamp(uint64_t timestampMs) const {
+    return findLastKeyframe(2, timestampMs);
+}
+
+GameStatePtr ReplayReader::createInitialGameState() const {
+    return GameLog::createGameState(gameMode_, seed_, players_);
+}
+
+// #### Input stream ####
+
+size_t ReplayReader::getStreamBegin() const { return streamOffset_; }
+
+size_t ReplayReader::getStreamEnd() const { return streamEnd_; }
+
+ReplayEvent ReplayReader::readEvent(size_t &offset,
+                                    uint64_t &timestampMs) const {
+    ByteReader reader{bytes_.first(streamEnd_), offset};
+
+    const auto recordType =
+        static_cast<replay_format::RecordType>(reader.readU8());
+    timestampMs = static_cast<uint64_t>(static_cast<int64_t>(timestampMs)
+                                        + reader.readSignedVarint());
+
+    ReplayEvent event{};
+    event.timestampMs = timestampMs;
+
+    switch (recordType) {
+    case replay_format::RecordType::Tick:
+        event.type = ReplayEvent::Type::Tick;
+        break;
+    case replay_format::RecordType::Action:
+        event.type = ReplayEvent::Type::Action;
+        event.userID = static_cast<UserID>(reader.readVarint());
+        event.action = readGameAction(reader);
+        break;
+    default:
+        throw std::runtime_error{"Invalid replay record"};
+    }
+
+    offset = reader.getPosition();
+
+    return event;
+}
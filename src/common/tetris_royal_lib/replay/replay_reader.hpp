@@ -0,0 +1,190 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAY_READER_HPP
+#define REPLAY_READER_HPP
+
+#include "../../types/types.hpp"
+#include "../game_log/game_action.hpp"
+#include "../game_log/game_log.hpp"
+#include "../game_mode/game_mode.hpp"
+#include "../game_state/game_state.hpp"
+#include "mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+ * @brief A keyframe of a replay file, see GameLogKeyframe.
+ */
+struct ReplayKeyframe {
+    size_t tick;
+    size_t entryIdx;
+    uint64_t timestampMs;
+    // offset of the first input stream record following the keyframe
+    size_t streamOffset;
+    std::span<const uint8_t> snapshot;
+};
+
+/**
+ * @brief A record of the input stream of a replay file.
+ */
+struct ReplayEvent {
+    enum class Type {
+        Tick,
+        Action,
+    };
+
+    Type type;
+    uint64_t timestampMs;
+
+    // only meaningful for actions
+    UserID userID;
+    GameAction action;
+};
+
+/**
+ * @class ReplayReader
+ *
+ * @brief Random access to a binary replay file (see replay_format.hpp).
+ *
+ * Only the header, footer and seek index are parsed upfront; keyframes and
+ * input stream records are decoded on demand, directly from the (possibly
+ * memory-mapped) bytes.
+ */
+class ReplayReader {
+  private:
+    std::vector<uint8_t> ownedBytes_;
+    std::unique_ptr<MappedFile> pMappedFile_;
+    std::span<const uint8_t> bytes_;
+
+    GameMode gameMode_;
+    Seed seed_;
+    size_t keyframeInterval_;
+    std::vector<GameLogPlayer> players_;
+
+    size_t streamOffset_;
+    size_t streamEnd_;
+    size_t indexOffset_;
+    size_t numKeyframes_;
+    size_t numTicks_;
+    uint64_t durationMs_;
+
+    /**
+     * @brief Parses the footer, header and checks the index bounds.
+     *
+     * @throws std::runtime_error if the bytes aren't a valid replay.
+     */
+    void parse();
+
+    /**
+     * @brief Reads the fieldIdx-th u64 of the given seek index entry.
+     */
+    uint64_t readIndexField(size_t keyframeIdx, size_t fieldIdx) const;
+
+    /**
+     * @brief Returns the last keyframe whose fieldIdx-th index field is at
+     * most the given value (the index is sorted by tick and timestamp).
+     */
+    std::optional<ReplayKeyframe> findLastKeyframe(size_t fieldIdx,
+                                                   uint64_t value) const;
+
+    explicit ReplayReader(std::unique_ptr<MappedFile> &&pMappedFile);
+
+  public:
+    /**
+     * @brief Reads a replay from memory.
+     *
+     * @throws std::runtime_error if the bytes aren't a valid replay.
+     */
+    explicit ReplayReader(std::vector<uint8_t> &&bytes);
+    ReplayReader(const ReplayReader &) = delete;
+    ReplayReader(ReplayReader &&) = default;
+    ReplayReader &operator=(const ReplayReader &) = delete;
+    ReplayReader &operator=(ReplayReader &&) = default;
+
+    ~ReplayReader() = default;
+
+    /**
+     * @brief Opens (and memory-maps) the given replay file.
+     *
+     * @throws std::runtime_error if the file can't be read or isn't a valid
+     * replay.
+     */
+    static ReplayReader open(const std::filesystem::path &path);
+
+    // #### Getters ####
+
+    GameMode getGameMode() const;
+
+    Seed getSeed() const;
+
+    size_t getKeyframeInterval() const;
+
+    const std::vector<GameLogPlayer> &getPlayers() const;
+
+    size_t getNumTicks() const;
+
+    uint64_t getDurationMs() const;
+
+    size_t getNumKeyframes() const;
+
+    ReplayKeyframe getKeyframe(size_t keyframeIdx) const;
+
+    /**
+     * @brief Returns the last keyframe taken at or before the given tick,
+     * nullopt if there is none (the replay must then start from
+     * createInitialGameState()).
+     */
+    std::optional<ReplayKeyframe> findKeyframe(size_t tick) const;
+
+    /**
+     * @brief Returns the last keyframe taken at or before the given time (in
+     * milliseconds since the start of the game), nullopt if there is none.
+     */
+    std::optional<ReplayKeyframe>
+    findKeyframeByTimestamp(uint64_t timestampMs) const;
+
+    /**
+     * @brief Creates the GameState the recorded game started from.
+     */
+    GameStatePtr createInitialGameState() const;
+
+    // #### Input stream ####
+
+    size_t getStreamBegin() const;
+
+    size_t getStreamEnd() const;
+
+    /**
+     * @brief Decodes the input stream record at the given offset.
+     *
+     * @param offset Advanced past the record.
+     * @param timestampMs Timestamp of the previous record, updated to the
+     * decoded one's.
+     *
+     * @throws std::runtime_error if the record is malformed.
+     */
+    ReplayEvent readEvent(size_t &offset, uint64_t &timestampMs) const;
+};
+
+#endif // REPLAY_READER_HPP
@@ -0,0 +1,149 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "replay_writer.hpp"
+
+#include "byte_stream/byte_writer.hpp"
+#include "replay_format.hpp"
+
+#include <cstddef>
+#include <span>
+
+namespace {
+
+/**
+ * @brief Position of a keyframe's snapshot and of its tick in the input
+ * stream, known once the stream was written.
+ */
+struct KeyframeOffsets {
+    size_t streamOffset;
+    size_t snapshotOffset;
+};
+
+void writeHeader(ByteWriter &writer, const GameLog &gameLog) {
+    writer.writeBytes(replay_format::HEADER_MAGIC);
+    writer.writeU16(replay_format::VERSION);
+    writer.writeU16(0);
+    writer.writeU64(gameLog.getSeed());
+    writer.writeU32(static_cast<uint32_t>(gameLog.getKeyframeInterval()));
+    writer.writeU8(static_cast<uint8_t>(gameLog.getGameMode()));
+
+    writer.writeVarint(gameLog.getPlayers().size());
+    for (const GameLogPlayer &player : gameLog.getPlayers()) {
+        writer.writeVarint(player.userID);
+        writer.writeString(player.username);
+    }
+
+    writer.alignTo(replay_format::ALIGNMENT);
+}
+
+void writeRecordStart(ByteWriter &writer, replay_format::RecordType recordType,
+                      uint64_t timestampMs, uint64_t &prevTimestampMs) {
+    writer.writeU8(static_cast<uint8_t>(recordType));
+    writer.writeSignedVarint(static_cast<int64_t>(timestampMs)
+                             - static_cast<int64_t>(prevTimestampMs));
+    prevTimestampMs = timestampMs;
+}
+
+/**
+ * @brief Writes the ticks and actions of the log in the order the game saw
+ * them, filling the stream offset of each keyframe.
+ *
+ * @return The timestamp of the last record, i.e. the duration of the game.
+ */
+uint64_t writeInputStream(ByteWriter &writer, const GameLog &gameLog,
+                          std::vector<KeyframeOffsets> &keyframeOffsets) {
+    const std::vector<GameLogEntry> &entries = gameLog.getEntries();
+    const std::vector<GameLogKeyframe> &keyframes = gameLog.getKeyframes();
+
+    uint64_t prevTimestampMs = 0;
+    size_t entryIdx = 0;
+    size_t keyframeIdx = 0;
+
+    for (size_t tick = 0; tick <= gameLog.getNumTicks(); tick++) {
+        if (tick > 0) {
+            writeRecordStart(writer, replay_format::RecordType::Tick,
+                             gameLog.getTickTimestampMs(tick), prevTimestampMs);
+
+            if (keyframeIdx < keyframes.size()
+                && keyframes.at(keyframeIdx).tick == tick) {
+                keyframeOffsets.at(keyframeIdx).streamOffset = writer.size();
+                keyframeIdx++;
+            }
+        }
+
+        while (entryIdx < entries.size() && entries.at(entryIdx).tick <= tick) {
+            const GameLogEntry &entry = entries.at(entryIdx);
+
+            writeRecordStart(writer, replay_format::RecordType::Action,
+                             entry.timestampMs, prevTimestampMs);
+            writer.writeVarint(entry.userID);
+            writeGameAction(writer, entry.action);
+
+            entryIdx++;
+        }
+    }
+
+    return prevTimestampMs;
+}
+
+} // namespace
+
+std::vector<uint8_t> encodeReplay(const GameLog &gameLog) {
+    const std::vector<GameLogKeyframe> &keyframes = gameLog.getKeyframes();
+    std::vector<KeyframeOffsets> keyframeOffsets(keyframes.size());
+
+    ByteWriter writer;
+
+    writeHeader(writer, gameLog);
+
+    const size_t streamOffset = writer.size();
+    const uint64_t durationMs =
+        writeInputStream(writer, gameLog, keyframeOffsets);
+    const size_t streamSize = writer.size() - streamOffset;
+
+    for (size_t i = 0; i < keyframes.size(); i++) {
+        writer.alignTo(replay_format::ALIGNMENT);
+        keyframeOffsets.at(i).snapshotOffset = writer.size();
+        writer.writeBytes(keyframes.at(i).snapshot);
+    }
+
+    writer.alignTo(replay_format::ALIGNMENT);
+    const size_t indexOffset = writer.size();
+
+    for (size_t i = 0; i < keyframes.size(); i++) {
+        const GameLogKeyframe &keyframe = keyframes.at(i);
+
+        writer.writeU64(keyframe.tick);
+        writer.writeU64(keyframe.entryIdx);
+        writer.writeU64(gameLog.getTickTimestampMs(keyframe.tick));
+        writer.writeU64(keyframeOffsets.at(i).streamOffset);
+        writer.writeU64(keyframeOffsets.at(i).snapshotOffset);
+        writer.writeU64(keyframe.snapshot.size());
+    }
+
+    writer.writeU64(streamOffset);
+    writer.writeU64(streamSize);
+    writer.writeU64(indexOffset);
+    writer.writeU64(keyframes.size());
+    writer.writeU64(gameLog.getNumTicks());
+    writer.writeU64(durationMs);
+    writer.writeU32(0);
+    writer.writeBytes(replay_format::FOOTER_MAGIC);
+
+    return writer.release();
+}
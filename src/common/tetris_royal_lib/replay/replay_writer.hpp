@@ -0,0 +1,32 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAY_WRITER_HPP
+#define REPLAY_WRITER_HPP
+
+#include "../game_log/game_log.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Encodes the given log, keyframes included, into the binary replay
+ * format (see replay_format.hpp).
+ */
+std::vector<uint8_t> encodeReplay(const GameLog &gameLog);
+
+#endif // REPLAY_WRITER_HPP
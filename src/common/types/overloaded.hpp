@@ -0,0 +1,33 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OVERLOADED_HPP
+#define OVERLOADED_HPP
+
+/**
+ * @brief Helper to build a visitor out of lambdas, one per alternative of the
+ * visited variant:
+ *
+ *     std::visit(Overloaded{[](const A &a) { ... },
+ *                           [](const auto &) { ... }},
+ *                variant);
+ */
+template <typename... Ts> struct Overloaded : Ts... {
+    using Ts::operator()...;
+};
+
+#endif // OVERLOADED_HPP
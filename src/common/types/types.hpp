@@ -16,7 +16,9 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 
 using UserID = size_t;
 using Score = size_t;
 using Energy = size_t;
+using Seed = uint64_t;
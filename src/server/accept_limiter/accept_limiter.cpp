@@ -0,0 +1,61 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "accept_limiter.hpp"
+
+#include <functional>
+#include <iterator>
+
+// ====== AcceptLimiter class ======
+
+// --- private ---
+
+AcceptLimiter::Shard &
+AcceptLimiter::getShard(const asio::ip::address &address) {
+    return shards_[std::hash<asio::ip::address>{}(address) & (NUM_SHARDS - 1)];
+}
+
+void AcceptLimiter::sweep(Shard &shard, Clock::time_point now) {
+    for (auto host = shard.hosts.begin(); host != shard.hosts.end();) {
+        host = now - host->second.lastAttempt > forgetAfter_
+                   ? shard.hosts.erase(host)
+                   : std::next(host);
+    }
+    shard.lastSweep = now;
+}
+
+// --- public ---
+
+AcceptLimiter::AcceptLimiter(TokenBucket::Rate rate)
+    : rate_(rate),
+      forgetAfter_(std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(rate.burst / rate.perSecond))) {}
+
+bool AcceptLimiter::tryAccept(const asio::ip::address &address) {
+    const Clock::time_point now = Clock::now();
+    Shard &shard = getShard(address);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (now - shard.lastSweep > SWEEP_INTERVAL) {
+        sweep(shard, now);
+    }
+
+    auto host =
+        shard.hosts.try_emplace(address, Host{TokenBucket(rate_), now}).first;
+    host->second.lastAttempt = now;
+    return host->second.bucket.tryTake();
+}
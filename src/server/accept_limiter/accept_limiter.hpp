@@ -0,0 +1,96 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACCEPT_LIMITER_HPP
+#define ACCEPT_LIMITER_HPP
+
+#include <asio/ip/address.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include "../cache_line/cache_line.hpp"
+#include "../token_bucket/token_bucket.hpp"
+
+/**
+ * @class AcceptLimiter
+ *
+ * @brief Limits the rate of the connections accepted from each address, so
+ * that a single host retrying in a loop can't take the acceptors from the
+ * others.
+ *
+ * It is checked by all the acceptors at once, so the addresses are split
+ * into shards with their own mutex. An address is forgotten once its bucket
+ * would be full again, as it then behaves like a new one.
+ */
+class AcceptLimiter {
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Host {
+        TokenBucket bucket;
+        Clock::time_point lastAttempt;
+    };
+
+    using Hosts = std::unordered_map<asio::ip::address, Host>;
+
+    // a power of two so that picking the shard is a mask
+    static constexpr std::size_t NUM_SHARDS = 16;
+    // interval between two sweeps of the forgotten addresses of a shard
+    static constexpr std::chrono::seconds SWEEP_INTERVAL{10};
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::mutex mutex;
+        Hosts hosts;
+        Clock::time_point lastSweep = Clock::now();
+    };
+
+    TokenBucket::Rate rate_;
+    // time after which an address' bucket is full again
+    Clock::duration forgetAfter_;
+    std::array<Shard, NUM_SHARDS> shards_;
+
+    Shard &getShard(const asio::ip::address &address);
+
+    /**
+     * @brief remove the addresses of the shard that didn't connect for
+     * forgetAfter_, its mutex must be held
+     */
+    void sweep(Shard &shard, Clock::time_point now);
+
+  public:
+    /**
+     * @param rate : the connections per second accepted from each address
+     */
+    explicit AcceptLimiter(TokenBucket::Rate rate);
+    ~AcceptLimiter() = default;
+
+    AcceptLimiter(const AcceptLimiter &) = delete;
+    AcceptLimiter &operator=(const AcceptLimiter &) = delete;
+
+    /**
+     * @brief count a connection from the given address
+     *
+     * @return false if the address is over its rate: the connection must be
+     * dropped
+     */
+    bool tryAccept(const asio::ip::address &address);
+};
+
+#endif // ACCEPT_LIMITER_HPP
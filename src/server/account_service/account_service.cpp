@@ -17,8 +17,11 @@
 
 #include "account_service.hpp"
 
+#include <algorithm>
 #include <bcrypt.h>
 #include <iostream>
+#include <thread>
+#include <utility>
 
 // ======== class account service ========
 
@@ -38,35 +41,79 @@ bool AccountService::checkCredentials(bindings::Authentication authentication) {
     return true;
 }
 
+void AccountService::appendRanking(
+    std::vector<bindings::RankingEntry> &ranking, size_t firstRank,
+    std::vector<std::tuple<UserID, std::string, Score>> &&users) const {
+    size_t rank = firstRank;
+    for (auto &[userID, username, score] : users) {
+        // the entries are sorted by rank
+        if (ranking.empty() || rank > ranking.back().rank) {
+            ranking.push_back(bindings::RankingEntry{
+                rank, std::move(username), score, userID});
+        }
+        ++rank;
+    }
+}
+
 // == public ==
+// half the cores at most, the others are left to the io and game threads
 AccountService::AccountService(std::shared_ptr<AccountManager> &accountManager)
-    : accountManager_(accountManager) {}
-
-bindings::RegistrationResponse
-AccountService::attemptCreateAccount(bindings::Registration registration) {
-    std::string hash = bcrypt::generateHash(registration.password);
-    CreateAccountStatus status =
-        accountManager_->createAccount(registration.nickname, hash);
-    return (status == CreateAccountStatus::SUCCESS)
-               ? bindings::RegistrationResponse{true}
-               : bindings::RegistrationResponse{false};
+    : accountManager_(accountManager),
+      bcryptWorkers_(std::max(1u, std::thread::hardware_concurrency() / 2),
+                     MAX_PENDING_BCRYPT_JOBS) {}
+
+void AccountService::attemptCreateAccount(bindings::Registration registration,
+                                          OnRegistrationResponse onResponse) {
+    const bool isSubmitted =
+        bcryptWorkers_.trySubmit([this, registration, onResponse]() {
+            std::string hash = bcrypt::generateHash(registration.password);
+            CreateAccountStatus status =
+                accountManager_->createAccount(registration.nickname, hash);
+            onResponse((status == CreateAccountStatus::SUCCESS)
+                           ? bindings::RegistrationResponse{true}
+                           : bindings::RegistrationResponse{false});
+        });
+
+    if (!isSubmitted) {
+        std::cerr << "Too many pending bcrypt operations, registration "
+                     "rejected"
+                  << std::endl;
+        onResponse(bindings::RegistrationResponse{false});
+    }
 }
 
-bindings::AuthenticationResponse
-AccountService::authenticationAttempt(bindings::Authentication authentication,
-                                      IsThisUserAlready isThisUserAlready) {
+void AccountService::authenticationAttempt(
+    bindings::Authentication authentication,
+    OnAuthenticationResponse onResponse) {
+    // whether the account is already in use is checked once logged in (see
+    // ClientRegistry::tryInsert), the bcrypt workers never read the registry
+    const bool isSubmitted =
+        bcryptWorkers_.trySubmit([this, authentication, onResponse]() {
+            onResponse(checkCredentials(authentication)
+                           ? bindings::AuthenticationResponse{true}
+                           : bindings::AuthenticationResponse{false});
+        });
 
-    return (checkCredentials(authentication)
-            && !(isThisUserAlready(
-                accountManager_->getUserId(authentication.nickname))))
-               ? bindings::AuthenticationResponse{true}
-               : bindings::AuthenticationResponse{false};
+    if (!isSubmitted) {
+        std::cerr << "Too many pending bcrypt operations, authentication "
+                     "rejected"
+                  << std::endl;
+        onResponse(bindings::AuthenticationResponse{false});
+    }
 }
 
 void AccountService::changePassword(UserID userID,
                                     bindings::ChangePassword changePassword) {
-    std::string hash = bcrypt::generateHash(changePassword.password);
-    accountManager_->updatePassword(userID, hash);
+    const bool isSubmitted = bcryptWorkers_.trySubmit(
+        [this, userID, password = std::move(changePassword.password)]() {
+            std::string hash = bcrypt::generateHash(password);
+            accountManager_->updatePassword(userID, hash);
+        });
+
+    if (!isSubmitted) {
+        std::cerr << "Too many pending bcrypt operations, password change of "
+                  << userID << " dropped" << std::endl;
+    }
 }
 
 bindings::ChangeUsernameResponse
@@ -81,20 +128,74 @@ AccountService::attemptChangeUsername(UserID userID,
     }
 }
 
-void AccountService::updateScore(UserID userID, int score) {
+std::optional<bindings::RankingDelta>
+AccountService::updateScore(UserID userID, int score) {
+    if (static_cast<Score>(score) <= accountManager_->getScore(userID)) {
+        return std::nullopt;
+    }
+
+    const size_t previousRank = accountManager_->getRank(userID);
     accountManager_->updateScore(userID, score);
+
+    return bindings::RankingDelta{
+        bindings::RankingEntry{accountManager_->getRank(userID),
+                               accountManager_->getUsername(userID),
+                               static_cast<Score>(score), userID},
+        previousRank};
 }
 
 std::shared_ptr<AccountManager> &AccountService::getAccountManager() {
     return accountManager_;
 }
 
+void AccountService::shutdown() { bcryptWorkers_.shutdown(); }
+
 std::string AccountService::getUsername(UserID userID) {
     return accountManager_->getUsername(userID);
 }
 UserID AccountService::getUserID(std::string username) {
     return accountManager_->getUserId(username);
 }
-std::vector<std::pair<std::string, size_t>> AccountService::getRanking() const {
-    return accountManager_->getRanking();
+bindings::Ranking AccountService::getRanking(UserID userID) const {
+    using bindings::Ranking;
+
+    const size_t ownRank = accountManager_->getRank(userID);
+    const Score ownScore = accountManager_->getScore(userID);
+    bindings::Ranking ranking{{}, ownRank};
+    appendRanking(ranking.ranking, 1,
+                  accountManager_->getRankingTop(Ranking::TOP_SIZE));
+
+    // the neighbours are read around the user's position, the ones already
+    // in the top are skipped
+    std::vector<std::tuple<UserID, std::string, Score>> neighbours =
+        accountManager_->getRankingBefore(
+            ownScore, userID, std::min(ownRank - 1, Ranking::NEIGHBOURS));
+    const size_t firstNeighbour = ownRank - neighbours.size();
+
+    neighbours.emplace_back(userID, accountManager_->getUsername(userID),
+                            ownScore);
+    for (auto &after : accountManager_->getRankingAfter(ownScore, userID,
+                                                        Ranking::NEIGHBOURS)) {
+        neighbours.push_back(std::move(after));
+    }
+    appendRanking(ranking.ranking, firstNeighbour, std::move(neighbours));
+
+    return ranking;
+}
+
+bindings::RankingPage AccountService::getRankingPage(
+    const bindings::RequestRankingPage &request) const {
+    using bindings::Ranking;
+
+    bindings::RankingPage rankingPage;
+    if (request.firstRank <= 1) {
+        appendRanking(rankingPage.ranking, 1,
+                      accountManager_->getRankingTop(Ranking::PAGE_SIZE));
+    } else {
+        appendRanking(rankingPage.ranking, request.firstRank,
+                      accountManager_->getRankingAfter(request.afterScore,
+                                                       request.afterPlayerId,
+                                                       Ranking::PAGE_SIZE));
+    }
+    return rankingPage;
 }
\ No newline at end of file
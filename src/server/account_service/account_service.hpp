@@ -21,6 +21,7 @@
 #include <asio.hpp>
 #include <nlohmann/json.hpp>
 
+#include "../bcrypt_worker_pool/bcrypt_worker_pool.hpp"
 #include "../database/account_manager/account_manager.hpp"
 
 #include "../../common/bindings/authentication.hpp"
@@ -28,13 +29,24 @@
 #include "../../common/bindings/change_password.hpp"
 #include "../../common/bindings/change_username.hpp"
 #include "../../common/bindings/change_username_response.hpp"
+#include "../../common/bindings/ranking.hpp"
+#include "../../common/bindings/ranking_delta.hpp"
+#include "../../common/bindings/ranking_page.hpp"
 #include "../../common/bindings/registration.hpp"
 #include "../../common/bindings/registration_response.hpp"
+#include "../../common/bindings/request_ranking_page.hpp"
 #include "../../common/bindings/user.hpp"
 #include "../../common/types/types.hpp"
 
-using IsThisUserAlready = std::function<bool(UserID)>;
+#include <functional>
+#include <optional>
+#include <tuple>
+
 using UpdateUsers = std::function<void(UserID)>;
+using OnAuthenticationResponse =
+    std::function<void(bindings::AuthenticationResponse)>;
+using OnRegistrationResponse =
+    std::function<void(bindings::RegistrationResponse)>;
 
 /**
  * @class AccountService
@@ -42,41 +54,55 @@ using UpdateUsers = std::function<void(UserID)>;
  * @brief Instance to manipulate all the operations on the database concerning
  * the creation, the changement on a user's account and its associated ranking
  * score.
+ *
+ * The passwords are hashed and checked on a few workers of their own (see
+ * BcryptWorkerPool), so the operations using them complete asynchronously.
  */
 class AccountService {
   private:
+    // authentications, registrations and password changes that can wait for
+    // a bcrypt worker, the next ones are rejected
+    static constexpr std::size_t MAX_PENDING_BCRYPT_JOBS = 128;
+
     std::shared_ptr<AccountManager> accountManager_;
+    BcryptWorkerPool bcryptWorkers_;
     bool checkCredentials(bindings::Authentication authentication);
 
+    /**
+     * @brief appends to the given entries the given users, ranked from the
+     * rank firstRank, skipping the ranks the entries already have
+     */
+    void appendRanking(
+        std::vector<bindings::RankingEntry> &ranking, size_t firstRank,
+        std::vector<std::tuple<UserID, std::string, Score>> &&users) const;
+
   public:
     AccountService(std::shared_ptr<AccountManager> &accountManager);
     ~AccountService() = default;
 
     /**
-     * @brief Receives a binding to create an account on the database
-     * and returns the response of the operation on the database
+     * @brief Receives a binding to create an account on the database and
+     * gives the response of the operation to onResponse, called from a bcrypt
+     * worker (or right away if there are too many operations pending)
      *
      * @param registration the binding
-     *
-     * @return a binding with the success or not to create the new account
+     * @param onResponse receives a binding with the success or not to create
+     * the new account
      */
-    bindings::RegistrationResponse
-    attemptCreateAccount(bindings::Registration registration);
+    void attemptCreateAccount(bindings::Registration registration,
+                              OnRegistrationResponse onResponse);
 
     /**
      * @brief Receives a binding to authenticate to an account on the database
-     * and returns the response of the operation on the database
+     * and gives the response of the operation to onResponse, called from a
+     * bcrypt worker (or right away if there are too many operations pending)
      *
      * @param  authentication the binding with the account's information
-     * @param  isThisUserAlreadyIn function to check if the account is not
-     * already connected
-     *
-     * @return a binding with the success or not to connect to the account
-     * wished
+     * @param  onResponse receives a binding with the success or not to connect
+     * to the account wished
      */
-    bindings::AuthenticationResponse
-    authenticationAttempt(bindings::Authentication authentication,
-                          IsThisUserAlready isThisUserAlready);
+    void authenticationAttempt(bindings::Authentication authentication,
+                               OnAuthenticationResponse onResponse);
 
     /**
      * @brief Retruns the success or not of the operation to change the username
@@ -95,7 +121,8 @@ class AccountService {
                           UpdateUsers updateUsers);
 
     /**
-     * @brief change password of an account on the database
+     * @brief change password of an account on the database, once a bcrypt
+     * worker has hashed it (dropped if there are too many operations pending)
      *
      * @param userID userID of the concerning account
      * @param changePassword binding with the changement's information
@@ -104,19 +131,28 @@ class AccountService {
     void changePassword(UserID userID, bindings::ChangePassword changePassword);
 
     /**
-     * @brief change the score associated to an account on the database
+     * @brief change the score associated to an account on the database, if
+     * it is its best one
      *
      * @param userID userID of the concerning account
      * @param score value of the new score
      *
+     * @return the move of the account in the ranking, nullopt if its best
+     * score didn't change
      */
-    void updateScore(UserID userID, int score);
+    std::optional<bindings::RankingDelta> updateScore(UserID userID,
+                                                      int score);
 
     /**
      * @brief returns a shared pointer to the database manager
      */
     std::shared_ptr<AccountManager> &getAccountManager();
 
+    /**
+     * @brief stop the bcrypt workers, dropping the pending operations
+     */
+    void shutdown();
+
     /**
      * @brief returns the username of a given userID
      */
@@ -128,9 +164,16 @@ class AccountService {
     UserID getUserID(std::string username);
 
     /**
-     * @brief returns a vector representing the global ranking on the database
+     * @brief returns the part of the ranking shown to the given user: the
+     * top of the ranking and the user's neighbours
+     */
+    bindings::Ranking getRanking(UserID userID) const;
+
+    /**
+     * @brief returns the page of the ranking asked by a client
      */
-    std::vector<std::pair<std::string, size_t>> getRanking() const;
+    bindings::RankingPage
+    getRankingPage(const bindings::RequestRankingPage &request) const;
 };
 
 #endif
\ No newline at end of file
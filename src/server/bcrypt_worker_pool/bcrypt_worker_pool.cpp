@@ -0,0 +1,84 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "bcrypt_worker_pool.hpp"
+
+#include <utility>
+
+// ====== BcryptWorkerPool class ======
+
+// --- private ---
+
+void BcryptWorkerPool::work() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock,
+                     [this]() { return isStopped_ || !pendingJobs_.empty(); });
+            if (isStopped_) {
+                return;
+            }
+
+            job = std::move(pendingJobs_.front());
+            pendingJobs_.pop_front();
+        }
+
+        job();
+    }
+}
+
+// --- public ---
+
+BcryptWorkerPool::BcryptWorkerPool(unsigned numWorkers,
+                                   std::size_t maxPendingJobs)
+    : maxPendingJobs_(maxPendingJobs) {
+    workers_.reserve(numWorkers);
+    for (unsigned i = 0; i < numWorkers; ++i) {
+        workers_.emplace_back([this]() { work(); });
+    }
+}
+
+BcryptWorkerPool::~BcryptWorkerPool() { shutdown(); }
+
+bool BcryptWorkerPool::trySubmit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (isStopped_ || pendingJobs_.size() >= maxPendingJobs_) {
+            return false;
+        }
+        pendingJobs_.push_back(std::move(job));
+    }
+
+    cv_.notify_one();
+    return true;
+}
+
+void BcryptWorkerPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopped_ = true;
+        pendingJobs_.clear();
+    }
+
+    cv_.notify_all();
+    for (std::thread &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
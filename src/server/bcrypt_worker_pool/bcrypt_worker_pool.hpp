@@ -0,0 +1,84 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BCRYPT_WORKER_POOL_HPP
+#define BCRYPT_WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class BcryptWorkerPool
+ *
+ * @brief Runs the password hashings and checks, which take tens to hundreds
+ * of milliseconds of CPU on purpose, on a few dedicated threads instead of
+ * the io threads.
+ *
+ * The jobs are run in the order they are submitted. There can only be a
+ * bounded number of them waiting: past that, they are rejected at once so
+ * that a login storm is answered quickly instead of piling up.
+ */
+class BcryptWorkerPool {
+  public:
+    using Job = std::function<void()>;
+
+  private:
+    std::size_t maxPendingJobs_;
+    std::deque<Job> pendingJobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool isStopped_ = false;
+    std::vector<std::thread> workers_;
+
+    /**
+     * @brief run by the workers: run the pending jobs until the pool is
+     * stopped
+     */
+    void work();
+
+  public:
+    /**
+     * @param numWorkers : the number of jobs run at the same time
+     * @param maxPendingJobs : the number of jobs that can wait for a worker
+     */
+    BcryptWorkerPool(unsigned numWorkers, std::size_t maxPendingJobs);
+    ~BcryptWorkerPool();
+
+    BcryptWorkerPool(const BcryptWorkerPool &) = delete;
+    BcryptWorkerPool &operator=(const BcryptWorkerPool &) = delete;
+
+    /**
+     * @brief queue the job for a worker, from any thread
+     *
+     * @return false if there are already too many jobs waiting (or the pool
+     * is stopped): the job isn't run
+     */
+    bool trySubmit(Job job);
+
+    /**
+     * @brief drop the pending jobs and join the workers once their current
+     * job is done
+     */
+    void shutdown();
+};
+
+#endif // BCRYPT_WORKER_POOL_HPP
@@ -0,0 +1,130 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOUNDED_MPSC_QUEUE_HPP
+#define BOUNDED_MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "../cache_line/cache_line.hpp"
+
+/**
+ * @class BoundedMpscQueue
+ *
+ * @brief A fixed size, lock-free queue handing values from any number of
+ * threads (the producers) to a single thread or strand (the consumer).
+ *
+ * Each cell has a sequence number telling whether it is free for the
+ * producer of a position or filled for the consumer, so a push or a pop is a
+ * couple of atomic operations, without locks nor allocation.
+ *
+ * @tparam Capacity : the maximum number of values in the queue, a power of
+ * two
+ */
+template <typename T, std::size_t Capacity> class BoundedMpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "the capacity must be a power of two");
+
+  private:
+    struct Cell {
+        // == position: free for the producer of that position
+        // == position + 1: filled, for the consumer
+        std::atomic<std::size_t> sequence;
+        std::optional<T> value;
+    };
+
+    static constexpr std::size_t MASK = Capacity - 1;
+    std::array<Cell, Capacity> cells_;
+    // the positions are on different cache lines, so that the producers and
+    // the consumer don't invalidate each other's
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> pushPosition_ = 0;
+    // only used by the consumer
+    alignas(CACHE_LINE_SIZE) std::size_t popPosition_ = 0;
+
+  public:
+    BoundedMpscQueue() {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue &) = delete;
+    BoundedMpscQueue &operator=(const BoundedMpscQueue &) = delete;
+
+    /**
+     * @brief Adds the value at the back of the queue, from any thread.
+     *
+     * @return false (and leaves the value untouched) if the queue is full
+     */
+    bool tryPush(T &&value) {
+        std::size_t position = pushPosition_.load(std::memory_order_relaxed);
+        Cell *cell;
+        while (true) {
+            cell = &cells_[position & MASK];
+            const std::size_t sequence =
+                cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence)
+                              - static_cast<std::intptr_t>(position);
+
+            if (diff == 0) {
+                // the cell is free: claim the position
+                if (pushPosition_.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the consumer hasn't popped the value a lap ago yet
+                return false;
+            } else {
+                // another producer claimed the position
+                position = pushPosition_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value.emplace(std::move(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the value at the front of the queue. Must only be
+     * called by the consumer.
+     *
+     * @return nullopt if the queue is empty (or if the value at the front is
+     * still being pushed)
+     */
+    std::optional<T> tryPop() {
+        Cell &cell = cells_[popPosition_ & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != popPosition_ + 1) {
+            return std::nullopt;
+        }
+
+        std::optional<T> value = std::move(cell.value);
+        cell.value.reset();
+        // free for the producer of the position a lap later
+        cell.sequence.store(popPosition_ + Capacity, std::memory_order_release);
+        ++popPosition_;
+        return value;
+    }
+};
+
+#endif // BOUNDED_MPSC_QUEUE_HPP
@@ -17,7 +17,11 @@
 
 #include "client_link.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+
+#include "../../common/bindings/authentication_response.hpp"
 
 // ====== tcp connection class ======
 
@@ -26,50 +30,179 @@
 void ClientLink::read() {
     asio::async_read_until(
         socket_, streamBuffer_, bindings::PACKET_DELIMITER,
-        [this](asio::error_code ec, std::size_t) {
+        [this, self = shared_from_this()](asio::error_code ec,
+                                          std::size_t length) {
             if (!ec) {
 
-                handleReading();
-            } else if (ec == asio::error::eof) {
-                handleErrorReading();
+                handleReading(length);
+            } else if (ec == asio::error::not_found) {
+                // the buffer is full without a delimiter
+                handleOversizedPackage();
+            } else {
+                closeConnection();
             }
         });
 }
 
-bool ClientLink::checkPackage(std::string &package) {
+void ClientLink::readFraming() {
+    asio::async_read(
+        socket_, streamBuffer_,
+        asio::transfer_at_least(bindings::FRAMING_MAGIC.size()),
+        [this, self = shared_from_this()](asio::error_code ec, std::size_t) {
+            if (ec) {
+                closeConnection();
+                return;
+            }
+
+            const std::string_view received{
+                static_cast<const char *>(streamBuffer_.data().data()),
+                bindings::FRAMING_MAGIC.size()};
+            if (received != bindings::FRAMING_MAGIC) {
+                // newline framing: the bytes are the start of a packet
+                read();
+                return;
+            }
+
+            isFramed_ = true;
+            streamBuffer_.consume(bindings::FRAMING_MAGIC.size());
+            readFrames();
+        });
+}
+
+void ClientLink::readFrames() {
+    // handles the frames already read, then reads the missing bytes of the
+    // next one
+    while (streamBuffer_.size() >= bindings::FRAME_HEADER_SIZE) {
+        const char *data =
+            static_cast<const char *>(streamBuffer_.data().data());
+        const uint32_t length =
+            bindings::decodeFrameHeader(std::span<const char,
+                                                  bindings::FRAME_HEADER_SIZE>{
+                data, bindings::FRAME_HEADER_SIZE});
+
+        if (length > bindings::MAX_CLIENT_PACKET_SIZE) {
+            handleOversizedPackage();
+            return;
+        }
+
+        const std::size_t frameSize = bindings::FRAME_HEADER_SIZE + length;
+        if (streamBuffer_.size() < frameSize) {
+            readFramesUntil(frameSize);
+            return;
+        }
+
+        // parsed in place, straight from the read buffer
+        handlePackage(
+            std::string_view{data + bindings::FRAME_HEADER_SIZE, length});
+        streamBuffer_.consume(frameSize);
+    }
+
+    readFramesUntil(bindings::FRAME_HEADER_SIZE);
+}
+
+void ClientLink::readFramesUntil(std::size_t size) {
+    asio::async_read(socket_, streamBuffer_,
+                     asio::transfer_at_least(size - streamBuffer_.size()),
+                     [this, self = shared_from_this()](asio::error_code ec,
+                                                       std::size_t) {
+                         if (!ec) {
+                             readFrames();
+                         } else {
+                             closeConnection();
+                         }
+                     });
+}
+
+void ClientLink::handleOversizedPackage() {
+    std::cerr << "Received packet is too big, dropping the client"
+              << std::endl;
 
-    nlohmann::json checkJson;
+    closeConnection();
+}
+
+std::optional<bindings::ClientPacket>
+ClientLink::parsePackage(
+    std::string_view package,
+    const std::optional<bindings::FlatPacket> &flatPacket) {
     try {
-        checkJson = nlohmann::json::parse(package);
+        return bindings::parseClientPacket(package, flatPacket);
     } catch (nlohmann::json::parse_error &e) {
         std::cerr << "Received packet is not valid JSON: " << e.what()
                   << std::endl;
-        return false;
-    }
-
-    try {
-        checkJson.at("type").get<bindings::BindingType>();
     } catch (nlohmann::json::exception &e) {
-        std::cerr << "Received packet has no type  : " << e.what() << std::endl;
-        return false;
+        std::cerr << "Received packet has wrong format : " << e.what()
+                  << std::endl;
+    } catch (std::runtime_error &e) {
+        std::cerr << "Received packet has wrong type : " << e.what()
+                  << std::endl;
     }
 
-    return true;
+    return std::nullopt;
 }
 
-void ClientLink::handleReading() {
-    std::istream is(&streamBuffer_);
-    std::string packet;
-    std::getline(is, packet);
-    // check if the package has the correct format
-    if (!checkPackage(packet)) {
+void ClientLink::handlePackage(std::string_view package) {
+    // the packages already read when the client was dropped
+    if (isClosed_) {
         return;
     }
-    if (getUserState() == bindings::State::Offline) {
-        handleAuthentication(packet);
-    } else {
-        packetHandler_(packet, clientId.value());
+    lastReceived_ = std::chrono::steady_clock::now();
+
+    // read once without allocating: it gives the type of an in-game packet
+    // to the rate limits, checked before the full parsing so that a flood
+    // costs as little as possible, then the binding of an in-game input
+    const std::optional<bindings::FlatPacket> flatPacket =
+        bindings::FlatPacket::parse(package);
+
+    if (getUserState() == bindings::State::InGame) {
+        const bool isControl =
+            flatPacket.has_value()
+            && bindings::isGameControlBinding(flatPacket->getType());
+
+        // a control binding isn't sent again, it has its own bucket so that
+        // a flood of inputs can't make the client lose it
+        TokenBucket &bucket =
+            isControl ? gameControlsBucket_ : gameInputsBucket_;
+        if (!bucket.tryTake()) {
+            handleRateLimitedPackage();
+            return;
+        }
+    } else if (!menuRequestsBucket_.tryTake()) {
+        handleRateLimitedPackage();
+        return;
     }
+
+    std::optional<bindings::ClientPacket> packet =
+        parsePackage(package, flatPacket);
+
+    // a malformed package is dropped, the next ones are still read
+    if (packet.has_value()) {
+        if (const auto *pPong = std::get_if<bindings::Pong>(&*packet)) {
+            handlePong(*pPong);
+        } else if (getUserState() == bindings::State::Offline) {
+            handleAuthentication(*packet);
+        } else {
+            packetHandler_(std::move(*packet), clientId.value());
+        }
+    }
+}
+
+void ClientLink::handleRateLimitedPackage() {
+    metrics_.recordRateLimitedPackage();
+    if (!droppedPacketsBucket_.tryTake()) {
+        std::cerr << "Client keeps sending packets over its rate, dropping it"
+                  << std::endl;
+        metrics_.recordRateLimitEviction();
+        closeConnection();
+    }
+}
+
+void ClientLink::handleReading(std::size_t length) {
+    // parsed straight from the read buffer, without its delimiter
+    handlePackage(
+        std::string_view{static_cast<const char *>(streamBuffer_.data().data()),
+                         length - bindings::PACKET_DELIMITER.size()});
+    streamBuffer_.consume(length);
+
     read();
 }
 
@@ -78,51 +211,285 @@ void ClientLink::handleErrorReading() {
     removeClientCallback_(clientId);
 }
 
-void ClientLink::handleAuthentication(std::string &packet) {
+void ClientLink::closeConnection() {
+    // the pending read completes with an error once the socket is closed
+    if (isClosed_) {
+        return;
+    }
+    isClosed_ = true;
+
+    heartbeatTimer_.cancel();
+    asio::error_code ec;
+    socket_.close(ec);
+    handleErrorReading();
+}
+
+void ClientLink::armHeartbeat() {
+    // a Ping can go unanswered twice before the client is disconnected
+    heartbeatTimer_.expires_after(
+        std::chrono::duration_cast<std::chrono::milliseconds>(idleTimeout_)
+        / 3);
+    heartbeatTimer_.async_wait(
+        [this, self = shared_from_this()](asio::error_code ec) {
+            if (!ec && !isClosed_) {
+                onHeartbeat();
+            }
+        });
+}
 
-    nlohmann::json jsonPacket = nlohmann::json::parse(packet);
-    std::optional<nlohmann::json> response = authPacketHandler_(jsonPacket);
-    if (response && !(response->is_null())) {
-        sendPackage(response.value());
+void ClientLink::onHeartbeat() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lastReceived_ >= idleTimeout_) {
+        std::cerr << "Client silent for " << idleTimeout_.count()
+                  << "s, dropping it" << std::endl;
+        metrics_.recordIdleEviction();
+        closeConnection();
+        return;
+    }
+
+    // without its Pong, the previous Ping is still the one to measure
+    if (!pendingPingID_.has_value()) {
+        pendingPingID_ = nextPingID_++;
+        pingSentAt_ = now;
+        sendPackage(bindings::Ping{*pendingPingID_}.to_json());
+    }
+    armHeartbeat();
+}
+
+void ClientLink::handlePong(const bindings::Pong &pong) {
+    if (pendingPingID_ != pong.id) {
+        return;
+    }
+    pendingPingID_.reset();
+
+    const auto rtt = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - pingSentAt_);
+    metrics_.recordRtt(rtt);
+
+    // exponentially weighted moving average, the one TCP uses
+    const int64_t smoothedRttUs = smoothedRttUs_.load();
+    smoothedRttUs_ = smoothedRttUs < 0
+                         ? rtt.count()
+                         : smoothedRttUs
+                               + (rtt.count() - smoothedRttUs)
+                                     / RTT_SMOOTHING_DIVISOR;
+}
+
+void ClientLink::handleAuthentication(const bindings::ClientPacket &packet) {
+    // one password checked at a time per client, so that a client can't
+    // fill the bcrypt workers' queue on its own
+    if (isAuthenticationPending_) {
+        std::cerr << "Authentication package received while another one is "
+                     "being checked, dropped"
+                  << std::endl;
+        return;
+    }
+
+    std::optional<bindings::Authentication> authentication;
+    if (const auto *pAuthentication =
+            std::get_if<bindings::Authentication>(&packet)) {
+        authentication = *pAuthentication;
+    }
 
-        if (response.value()
-                    .at(bindings::PACKET_TYPE_FIELD)
-                    .get<bindings::BindingType>()
-                == bindings::BindingType::AuthenticationResponse
-            && response.value().at("data").at("success").get<bool>()) {
-            authSuccessCallback_(shared_from_this(), jsonPacket.at("data"));
-            userState = bindings::State::Menu;
-            mustBeDeletedFromTheWaitingForAuthList_ = true;
+    isAuthenticationPending_ = authPacketHandler_(
+        packet,
+        [this, self = shared_from_this(),
+         authentication = std::move(authentication)](nlohmann::json response) {
+            // back from the bcrypt worker to the socket's strand
+            asio::post(socket_.get_executor(),
+                       [this, self, authentication,
+                        response = std::move(response)]() {
+                           handleAuthenticationResponse(authentication,
+                                                        response);
+                       });
+        });
+}
+
+void ClientLink::handleAuthenticationResponse(
+    const std::optional<bindings::Authentication> &authentication,
+    const nlohmann::json &response) {
+    isAuthenticationPending_ = false;
+    // the client left while its password was being checked
+    if (mustBeDeletedFromTheWaitingForAuthList_) {
+        return;
+    }
+
+    if (!authentication.has_value()
+        || !response.at("data").at("success").get<bool>()) {
+        sendPackage(response);
+        return;
+    }
+
+    // the response is sent by the ClientManager along with the menu, unless
+    // the account was logged in by another client in the meantime
+    if (!authSuccessCallback_(shared_from_this(), *authentication)) {
+        sendPackage(bindings::AuthenticationResponse{false}.to_json());
+        return;
+    }
+    userState = bindings::State::Menu;
+    mustBeDeletedFromTheWaitingForAuthList_ = true;
+}
+
+void ClientLink::writeSocket() {
+    writingPackages_.assign(std::make_move_iterator(writeQueue_.begin()),
+                            std::make_move_iterator(writeQueue_.end()));
+    writeQueue_.clear();
+
+    // the framing and the shared payload of each package, gathered in a
+    // single write
+    std::vector<asio::const_buffer> buffers;
+    buffers.reserve(2 * writingPackages_.size());
+    for (const OutboundPackage &package : writingPackages_) {
+        if (isFramed_) {
+            buffers.push_back(asio::buffer(package.header));
+            buffers.push_back(asio::buffer(*package.payload));
+        } else {
+            buffers.push_back(asio::buffer(*package.payload));
+            buffers.push_back(asio::buffer(bindings::PACKET_DELIMITER.data(),
+                                           bindings::PACKET_DELIMITER.size()));
         }
     }
+
+    asio::async_write(socket_, buffers,
+                      [this, self = shared_from_this()](asio::error_code ec,
+                                                        std::size_t) {
+                          for (const OutboundPackage &package :
+                               writingPackages_) {
+                              queuedBytes_ -= package.payload->size();
+                          }
+                          writingPackages_.clear();
+
+                          if (ec) {
+                              // the reading side removes the client
+                              writeQueue_.clear();
+                              queuedBytes_ = 0;
+                          } else if (!writeQueue_.empty()) {
+                              writeSocket();
+                          }
+                      });
 }
 
-void ClientLink::writeSocket(std::string &content) {
-    asio::async_write(
-        socket_, asio::buffer(content),
-        [this](asio::error_code ec, std::size_t length) {
-            if (!ec) {
-                buffer_.erase(0, length);
+void ClientLink::enqueuePackage(std::shared_ptr<const Buffer> package,
+                                bool isGameState) {
+    if (isSlowReader_.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const bindings::FrameHeader header =
+        bindings::encodeFrameHeader(static_cast<uint32_t>(package->size()));
+    if (!pendingPackages_.tryPush(
+            OutboundPackage{std::move(package), header, isGameState})) {
+        // the strand hasn't run for MAX_PENDING_PACKAGES sends: a GameState
+        // is replaced by the next one, any other package can't be lost
+        if (!isGameState && !isSlowReader_.exchange(true)) {
+            asio::post(socket_.get_executor(),
+                       [this, self = shared_from_this()]() {
+                           handleSlowReader();
+                       });
+        }
+        return;
+    }
+
+    // a single post for all the packages sent until the strand runs
+    if (!isDrainPosted_.exchange(true, std::memory_order_acq_rel)) {
+        asio::post(socket_.get_executor(),
+                   [this, self = shared_from_this()]() {
+                       drainPendingPackages();
+                   });
+    }
+}
+
+void ClientLink::drainPendingPackages() {
+    // reset first: a package pushed from now on posts another drain
+    isDrainPosted_.exchange(false, std::memory_order_acq_rel);
+
+    while (std::optional<OutboundPackage> package =
+               pendingPackages_.tryPop()) {
+        if (!isSlowReader_) {
+            queuedBytes_ += package->payload->size();
+            writeQueue_.push_back(std::move(*package));
+        }
+    }
+
+    if (queuedBytes_ > MAX_QUEUED_BYTES) {
+        dropStaleGameStates();
+    }
+    if (queuedBytes_ > MAX_QUEUED_BYTES) {
+        isSlowReader_ = true;
+        for (const OutboundPackage &queuedPackage : writeQueue_) {
+            queuedBytes_ -= queuedPackage.payload->size();
+        }
+        writeQueue_.clear();
+        handleSlowReader();
+        return;
+    }
+
+    if (writingPackages_.empty() && !writeQueue_.empty()) {
+        writeSocket();
+    }
+}
+
+void ClientLink::dropStaleGameStates() {
+    auto newest = std::find_if(
+        writeQueue_.rbegin(), writeQueue_.rend(),
+        [](const OutboundPackage &package) { return package.isGameState; });
+    if (newest == writeQueue_.rend()) {
+        return;
+    }
+
+    // the client asks for a full GameState if it misses the base of a
+    // GameStateDelta
+    const auto stale = std::remove_if(
+        writeQueue_.begin(), std::prev(newest.base()),
+        [this](const OutboundPackage &package) {
+            if (package.isGameState) {
+                queuedBytes_ -= package.payload->size();
             }
+            return package.isGameState;
         });
+    writeQueue_.erase(stale, std::prev(newest.base()));
+}
+
+void ClientLink::handleSlowReader() {
+    std::cerr << "Client doesn't read its packets fast enough, dropping it"
+              << std::endl;
+
+    closeConnection();
 }
 
 // --- public ---
 ClientLink::ClientLink(tcp::socket socket, PacketHandler packetHandler,
                        AuthPacketHandler authPacketHandler,
                        AuthSuccessCallback authSuccessCallback,
-                       RemoveClientCallback removeClientCallback)
-    : socket_(std::move(socket)), userState(bindings::State::Offline),
+                       RemoveClientCallback removeClientCallback,
+                       const ConnectionLimits &limits,
+                       ServerMetrics &metrics)
+    : socket_(std::move(socket)), heartbeatTimer_(socket_.get_executor()),
+      idleTimeout_(limits.idleTimeout),
+      lastReceived_(std::chrono::steady_clock::now()),
+      gameInputsBucket_(limits.gameInputs),
+      gameControlsBucket_(GAME_CONTROLS_RATE),
+      menuRequestsBucket_(limits.menuRequests),
+      droppedPacketsBucket_(DROPPED_PACKETS_RATE), metrics_(metrics),
+      streamBuffer_(bindings::FRAME_HEADER_SIZE
+                    + bindings::MAX_CLIENT_PACKET_SIZE),
+      userState(bindings::State::Offline),
       clientId(std::nullopt), gameMode_(std::nullopt),
       packetHandler_(packetHandler), authPacketHandler_(authPacketHandler),
       authSuccessCallback_(authSuccessCallback),
       removeClientCallback_(removeClientCallback) {
-    start();
+    metrics_.recordConnectionOpened();
 }
 
-void ClientLink::start() { read(); }
+ClientLink::~ClientLink() { metrics_.recordConnectionClosed(); }
+
+void ClientLink::start() {
+    readFraming();
+    armHeartbeat();
+}
 
 void ClientLink::jointGame(const std::weak_ptr<GameServer> &gameServer) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     pGame_ = gameServer;
 }
 
@@ -132,30 +499,72 @@ void ClientLink::exitGame() {
     resetGame();
 }
 
-void ClientLink::resetGame() { pGame_.reset(); }
+void ClientLink::resetGame() {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    pGame_.reset();
+}
 
 bool ClientLink::shouldItBeDeletedFromTheList() {
     return mustBeDeletedFromTheWaitingForAuthList_;
 }
 
 void ClientLink::sendPackage(nlohmann::json package) {
-    buffer_ = package.dump().append(bindings::PACKET_DELIMITER);
-    writeSocket(buffer_);
+    sendShared(makeSharedPackage(package));
 }
 
-void ClientLink::setClientId(const int id) { clientId = id; }
+void ClientLink::sendSerializedPackage(std::string package) {
+    sendShared(std::make_shared<const Buffer>(std::move(package)));
+}
+
+void ClientLink::sendShared(std::shared_ptr<const Buffer> package) {
+    enqueuePackage(std::move(package), false);
+}
+
+void ClientLink::sendGameState(std::shared_ptr<const Buffer> package) {
+    enqueuePackage(std::move(package), true);
+}
+
+std::shared_ptr<const ClientLink::Buffer>
+ClientLink::makeSharedPackage(const nlohmann::json &package) {
+    return std::make_shared<const Buffer>(package.dump());
+}
+
+void ClientLink::setClientId(std::optional<UserID> id) { clientId = id; }
 
 void ClientLink::setUserState(bindings::State newState) {
     userState = newState;
 }
 void ClientLink::setGameMode(std::optional<GameMode> newGameMode) {
+    std::lock_guard<std::mutex> lock(stateMutex_);
     gameMode_ = newGameMode;
 }
 
-std::optional<GameMode> ClientLink::getGameMode() { return gameMode_; }
+void ClientLink::setFeatures(bindings::ClientFeatures features) {
+    features_ = features;
+}
+
+bool ClientLink::hasFeature(bindings::ClientFeature feature) const {
+    return bindings::hasFeature(features_, feature);
+}
+
+std::optional<GameMode> ClientLink::getGameMode() {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return gameMode_;
+}
 
 bindings::State ClientLink::getUserState() { return userState; }
 
 UserID ClientLink::getUserID() { return clientId.value(); }
 
-std::weak_ptr<GameServer> ClientLink::getGameServer() { return pGame_; }
+std::weak_ptr<GameServer> ClientLink::getGameServer() {
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return pGame_;
+}
+
+std::optional<std::chrono::microseconds> ClientLink::getSmoothedRtt() const {
+    const int64_t smoothedRttUs = smoothedRttUs_.load();
+    if (smoothedRttUs < 0) {
+        return std::nullopt;
+    }
+    return std::chrono::microseconds{smoothedRttUs};
+}
@@ -19,19 +19,46 @@
 #define CLIENT_LINK_HPP
 
 #include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "../../common/bindings/client_features.hpp"
+#include "../../common/bindings/client_packet.hpp"
+#include "../../common/bindings/framing.hpp"
+#include "../../common/bindings/ping.hpp"
 #include "../../common/bindings/user.hpp"
 #include "../../common/bindings/user_state.hpp"
 
 #include "../../common/tetris_royal_lib/game_mode/game_mode.hpp"
+#include "../bounded_mpsc_queue/bounded_mpsc_queue.hpp"
+#include "../server_metrics/server_metrics.hpp"
+#include "../token_bucket/token_bucket.hpp"
 
 using asio::ip::tcp;
 
 class GameServer;
 
+/**
+ * @brief The limits applied to each connection, the same for all the clients.
+ */
+struct ConnectionLimits {
+    // the time after which a silent client is disconnected
+    std::chrono::seconds idleTimeout;
+    // the packets a client can send while in game (to the game server)
+    TokenBucket::Rate gameInputs;
+    // the packets a client can send otherwise (menu, authentication)
+    TokenBucket::Rate menuRequests;
+};
+
 /**
  * @class ClientLink
  *
@@ -41,23 +68,105 @@ class GameServer;
  */
 class ClientLink : public std::enable_shared_from_this<ClientLink> {
 
+  public:
+    // a package already dumped, immutable so that a package sent to several
+    // clients is serialized once and shared by all their writes
+    using Buffer = std::string;
+
+  private:
     using PacketHandler =
-        std::function<void(const std::string &, const int clientId)>;
-    using AuthPacketHandler = std::function<nlohmann::json(nlohmann::json)>;
-    using AuthSuccessCallback =
-        std::function<void(std::shared_ptr<ClientLink>, nlohmann::json)>;
+        std::function<void(bindings::ClientPacket &&, const int clientId)>;
+    using AuthResponseCallback = std::function<void(nlohmann::json)>;
+    // returns false if the packet isn't handled, else the callback is called
+    // with the response later on, from any thread
+    using AuthPacketHandler = std::function<bool(
+        const bindings::ClientPacket &, AuthResponseCallback)>;
+    // returns false if the client couldn't be logged in after all
+    using AuthSuccessCallback = std::function<bool(
+        std::shared_ptr<ClientLink>, const bindings::Authentication &)>;
 
     using RemoveClientCallback = std::function<void(std::optional<UserID>)>;
 
-  private:
+    // a package waiting to be written, with the client's framing around
+    // its shared payload
+    struct OutboundPackage {
+        std::shared_ptr<const Buffer> payload;
+        bindings::FrameHeader header;
+        // a newer GameState makes it useless (see sendGameState())
+        bool isGameState;
+    };
+
+    // bytes a client can have waiting to be written (queued or being
+    // written) before the slow reader policy kicks in (see
+    // drainPendingPackages())
+    static constexpr std::size_t MAX_QUEUED_BYTES = 1024 * 1024;
+    // packages the other threads can send before the strand takes them
+    static constexpr std::size_t MAX_PENDING_PACKAGES = 256;
+
+    // weight of a new round trip time in the smoothed one
+    static constexpr int64_t RTT_SMOOTHING_DIVISOR = 8;
+    // the packets over its limits a client can send before being
+    // disconnected: a burst of them, then one every second
+    static constexpr TokenBucket::Rate DROPPED_PACKETS_RATE{1, 50};
+    // the in-game control bindings a client can send (see
+    // bindings::isGameControlBinding): each may cost the game a full
+    // snapshot or resync, a client sends a few of them at most
+    static constexpr TokenBucket::Rate GAME_CONTROLS_RATE{1, 5};
+
     tcp::socket socket_;
-    std::string buffer_;
+    // pings the client and disconnects it once it stays silent for
+    // idleTimeout_ (see onHeartbeat()), on the socket's strand
+    asio::steady_timer heartbeatTimer_;
+    std::chrono::seconds idleTimeout_;
+    std::chrono::steady_clock::time_point lastReceived_;
+    // the Ping waiting for its Pong, if any
+    std::optional<uint64_t> pendingPingID_;
+    std::chrono::steady_clock::time_point pingSentAt_;
+    uint64_t nextPingID_ = 0;
+    // read by the matchmaking from the other threads, negative until the
+    // first Pong
+    std::atomic<int64_t> smoothedRttUs_ = -1;
+    // set once the connection is closed, so that the client is removed once
+    bool isClosed_ = false;
+    // the rates of the packets received, owned by the socket's strand
+    TokenBucket gameInputsBucket_;
+    TokenBucket gameControlsBucket_;
+    TokenBucket menuRequestsBucket_;
+    TokenBucket droppedPacketsBucket_;
+    ServerMetrics &metrics_;
+    // handed over without locks by the sending threads (io and game
+    // threads) to the socket's strand, which owns everything below
+    BoundedMpscQueue<OutboundPackage, MAX_PENDING_PACKAGES> pendingPackages_;
+    // true from the moment a drainPendingPackages() is posted until it starts
+    std::atomic<bool> isDrainPosted_ = false;
+    // the packages queued while a write is in flight, written together once
+    // it is done
+    std::deque<OutboundPackage> writeQueue_;
+    // the packages being written, empty if there's no write in flight
+    std::vector<OutboundPackage> writingPackages_;
+    std::size_t queuedBytes_ = 0;
+    // set when the client is dropped for not reading fast enough, the
+    // packages sent from then on are discarded
+    std::atomic<bool> isSlowReader_ = false;
+    // read buffer, reused for every packet (see bindings/framing.hpp for
+    // both framings)
     asio::streambuf streamBuffer_;
-    bool mustBeDeletedFromTheWaitingForAuthList_ = false;
-    bindings::State userState;
+    // true if the client chose the length-prefixed framing
+    bool isFramed_ = false;
+    // true while the password sent by the client is being checked, owned by
+    // the socket's strand
+    bool isAuthenticationPending_ = false;
+    // read by the ClientManager from the other clients' strands
+    std::atomic<bool> mustBeDeletedFromTheWaitingForAuthList_ = false;
+    std::atomic<bindings::State> userState;
+    // set once at login, before the link is shared with other threads
     std::optional<UserID> clientId;
+    // guards gameMode_ and pGame_, used by the io and the game threads
+    mutable std::mutex stateMutex_;
     std::optional<GameMode> gameMode_;
     std::weak_ptr<GameServer> pGame_;
+    // optional protocol features advertised by the client at login
+    bindings::ClientFeatures features_ = 0;
 
     // std function to manage packages
     PacketHandler packetHandler_;
@@ -70,20 +179,55 @@ class ClientLink : public std::enable_shared_from_this<ClientLink> {
     RemoveClientCallback removeClientCallback_;
 
     /**
-     *@brief : call if client is not logged in, send package to ClientManager
-     *and wait for a response
-     *@param packet : string wich contains the package
+     *@brief : call if client is not logged in, send package to ClientManager,
+     *which responds asynchronously (see handleAuthenticationResponse())
+     *@param packet : the parsed package
      */
-    void handleAuthentication(std::string &packet);
+    void handleAuthentication(const bindings::ClientPacket &packet);
 
     /**
-     * @brief check the packet
-     * and gives the packet to handleAuthentication or handlePacket
-     * (clientManager) depending on the User state
-     *
-     *
+     *@brief : send the response to the client and, if they are logged in,
+     *notify the ClientManager. Must be called on the socket's strand.
+     *@param authentication : the package if it was an authentication
+     *@param response : the response of the package
+     */
+    void handleAuthenticationResponse(
+        const std::optional<bindings::Authentication> &authentication,
+        const nlohmann::json &response);
+
+    /**
+     * @brief parse the packet and gives it to handleAuthentication or
+     * handlePacket (clientManager) depending on the User state
+     */
+    void handlePackage(std::string_view package);
+
+    /**
+     * @brief handle the packet of the given length (delimiter included) at
+     * the front of the read buffer (newline framing)
+     */
+    void handleReading(std::size_t length);
+
+    /**
+     * @brief reads the first bytes sent by the client to know its framing
      */
-    void handleReading();
+    void readFraming();
+
+    /**
+     * @brief handle the frames at the front of the read buffer and read the
+     * next ones (length-prefixed framing)
+     */
+    void readFrames();
+
+    /**
+     * @brief read until the read buffer has the given size, then call
+     * readFrames()
+     */
+    void readFramesUntil(std::size_t size);
+
+    /**
+     * @brief drop the client, which sent a packet bigger than allowed
+     */
+    void handleOversizedPackage();
 
     /**
      * @brief handler in case of an error reading : suppress the client link
@@ -92,29 +236,97 @@ class ClientLink : public std::enable_shared_from_this<ClientLink> {
      */
     void handleErrorReading();
 
+    /**
+     * @brief close the socket and remove the client, if it isn't already
+     * done. Must be called on the socket's strand.
+     */
+    void closeConnection();
+
+    /**
+     * @brief wait for the next heartbeat, a third of the idle timeout from
+     * now
+     */
+    void armHeartbeat();
+
+    /**
+     * @brief disconnect the client if nothing was received from it for the
+     * idle timeout, else ping it (if the previous Ping got its Pong)
+     */
+    void onHeartbeat();
+
+    /**
+     * @brief measure the round trip time of the Ping the Pong answers
+     */
+    void handlePong(const bindings::Pong &pong);
+
+    /**
+     * @brief count a package dropped for being over its rate, and disconnect
+     * the client if it keeps sending them (see DROPPED_PACKETS_RATE)
+     */
+    void handleRateLimitedPackage();
+
     /**
      *@brief : read the socket
      */
     void read();
 
     /**
-     *@brief : write package in the socket
+     *@brief : write all the packages of the write queue on the socket in a
+     *single gather write, then the ones queued meanwhile. Must be called on
+     *the socket's strand.
+     */
+    void writeSocket();
+
+    /**
+     *@brief : hand the package over to the socket's strand, from any thread
+     */
+    void enqueuePackage(std::shared_ptr<const Buffer> package,
+                        bool isGameState);
+
+    /**
+     *@brief : move the pending packages to the write queue and write them.
+     *If the client has more than MAX_QUEUED_BYTES waiting, the queued
+     *GameStates but the newest one are dropped, then the client itself if
+     *that's not enough. Must be called on the socket's strand.
      */
-    void writeSocket(std::string &content);
+    void drainPendingPackages();
 
     /**
-     *@brief : just check if the package has a type and if it is a Json
+     *@brief : drop the queued GameStates, except the newest one. Must be
+     *called on the socket's strand.
      */
-    bool checkPackage(std::string &package);
+    void dropStaleGameStates();
+
+    /**
+     * @brief drop the client, which doesn't read its packages fast enough.
+     * Must be called on the socket's strand.
+     */
+    void handleSlowReader();
+
+    /**
+     *@brief : parse the package, already read as a FlatPacket if it is one,
+     *into its binding, nullopt (and logs why) if it is malformed
+     */
+    std::optional<bindings::ClientPacket>
+    parsePackage(std::string_view package,
+                 const std::optional<bindings::FlatPacket> &flatPacket);
 
   public:
+    /**
+     * @param limits : the limits of the connection
+     * @param metrics : the counters the link reports to
+     */
     explicit ClientLink(tcp::socket socket, PacketHandler packetHandler,
                         AuthPacketHandler authPacketHandler,
                         AuthSuccessCallback authSuccessCallback,
-                        RemoveClientCallback removeClientCallback);
+                        RemoveClientCallback removeClientCallback,
+                        const ConnectionLimits &limits,
+                        ServerMetrics &metrics);
+    ~ClientLink();
 
     /**
-     * @brief trigger the read on the pipeline
+     * @brief trigger the read on the pipeline and the heartbeats, once the
+     * link is owned by a shared_ptr
      */
     void start();
 
@@ -123,6 +335,33 @@ class ClientLink : public std::enable_shared_from_this<ClientLink> {
      */
     void sendPackage(nlohmann::json package);
 
+    /**
+     * @brief write the given package, already dumped, on the socket (framed
+     * with the client's framing)
+     */
+    void sendSerializedPackage(std::string package);
+
+    /**
+     * @brief queue the given package, already dumped, for writing on the
+     * socket. The buffer is shared, not copied: send the same one to every
+     * recipient of a package (see makeSharedPackage()).
+     */
+    void sendShared(std::shared_ptr<const Buffer> package);
+
+    /**
+     * @brief same as sendShared(), for a GameState (or a GameStateDelta): it
+     * can be dropped if the client doesn't read fast enough, as a newer one
+     * replaces it
+     */
+    void sendGameState(std::shared_ptr<const Buffer> package);
+
+    /**
+     * @brief dump the given package once, to send it to several clients with
+     * sendShared()
+     */
+    static std::shared_ptr<const Buffer>
+    makeSharedPackage(const nlohmann::json &package);
+
     /**
      * @brief reset the weak pointer of the GameServer
      */
@@ -139,9 +378,9 @@ class ClientLink : public std::enable_shared_from_this<ClientLink> {
     bool shouldItBeDeletedFromTheList();
 
     /**
-     * @brief set the client id
+     * @brief set the client id, std::nullopt once logged out
      */
-    void setClientId(const int id);
+    void setClientId(std::optional<UserID> id);
 
     /**
      * @brief set the userState to the binding::state passed in parameter
@@ -159,6 +398,16 @@ class ClientLink : public std::enable_shared_from_this<ClientLink> {
      */
     void jointGame(const std::weak_ptr<GameServer> &gameServer);
 
+    /**
+     * @brief set the protocol features supported by the client
+     */
+    void setFeatures(bindings::ClientFeatures features);
+
+    /**
+     * @brief returns true if the client supports the given feature
+     */
+    bool hasFeature(bindings::ClientFeature feature) const;
+
     /**
      * @brief returns its bindings::State
      */
@@ -178,6 +427,12 @@ class ClientLink : public std::enable_shared_from_this<ClientLink> {
      * @brief returns the GameServer's weak pointer
      */
     std::weak_ptr<GameServer> getGameServer();
+
+    /**
+     * @brief returns the smoothed round trip time of the connection, nullopt
+     * if it isn't measured yet
+     */
+    std::optional<std::chrono::microseconds> getSmoothedRtt() const;
 };
 
 #endif
\ No newline at end of file
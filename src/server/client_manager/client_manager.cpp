@@ -18,10 +18,16 @@
 
 #include "client_manager.hpp"
 
+#include "../../common/bindings/authentication_response.hpp"
 #include "../../common/bindings/in_game/quit_game.hpp"
 #include "../../common/bindings/ranking.hpp"
+#include "../../common/bindings/ranking_delta.hpp"
+#include "../../common/types/overloaded.hpp"
+#include "replay/replay_format.hpp"
+#include "replay/replay_writer.hpp"
 
 #include <bcrypt.h>
+#include <variant>
 
 using json = nlohmann::json;
 
@@ -29,6 +35,7 @@ using json = nlohmann::json;
 // ---private ---
 
 void ClientManager::removeClientsFromTheWaintingList() {
+    std::lock_guard<std::mutex> lock(waitingForAuthMutex_);
     auto ne =
         remove_if(waitingForAuthClient.begin(), waitingForAuthClient.end(),
                   [](std::shared_ptr<ClientLink> x) {
@@ -38,30 +45,30 @@ void ClientManager::removeClientsFromTheWaintingList() {
 }
 
 void ClientManager::disconnectClient(const UserID &userID) {
-    if (!isClientConnected(userID)) {
+    std::shared_ptr<ClientLink> clientLink = connectedClients_.erase(userID);
+
+    if (!clientLink) {
         std::cout << "the client has already been disconnected id : " << userID
                   << std::endl;
     } else {
-
-        connectedClients_[userID]->setUserState(bindings::State::Offline);
-        addClientInWaitingForAuth(std::move(connectedClients_[userID]));
-        connectedClients_.erase(userID);
+        clientLink->setUserState(bindings::State::Offline);
+        addClientInWaitingForAuth(std::move(clientLink));
     }
 }
 
 void ClientManager::removeClient(std::optional<UserID> userID) {
     if (userID.has_value()) {
+        std::shared_ptr<ClientLink> clientLink =
+            connectedClients_.find(*userID);
 
-        switch (getUserState(userID.value())) {
+        switch (clientLink ? clientLink->getUserState()
+                           : bindings::State::Offline) {
         case bindings::State::InGame:
-            gamesManager_.enqueueGameBinding(
-                connectedClients_[userID.value()],
-                bindings::QuitGame{}.to_json().dump());
+            gamesManager_.enqueueGameBinding(clientLink, bindings::QuitGame{});
             break;
         case bindings::State::Matchmaking:
-            matchmaking_.removePlayer(
-                userID.value(),
-                connectedClients_[userID.value()]->getGameMode().value());
+            matchmaking_.removePlayer(userID.value(),
+                                      clientLink->getGameMode().value());
             break;
         default:
             break;
@@ -72,23 +79,40 @@ void ClientManager::removeClient(std::optional<UserID> userID) {
     removeClientsFromTheWaintingList();
 }
 
-void ClientManager::sendUpdatedRankingToClients() const {
-    std::vector<std::pair<std::string, size_t>> ranking =
-        accountService_.getRanking();
-    nlohmann::json rankingJson = bindings::Ranking{ranking}.to_json();
-    for (auto &client : connectedClients_) {
-        client.second->sendPackage(rankingJson);
+void ClientManager::updateScore(UserID userID, int score) {
+    std::optional<bindings::RankingDelta> rankingDelta =
+        accountService_.updateScore(userID, score);
+    if (!rankingDelta) {
+        return;
+    }
+
+    // the player gets their new neighbours, the others only the move
+    const std::shared_ptr<const ClientLink::Buffer> rankingDeltaPackage =
+        ClientLink::makeSharedPackage(rankingDelta->to_json());
+    for (const std::shared_ptr<ClientLink> &client :
+         connectedClients_.getAll()) {
+        if (client->getUserID() == userID) {
+            client->sendPackage(accountService_.getRanking(userID).to_json());
+        } else {
+            client->sendShared(rankingDeltaPackage);
+        }
     }
+
+    // called from the database thread of the GamesManager, which only looks
+    // the registry up at the end of a game
+    ClientRegistry::releaseThreadCache();
 }
 
 // ---public ---
-ClientManager::ClientManager(DataBase database)
+ClientManager::ClientManager(DataBase database, unsigned gameThreads)
     : accountService_(database.accountManager),
       gamesManager_(
-          [this](UserID user, int score) {
-              accountService_.updateScore(user, score);
-          },
-          [this]() { sendUpdatedRankingToClients(); }),
+          gameThreads,
+          [this](UserID user, int score) { updateScore(user, score); },
+          [replaysManager = database.replaysManager](const GameLog &gameLog) {
+              replaysManager->saveReplay(encodeReplay(gameLog),
+                                         replay_format::FILE_EXTENSION);
+          }),
       matchmaking_([this](std::vector<Player> players, GameMode gameMode) {
           gameFindCallback(players, gameMode);
       }),
@@ -99,212 +123,267 @@ ClientManager::ClientManager(DataBase database)
 
 {}
 
-void ClientManager::authSuccessCall(std::shared_ptr<ClientLink> clientLink,
-                                    nlohmann::json clientData) {
-    addConnection(clientLink, clientData.at("nickname").get<std::string>());
-    std::vector<std::pair<std::string, size_t>> ranking =
-        accountService_.getRanking();
-    nlohmann::json rankingJson = bindings::Ranking{ranking}.to_json();
-    clientLink->sendPackage(rankingJson);
+bool ClientManager::authSuccessCall(
+    std::shared_ptr<ClientLink> clientLink,
+    const bindings::Authentication &authentication) {
+    const UserID id = accountService_.getUserID(authentication.nickname);
+    // set before the link is listed, the other threads read them from there
+    clientLink->setFeatures(authentication.features);
+    clientLink->setClientId(id);
+    clientLink->setUserState(bindings::State::Menu);
+
+    // the first client to log in to the account wins
+    if (!connectedClients_.tryInsert(id, clientLink)) {
+        // so that its disconnection doesn't log the other client out
+        clientLink->setClientId(std::nullopt);
+        clientLink->setUserState(bindings::State::Offline);
+        return false;
+    }
+
+    clientLink->sendPackage(bindings::AuthenticationResponse{true}.to_json());
+    addConnection(clientLink, id);
+    clientLink->sendPackage(accountService_.getRanking(id).to_json());
+    return true;
 }
 void ClientManager::gameFindCallback(std::vector<Player> &players,
                                      GameMode gameMode) {
     std::shared_ptr<GameServer> gameServer =
         gamesManager_.startGameServeur(gameMode, players);
     for (auto player : players) {
-        gamesManager_.makeClientJoinGame(connectedClients_[player.userID],
-                                         gameServer);
+        // the GameServer sends its state to each player it is given
+        if (std::shared_ptr<ClientLink> clientLink =
+                connectedClients_.find(player.userID)) {
+            gamesManager_.makeClientJoinGame(clientLink, gameServer);
+        }
     }
-    gameServer->sendGameStates();
 }
 
 void ClientManager::addConnection(std::shared_ptr<ClientLink> clientSession,
-                                  const std::string &username) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    const UserID id = accountService_.getUserID(username);
-    clientSession->setClientId(id);
-    connectedClients_[id] = clientSession;
+                                  UserID id) {
     removeClientsFromTheWaintingList();
-    connectedClients_[id]->setUserState(bindings::State::Menu);
     updateMenu(id);
+    // sent once, then kept up to date with NewMessage bindings
+    clientSession->sendPackage(
+        socialService_
+            .getConversations(id, accountService_.getAccountManager())
+            .to_json());
 }
 
-std::optional<nlohmann::json>
-ClientManager::authPacketHandler(nlohmann::json binding) {
-    std::optional<nlohmann::json> response = std::nullopt;
-    try {
-        bindings::BindingType type = binding.at(bindings::PACKET_TYPE_FIELD)
-                                         .get<bindings::BindingType>();
-        switch (type) {
-        case bindings::BindingType::Authentication:
-            response = accountService_
-                           .authenticationAttempt(
-                               bindings::Authentication::from_json(binding),
-                               [this](UserID userID) -> bool {
-                                   return isClientConnected(userID);
-                               })
-                           .to_json();
-            break;
-        case bindings::BindingType::Registration:
-            response = accountService_
-                           .attemptCreateAccount(
-                               bindings::Registration::from_json(binding))
-                           .to_json();
-            break;
-        default:
-            break;
-        }
-    } catch (nlohmann::json::exception &e) {
-        std::cerr << "Received (auth) packet has wrong format : " << e.what()
-                  << std::endl;
-        response = std::nullopt;
-    }
-    return response;
+bool ClientManager::authPacketHandler(
+    const bindings::ClientPacket &packet,
+    std::function<void(nlohmann::json)> respond) {
+    return std::visit(
+        Overloaded{
+            [this, &respond](const bindings::Authentication &authentication) {
+                accountService_.authenticationAttempt(
+                    authentication,
+                    [respond](bindings::AuthenticationResponse response) {
+                        respond(response.to_json());
+                    });
+                return true;
+            },
+            [this, &respond](const bindings::Registration &registration) {
+                accountService_.attemptCreateAccount(
+                    registration,
+                    [respond](bindings::RegistrationResponse response) {
+                        respond(response.to_json());
+                    });
+                return true;
+            },
+            [](const auto &) { return false; },
+        },
+        packet);
 }
 
-void ClientManager::handlePacket(const std::string &packet,
+void ClientManager::handlePacket(bindings::ClientPacket &&packet,
                                  const UserID &userID) {
-    if (connectedClients_[userID]->getUserState() == bindings::State::InGame) {
-        gamesManager_.enqueueGameBinding(connectedClients_[userID], packet);
+    std::shared_ptr<ClientLink> clientLink = connectedClients_.find(userID);
+    if (!clientLink) {
+        return;
+    }
+
+    if (clientLink->getUserState() == bindings::State::InGame) {
+        gamesManager_.enqueueGameBinding(clientLink, std::move(packet));
         return;
     } else {
-        handlePacketMenu(packet, userID);
+        handlePacketMenu(std::move(packet), userID);
     }
 }
 
-void ClientManager::handlePacketMenu(const std::string &packet,
+void ClientManager::handlePacketMenu(bindings::ClientPacket &&packet,
                                      const UserID &userID) {
-
-    nlohmann::json jPack = nlohmann::json::parse(packet);
-    bindings::BindingType type =
-        jPack.at(bindings::PACKET_TYPE_FIELD).get<bindings::BindingType>();
-    switch (type) {
-    case bindings::BindingType::JoinGame:
-        connectedClients_[userID]->setUserState(bindings::State::Matchmaking);
-        connectedClients_[userID]->setGameMode(
-            bindings::JoinGame::from_json(jPack).gameMode);
-        updateThisUserWithAllhisFriends(userID);
-        matchmaking_.addPlayer(
-            RequestJoinGame{Player{
-                                userID,
-                                accountService_.getUsername(userID),
-                            },
-                            bindings::JoinGame::from_json(jPack)});
-        break;
-    case bindings::BindingType::CreateGame:
-        connectedClients_[userID]->setUserState(bindings::State::Matchmaking);
-        connectedClients_[userID]->setGameMode(
-            bindings::CreateGame::from_json(jPack).gameMode);
-        updateThisUserWithAllhisFriends(userID);
-        matchmaking_.createAGame(RequestCreateGame{
-            Player{userID, accountService_.getUsername(userID)},
-            bindings::CreateGame::from_json(jPack)});
-        break;
-    case bindings::BindingType::FriendRequest:
-        socialService_.handleFriendRequest(
-            userID, bindings::FriendRequest::from_json(jPack),
-            accountService_.getAccountManager());
-        updateMenu(userID);
-        updateMenu(accountService_.getUserID(
-            jPack.at("data").at("targetName").get<std::string>()));
-        break;
-    case bindings::BindingType::Message:
-        socialService_.handleMessages(userID,
-                                      bindings::Message::from_json(jPack));
-        updateMenu(userID);
-        updateMenu(jPack.at("data").at("recipientId").get<UserID>());
-        break;
-    case bindings::BindingType::HandleFriendRequest:
-
-        socialService_.handleHandleFriendRequest(
-            userID, bindings::HandleFriendRequest::from_json(jPack));
-        updateMenu(userID);
-        updateMenu(jPack.at("data").at("user").get<UserID>());
-        break;
-    case bindings::BindingType::RemoveFriend:
-        socialService_.handleRemoveFriend(
-            userID, bindings::RemoveFriend::from_json(jPack));
-        updateMenu(userID);
-        updateMenu(jPack.at("data").at("playerId").get<UserID>());
-        break;
-    case bindings::BindingType::ChangePassword:
-        accountService_.changePassword(
-            userID, bindings::ChangePassword::from_json(jPack));
-        break;
-    case bindings::BindingType::ChangeUsername:
-        connectedClients_[userID]->sendPackage(
-            accountService_
-                .attemptChangeUsername(
-                    userID, bindings::ChangeUsername::from_json(jPack),
-                    [this](UserID userID) {
-                        updateThisUserWithAllhisFriends(userID);
-                    })
-                .to_json());
-        break;
-    case bindings::BindingType::AbortMatchMaking:
-        matchmaking_.abortMatchmaking(connectedClients_[userID]);
-        updateThisUserWithAllhisFriends(userID);
-        break;
-
-    case bindings::BindingType::ViewGame:
-        gamesManager_.joinGameAsViewer(
-            connectedClients_[userID],
-            connectedClients_[jPack.at("data").at("targetUser").get<UserID>()]);
-        break;
-    case bindings::BindingType::QuitGame:
-        gamesManager_.quiGameAsViewer(connectedClients_[userID]);
-        break;
-    default:
-
-        break;
+    std::shared_ptr<ClientLink> clientLink = connectedClients_.find(userID);
+    if (!clientLink) {
+        return;
     }
+
+    std::visit(
+        Overloaded{
+            [&](const bindings::JoinGame &joinGame) {
+                clientLink->setUserState(
+                    bindings::State::Matchmaking);
+                clientLink->setGameMode(joinGame.gameMode);
+                updateThisUserWithAllhisFriends(userID);
+                matchmaking_.addPlayer(RequestJoinGame{
+                    Player{
+                        userID,
+                        accountService_.getUsername(userID),
+                        clientLink->getSmoothedRtt(),
+                    },
+                    joinGame});
+            },
+            [&](const bindings::CreateGame &createGame) {
+                clientLink->setUserState(
+                    bindings::State::Matchmaking);
+                clientLink->setGameMode(createGame.gameMode);
+                updateThisUserWithAllhisFriends(userID);
+                matchmaking_.createAGame(RequestCreateGame{
+                    Player{userID, accountService_.getUsername(userID),
+                           clientLink->getSmoothedRtt()},
+                    createGame});
+            },
+            [&](const bindings::FriendRequest &friendRequest) {
+                socialService_.handleFriendRequest(
+                    userID, friendRequest, accountService_.getAccountManager());
+                updateMenu(userID);
+                updateMenu(accountService_.getUserID(friendRequest.targetName));
+            },
+            [&](const bindings::Message &message) {
+                if (socialService_.handleMessages(userID, message)) {
+                    sendNewMessage(userID, message);
+                }
+            },
+            [&](const bindings::RequestConversationPage &request) {
+                clientLink->sendPackage(
+                    socialService_.getConversationPage(userID, request)
+                        .to_json());
+            },
+            [&](const bindings::RequestRankingPage &request) {
+                clientLink->sendPackage(
+                    accountService_.getRankingPage(request).to_json());
+            },
+            [&](const bindings::HandleFriendRequest &handleFriendRequest) {
+                socialService_.handleHandleFriendRequest(userID,
+                                                         handleFriendRequest);
+                updateMenu(userID);
+                updateMenu(handleFriendRequest.userId);
+            },
+            [&](const bindings::RemoveFriend &removeFriend) {
+                socialService_.handleRemoveFriend(userID, removeFriend);
+                updateMenu(userID);
+                updateMenu(removeFriend.userID);
+            },
+            [&](const bindings::ChangePassword &changePassword) {
+                accountService_.changePassword(userID, changePassword);
+            },
+            [&](const bindings::ChangeUsername &changeUsername) {
+                clientLink->sendPackage(
+                    accountService_
+                        .attemptChangeUsername(
+                            userID, changeUsername,
+                            [this](UserID userID) {
+                                updateThisUserWithAllhisFriends(userID);
+                            })
+                        .to_json());
+            },
+            [&](const bindings::AbortMatchMaking &) {
+                matchmaking_.abortMatchmaking(clientLink);
+                updateThisUserWithAllhisFriends(userID);
+            },
+            [&](const bindings::ViewGame &viewGame) {
+                if (std::shared_ptr<ClientLink> targetLink =
+                        connectedClients_.find(viewGame.targetUser)) {
+                    gamesManager_.joinGameAsViewer(clientLink, targetLink);
+                }
+            },
+            [&](const bindings::QuitGame &) {
+                gamesManager_.quiGameAsViewer(clientLink);
+            },
+            [&](bindings::RequestGameStateSnapshot &requestSnapshot) {
+                // sent by viewers, who aren't InGame
+                gamesManager_.enqueueGameBinding(clientLink,
+                                                 std::move(requestSnapshot));
+            },
+            [](const auto &) {},
+        },
+        packet);
 }
 
 void ClientManager::addClientInWaitingForAuth(
     std::shared_ptr<ClientLink> &&clientLink) {
     clientLink->setUserState(bindings::State::Offline);
-    waitingForAuthClient.push_back(clientLink);
+    std::lock_guard<std::mutex> lock(waitingForAuthMutex_);
+    waitingForAuthClient.push_back(std::move(clientLink));
 }
 
 void ClientManager::updateMenu(UserID userID) {
-    if (getUserState(userID) == bindings::State::Menu) {
-        connectedClients_[userID]->sendPackage(
+    std::shared_ptr<ClientLink> clientLink = connectedClients_.find(userID);
+    if (clientLink && clientLink->getUserState() == bindings::State::Menu) {
+        clientLink->sendPackage(
             socialService_.getPendignsFriendRequests(userID).to_json());
-        connectedClients_[userID]->sendPackage(
+        clientLink->sendPackage(
             socialService_.getFriendsList(userID).to_json());
-        connectedClients_[userID]->sendPackage(
-            socialService_
-                .getConversations(userID, accountService_.getAccountManager())
+    }
+}
+
+void ClientManager::sendNewMessage(UserID senderID,
+                                   const bindings::Message &message) {
+    const SenderMessage senderMessage{senderID, message.content};
+
+    if (std::shared_ptr<ClientLink> senderLink =
+            connectedClients_.find(senderID)) {
+        senderLink->sendPackage(
+            bindings::NewMessage{message.recipientId,
+                                 accountService_.getUsername(
+                                     message.recipientId),
+                                 senderMessage}
+                .to_json());
+    }
+    if (std::shared_ptr<ClientLink> recipientLink =
+            connectedClients_.find(message.recipientId)) {
+        recipientLink->sendPackage(
+            bindings::NewMessage{senderID,
+                                 accountService_.getUsername(senderID),
+                                 senderMessage}
                 .to_json());
     }
 }
 
-void ClientManager::shutdown() { gamesManager_.shutdown(); }
+void ClientManager::shutdown() {
+    accountService_.shutdown();
+    gamesManager_.shutdown();
+}
 
-bool ClientManager::isClientConnected(UserID userID) {
-    return connectedClients_.find(userID) != connectedClients_.end();
+bool ClientManager::isClientConnected(UserID userID) const {
+    return connectedClients_.contains(userID);
 }
 bindings::State ClientManager::getUserState(UserID userID) {
-    if (isClientConnected(userID)) {
-        return connectedClients_[userID]->getUserState();
+    if (std::shared_ptr<ClientLink> clientLink =
+            connectedClients_.find(userID)) {
+        return clientLink->getUserState();
     } else {
         return bindings::State::Offline;
     }
 }
 
 void ClientManager::updateThisUserWithAllhisFriends(UserID userID) {
-    bindings::User user = getUser(userID);
+    const std::shared_ptr<const ClientLink::Buffer> userPackage =
+        ClientLink::makeSharedPackage(getUser(userID).to_json());
     for (auto id : socialService_.getFriendIdsList(userID)) {
-        if (isClientConnected(id)) {
-            connectedClients_[id]->sendPackage(user.to_json());
+        if (std::shared_ptr<ClientLink> clientLink =
+                connectedClients_.find(id)) {
+            clientLink->sendShared(userPackage);
         }
     }
 }
 
 bindings::User ClientManager::getUser(UserID userID) {
+    std::shared_ptr<ClientLink> clientLink = connectedClients_.find(userID);
+    const bindings::State userState =
+        clientLink ? clientLink->getUserState() : bindings::State::Offline;
     return bindings::User{userID, accountService_.getUsername(userID),
-                          getUserState(userID),
-                          (getUserState(userID) != bindings::State::Offline)
-                              ? connectedClients_[userID]->getGameMode()
+                          userState,
+                          (userState != bindings::State::Offline)
+                              ? clientLink->getGameMode()
                               : std::nullopt};
 }
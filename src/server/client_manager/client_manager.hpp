@@ -19,13 +19,20 @@
 #define CLIENT_MANAGER_HPP
 
 #include <asio.hpp>
+#include <functional>
 #include <mutex>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "../../common/bindings/authentication.hpp"
+#include "../../common/bindings/client_packet.hpp"
+#include "../../common/bindings/new_message.hpp"
 #include "../account_service/account_service.hpp"
+#include "../client_registry/client_registry.hpp"
+#include "../database/replays_manager/replays_manager.hpp"
 #include "../social_service/social_service.hpp"
 
 #include "../matchmaking/matchmaking.hpp"
@@ -40,6 +47,7 @@ struct DataBase {
     std::shared_ptr<AccountManager> accountManager;
     std::shared_ptr<FriendsManager> friendsManager;
     std::shared_ptr<MessagesManager> messagesManager;
+    std::shared_ptr<ReplaysManager> replaysManager;
 };
 
 /**
@@ -47,12 +55,16 @@ struct DataBase {
  *
  * @brief handles all clients and package management
  * delegates to other services according to the package
+ *
+ * It is called by all the io threads (and the game threads): the connected
+ * clients are looked up in per-thread snapshots (see ClientRegistry), the
+ * clients waiting for authentication are only accessed under their mutex,
+ * which is never held while calling another service.
  */
 class ClientManager {
   private:
-    // map => { key : client id , value : the client session }
-    std::unordered_map<UserID, std::shared_ptr<ClientLink>> connectedClients_;
-    std::mutex mutex_;
+    // the sessions of the logged in clients, by client id
+    ClientRegistry connectedClients_;
     AccountService accountService_;
     GamesManager gamesManager_;
     Matchmaking matchmaking_;
@@ -60,6 +72,7 @@ class ClientManager {
 
     // contains client who are not yet authenticated
     std::vector<std::shared_ptr<ClientLink>> waitingForAuthClient;
+    std::mutex waitingForAuthMutex_;
 
     /**
      * @brief remove authenticated clients and clients who have closed their
@@ -73,21 +86,29 @@ class ClientManager {
     void disconnectClient(const UserID &userID);
 
     /**
-     * @brief : send the ranking to all the connected clients
+     * @brief : save the score of a finished endless game and, if it is the
+     * player's best one, send the player's move in the ranking to all the
+     * connected clients. Called from the database thread of the GamesManager
      */
-    void sendUpdatedRankingToClients() const;
+    void updateScore(UserID userID, int score);
 
   public:
-    ClientManager(DataBase database);
+    /**
+     * @param gameThreads : the number of threads running the games
+     */
+    ClientManager(DataBase database, unsigned gameThreads);
     ~ClientManager() = default;
 
     /**
-     * @brief : call by ClientLink when the client is logged in
+     * @brief : call by ClientLink when the client's password is right, to log
+     * them in. The AuthenticationResponse is sent from here on success.
      * @param clientLink : shared_ptr of the clientLink
-     * @param clientData : client data
+     * @param authentication : the client's successful authentication
+     * @return false if the account was logged in by another client in the
+     * meantime, the clientLink is then left logged out
      */
-    void authSuccessCall(std::shared_ptr<ClientLink> clientLink,
-                         nlohmann::json clientData);
+    bool authSuccessCall(std::shared_ptr<ClientLink> clientLink,
+                         const bindings::Authentication &authentication);
 
     /**
      * @brief callback use by Matchmaking to notify that a party has been
@@ -97,7 +118,7 @@ class ClientManager {
     void gameFindCallback(std::vector<Player> &players, GameMode gameMode);
 
     /**
-     * @brief shutdown the gamesManager
+     * @brief shutdown the bcrypt workers and the gamesManager
      */
     void shutdown();
 
@@ -109,20 +130,25 @@ class ClientManager {
     /**
      * @brief : manage of the packet received by the clientLink
      */
-    void handlePacket(const std::string &packet, const UserID &userID);
+    void handlePacket(bindings::ClientPacket &&packet, const UserID &userID);
 
     /**
      * @brief manages all packets sent from the menu
      * @param packet : the packet
      * @param userID : the sender
      */
-    void handlePacketMenu(const std::string &packet, const UserID &userID);
+    void handlePacketMenu(bindings::ClientPacket &&packet,
+                          const UserID &userID);
 
     /**
      * @brief : manage package when the client is not yet logged in
-     * @return : the response of the package
+     * @param respond : receives the response of the package once it is
+     * handled, from a bcrypt worker or right away
+     * @return : false if it isn't an authentication or registration, respond
+     * isn't called then
      */
-    std::optional<nlohmann::json> authPacketHandler(nlohmann::json binding);
+    bool authPacketHandler(const bindings::ClientPacket &packet,
+                           std::function<void(nlohmann::json)> respond);
 
     /**
      * @brief:  add client to the waitingForAuthCLient list
@@ -130,24 +156,30 @@ class ClientManager {
     void addClientInWaitingForAuth(std::shared_ptr<ClientLink> &&clientLink);
 
     /**
-     * @brief : add client in the unordered_map
+     * @brief : send the menu to a client that was just added to the connected
+     * clients
      */
-    void addConnection(std::shared_ptr<ClientLink> clientSession,
-                       const std::string &username);
+    void addConnection(std::shared_ptr<ClientLink> clientSession, UserID id);
 
     /**
      * @brief check if  client is connected
      *
      * @return true if client is connected
      */
-    bool isClientConnected(UserID userID);
+    bool isClientConnected(UserID userID) const;
 
     /**
-     * @brief Update all menu data for a User
+     * @brief Update all menu data for a User (except the conversations, see
+     * sendNewMessage())
      * @param userID : user who will receive data
      */
     void updateMenu(UserID userID);
 
+    /**
+     * @brief push the given message to the sender and the recipient
+     */
+    void sendNewMessage(UserID senderID, const bindings::Message &message);
+
     /**
      * @brief update the user state to all his friends
      */
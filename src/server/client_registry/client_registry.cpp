@@ -0,0 +1,109 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "client_registry.hpp"
+
+#include <utility>
+
+// ====== ClientRegistry class ======
+
+// --- private ---
+
+thread_local ClientRegistry::ThreadCache ClientRegistry::threadCache_;
+
+std::size_t ClientRegistry::getShardIndex(UserID userID) {
+    return userID & (NUM_SHARDS - 1);
+}
+
+const ClientRegistry::Clients &
+ClientRegistry::getClients(std::size_t shardIndex) const {
+    ThreadCache &cache = threadCache_;
+    if (cache.registryID != registryID_) {
+        cache = ThreadCache{};
+        cache.registryID = registryID_;
+    }
+
+    const Shard &shard = shards_[shardIndex];
+    if (shard.version.load(std::memory_order_acquire)
+        != cache.versions[shardIndex]) {
+        // released once unlocked, it may hold the last reference to a link
+        std::shared_ptr<const Clients> previous =
+            std::move(cache.clients[shardIndex]);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        cache.clients[shardIndex] = shard.clients;
+        cache.versions[shardIndex] =
+            shard.version.load(std::memory_order_relaxed);
+    }
+    return *cache.clients[shardIndex];
+}
+
+// --- public ---
+
+std::shared_ptr<ClientLink> ClientRegistry::find(UserID userID) const {
+    const Clients &clients = getClients(getShardIndex(userID));
+    auto client = clients.find(userID);
+    return client != clients.end() ? client->second : nullptr;
+}
+
+bool ClientRegistry::contains(UserID userID) const {
+    return getClients(getShardIndex(userID)).contains(userID);
+}
+
+std::vector<std::shared_ptr<ClientLink>> ClientRegistry::getAll() const {
+    std::vector<std::shared_ptr<ClientLink>> clientLinks;
+    for (std::size_t shardIndex = 0; shardIndex < NUM_SHARDS; ++shardIndex) {
+        for (const auto &[id, clientLink] : getClients(shardIndex)) {
+            clientLinks.push_back(clientLink);
+        }
+    }
+    return clientLinks;
+}
+
+bool ClientRegistry::tryInsert(UserID userID,
+                               std::shared_ptr<ClientLink> clientLink) {
+    Shard &shard = shards_[getShardIndex(userID)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (shard.clients->contains(userID)) {
+        return false;
+    }
+
+    auto clients = std::make_shared<Clients>(*shard.clients);
+    clients->emplace(userID, std::move(clientLink));
+    shard.clients = std::move(clients);
+    shard.version.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+std::shared_ptr<ClientLink> ClientRegistry::erase(UserID userID) {
+    Shard &shard = shards_[getShardIndex(userID)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto client = shard.clients->find(userID);
+    if (client == shard.clients->end()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ClientLink> clientLink = client->second;
+    auto clients = std::make_shared<Clients>(*shard.clients);
+    clients->erase(userID);
+    shard.clients = std::move(clients);
+    shard.version.fetch_add(1, std::memory_order_release);
+    return clientLink;
+}
+
+void ClientRegistry::releaseThreadCache() { threadCache_ = ThreadCache{}; }
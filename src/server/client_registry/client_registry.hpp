@@ -0,0 +1,140 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLIENT_REGISTRY_HPP
+#define CLIENT_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../../common/types/types.hpp"
+#include "../cache_line/cache_line.hpp"
+
+class ClientLink;
+
+/**
+ * @class ClientRegistry
+ *
+ * @brief The links of the connected clients, by user id.
+ *
+ * It is looked up by all the io and game threads for each package routed to
+ * a client, and only written at login and logout. So each shard keeps an
+ * immutable snapshot of its clients, replaced as a whole by the writers along
+ * with a version number. Each thread caches the snapshot of each shard it
+ * looked up: as long as the shard's version is the cached one, a lookup only
+ * loads that version, without a mutex nor a shared reference count. After a
+ * write, the next lookup of the shard on each thread takes the shard's mutex
+ * once to refresh its copy. An erased link can thus be kept alive by the
+ * caches until then.
+ */
+class ClientRegistry {
+  private:
+    using Clients = std::unordered_map<UserID, std::shared_ptr<ClientLink>>;
+
+    // the writers of different shards don't contend, a power of two so that
+    // picking the shard is a mask
+    static constexpr std::size_t NUM_SHARDS = 16;
+
+    // on its own cache line, so that writing a shard doesn't slow down the
+    // readers of its neighbours
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        // bumped after each write, the threads' caches start at 0
+        std::atomic<std::uint64_t> version = 1;
+        // guards clients: held by the writers, which copy the snapshot to
+        // replace it, and by the readers refreshing their cache
+        mutable std::mutex mutex;
+        std::shared_ptr<const Clients> clients =
+            std::make_shared<const Clients>();
+    };
+
+    // the snapshots last seen by a thread, for a single registry at a time
+    struct ThreadCache {
+        // 0 when the cache is empty
+        std::uint64_t registryID = 0;
+        std::array<std::uint64_t, NUM_SHARDS> versions{};
+        std::array<std::shared_ptr<const Clients>, NUM_SHARDS> clients;
+    };
+
+    inline static std::atomic<std::uint64_t> nextRegistryID_ = 1;
+    static thread_local ThreadCache threadCache_;
+
+    // tells the caches of the registries apart, even at the same address
+    const std::uint64_t registryID_ = nextRegistryID_.fetch_add(1);
+    std::array<Shard, NUM_SHARDS> shards_;
+
+    static std::size_t getShardIndex(UserID userID);
+
+    /**
+     * @brief returns this thread's snapshot of the given shard, refreshed if
+     * the shard changed. It stays valid until the next call on this thread.
+     */
+    const Clients &getClients(std::size_t shardIndex) const;
+
+  public:
+    ClientRegistry() = default;
+    ~ClientRegistry() = default;
+
+    ClientRegistry(const ClientRegistry &) = delete;
+    ClientRegistry &operator=(const ClientRegistry &) = delete;
+
+    /**
+     * @brief returns the link of the given user, nullptr if they aren't
+     * connected
+     */
+    std::shared_ptr<ClientLink> find(UserID userID) const;
+
+    /**
+     * @brief returns true if the given user is connected
+     */
+    bool contains(UserID userID) const;
+
+    /**
+     * @brief returns the links of all the connected clients
+     */
+    std::vector<std::shared_ptr<ClientLink>> getAll() const;
+
+    /**
+     * @brief add the link of the given user, unless they are already
+     * connected: the check and the insertion are atomic, so of two logins to
+     * the same account only one gets in
+     *
+     * @return true if the link was added, false if the user already had one
+     */
+    bool tryInsert(UserID userID, std::shared_ptr<ClientLink> clientLink);
+
+    /**
+     * @brief remove the link of the given user
+     *
+     * @return the removed link, nullptr if the user wasn't connected
+     */
+    std::shared_ptr<ClientLink> erase(UserID userID);
+
+    /**
+     * @brief release the snapshots cached by the calling thread, for the
+     * threads that rarely look the registry up: their caches would otherwise
+     * keep the erased links alive
+     */
+    static void releaseThreadCache();
+};
+
+#endif // CLIENT_REGISTRY_HPP
@@ -17,6 +17,7 @@
 
 #include "account_manager.hpp"
 
+#include <algorithm>
 #include <ctype.h>
 #include <iostream>
 #include <memory>
@@ -35,6 +36,10 @@ AccountManager::AccountManager(std::shared_ptr<DatabaseManager> &db)
                              "username TEXT NOT NULL, "
                              "password TEXT NOT NULL, "
                              "score INTEGER DEFAULT 0)");
+    // the order of the ranking, so that its pages and the ranks are read
+    // from the index instead of sorting the whole table
+    dbManager_->createTables("CREATE INDEX IF NOT EXISTS users_by_score ON "
+                             "users (score DESC, id)");
 }
 
 // ### Private methods ###
@@ -67,6 +72,7 @@ CreateAccountStatus AccountManager::createAccount(const std::string &username,
 
     CreateAccountStatus res = CreateAccountStatus::SUCCESS;
 
+    std::lock_guard<std::mutex> lock(usernamesMutex_);
     if (checkUsernameExists(username)) {
         std::cerr << "AccountManager error: User '" << username
                   << "' already exist." << std::endl;
@@ -129,6 +135,7 @@ void AccountManager::updateScore(const UserID &userID, const Score &newScore) {
 
 bool AccountManager::updateUsername(const UserID &userID,
                                     std::string &newUsername) {
+    std::lock_guard<std::mutex> lock(usernamesMutex_);
     if (checkUsernameExists(newUsername)) {
         std::cout << "a user already has this nickname" << std::endl;
         return false;
@@ -164,8 +171,53 @@ std::string AccountManager::getUsername(const UserID &userID) const {
     return username;
 }
 
-std::vector<std::pair<std::string, size_t>> AccountManager::getRanking() const {
-    return dbManager_->getRanking();
+Score AccountManager::getScore(const UserID &userID) const {
+    std::string sql = "SELECT score FROM users WHERE id = ?";
+    int score = 0;
+    dbManager_->executeSqlRecoveryInt(sql, {userID}, score);
+    return static_cast<Score>(score);
+}
+
+size_t AccountManager::getRank(const UserID &userID) const {
+    const Score score = getScore(userID);
+    std::string sql = "SELECT COUNT(*) FROM users "
+                      "WHERE score > ? OR (score = ? AND id < ?)";
+    int betterPlayers = 0;
+    dbManager_->executeSqlRecoveryInt(sql, {score, score, userID},
+                                      betterPlayers);
+    return static_cast<size_t>(betterPlayers) + 1;
+}
+
+std::vector<std::tuple<UserID, std::string, Score>>
+AccountManager::getRankingTop(size_t count) const {
+    return dbManager_->getRanking("SELECT id, username, score FROM users "
+                                  "ORDER BY score DESC, id LIMIT ?",
+                                  {count});
+}
+
+// "score < ? OR (score = ? AND id > ?)", written so that the score bound is
+// a range of the (score DESC, id) index
+std::vector<std::tuple<UserID, std::string, Score>>
+AccountManager::getRankingAfter(Score score, const UserID &userID,
+                                size_t count) const {
+    return dbManager_->getRanking(
+        "SELECT id, username, score FROM users "
+        "WHERE score <= ? AND (score < ? OR id > ?) "
+        "ORDER BY score DESC, id LIMIT ?",
+        {score, score, userID, count});
+}
+
+std::vector<std::tuple<UserID, std::string, Score>>
+AccountManager::getRankingBefore(Score score, const UserID &userID,
+                                 size_t count) const {
+    // read backwards from the position, then put back in ranking order
+    std::vector<std::tuple<UserID, std::string, Score>> ranking =
+        dbManager_->getRanking("SELECT id, username, score FROM users "
+                               "WHERE score >= ? AND (score > ? OR id < ?) "
+                               "ORDER BY score, id DESC LIMIT ?",
+                               {score, score, userID, count});
+    std::reverse(ranking.begin(), ranking.end());
+    return ranking;
 }
 
 std::string
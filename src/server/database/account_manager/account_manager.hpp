@@ -19,8 +19,10 @@
 #define ACCOUNT_MANAGER_HPP
 
 #include <memory>
+#include <mutex>
 #include <stddef.h>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -41,6 +43,9 @@ enum class CreateAccountStatus {
 class AccountManager {
   private:
     std::shared_ptr<DatabaseManager> dbManager_;
+    // makes checking that a username is free and taking it atomic, as the
+    // io threads register and rename concurrently
+    std::mutex usernamesMutex_;
 
     /*
      * @brief Check if a friendship exists between two users
@@ -139,11 +144,57 @@ class AccountManager {
     std::string getUsername(const UserID &userID) const;
 
     /*
-     * @brief Get the ranking of the users for the endless mode
+     * @brief Get the best score of a user in the endless mode
      *
-     * @return Vector of pairs containing the username and the score
+     * @param userID ID of the user
+     * @return Score of the user
+     */
+    Score getScore(const UserID &userID) const;
+
+    /*
+     * @brief Get the rank of a user in the ranking of the endless mode (1 for
+     * the best score, the ties being broken by the account's seniority)
+     *
+     * @param userID ID of the user
+     * @return Rank of the user
+     */
+    size_t getRank(const UserID &userID) const;
+
+    /*
+     * @brief Get the best users of the ranking of the endless mode
+     *
+     * @param count Maximum number of users to get
+     * @return Vector of tuples containing the id, the username and the score,
+     * best first
+     */
+    std::vector<std::tuple<UserID, std::string, Score>>
+    getRankingTop(size_t count) const;
+
+    /*
+     * @brief Get the users ranked right after the given position (keyset
+     * pagination: it costs the same whatever the rank of the position)
+     *
+     * @param score Score of the position
+     * @param userID ID of the user at the position
+     * @param count Maximum number of users to get
+     * @return Vector of tuples containing the id, the username and the score,
+     * best first
+     */
+    std::vector<std::tuple<UserID, std::string, Score>>
+    getRankingAfter(Score score, const UserID &userID, size_t count) const;
+
+    /*
+     * @brief Get the users ranked right before the given position (keyset
+     * pagination, see getRankingAfter)
+     *
+     * @param score Score of the position
+     * @param userID ID of the user at the position
+     * @param count Maximum number of users to get
+     * @return Vector of tuples containing the id, the username and the score,
+     * best first
      */
-    std::vector<std::pair<std::string, size_t>> getRanking() const;
+    std::vector<std::tuple<UserID, std::string, Score>>
+    getRankingBefore(Score score, const UserID &userID, size_t count) const;
 
     /*
      * @brief Get the password hash of a user
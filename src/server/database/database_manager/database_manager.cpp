@@ -183,27 +183,42 @@ bool DatabaseManager::executeSqlRecoveryString(
 // ### Getters ###
 sqlite3 *DatabaseManager::getDatabase() const { return db_; }
 
-std::vector<std::pair<std::string, size_t>>
-DatabaseManager::getRanking() const {
+std::vector<std::tuple<UserID, std::string, Score>>
+DatabaseManager::getRanking(const std::string &sql,
+                            const std::vector<MultiType> &params) const {
     // Prepare the SQL statement
-    std::vector<std::pair<std::string, size_t>> ranking;
-    std::string sql = "SELECT username, score FROM users ORDER BY score DESC";
+    std::vector<std::tuple<UserID, std::string, Score>> ranking;
     sqlite3_stmt *stmt;
 
-    // Execute the SQL statement
-    if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-        // Get the data from the statement
-        while (sqlite3_step(stmt) == SQLITE_ROW) {
-            std::string username =
-                reinterpret_cast<const char *>(sqlite3_column_text(stmt, 0));
-            size_t score = static_cast<size_t>(sqlite3_column_int(stmt, 1));
+    if (sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Error in getting ranking." << std::endl;
+        return ranking;
+    }
 
-            ranking.push_back({username, score});
+    // Bind the parameters
+    for (size_t i = 0; i < params.size(); ++i) {
+        if (std::holds_alternative<UserID>(params[i])) {
+            sqlite3_bind_int(stmt, static_cast<int>(i + 1),
+                             std::get<UserID>(params[i]));
+        } else {
+            sqlite3_bind_text(stmt, static_cast<int>(i + 1),
+                              std::get<std::string>(params[i]).c_str(), -1,
+                              SQLITE_STATIC);
         }
-        sqlite3_finalize(stmt);
-    } else {
-        std::cerr << "Error in getting ranking." << std::endl;
     }
+
+    // Get the data from the statement
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        UserID userID = static_cast<UserID>(sqlite3_column_int(stmt, 0));
+        std::string username =
+            reinterpret_cast<const char *>(sqlite3_column_text(stmt, 1));
+        Score score = static_cast<Score>(sqlite3_column_int(stmt, 2));
+
+        ranking.push_back({userID, username, score});
+    }
+
+    // Finalize the statement
+    sqlite3_finalize(stmt);
     return ranking;
 }
 
@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -108,11 +109,17 @@ class DatabaseManager {
     sqlite3 *getDatabase() const;
 
     /*
-     * @brief Add a friend to the database
+     * @brief Execute a SQL query that returns users of the ranking
      *
-     * @return a vector of pairs containing the username and score of each user
+     * @param sql SQL query to execute, selecting the id, the username then
+     * the score
+     * @param params Parameters to bind to the query
+     * @return a vector of tuples containing the id, username and score of
+     * each user
      */
-    std::vector<std::pair<std::string, size_t>> getRanking() const;
+    std::vector<std::tuple<UserID, std::string, Score>>
+    getRanking(const std::string &sql,
+               const std::vector<MultiType> &params) const;
 
     /*
      * @brief Find the user in the table of database
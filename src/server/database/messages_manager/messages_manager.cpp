@@ -17,16 +17,27 @@
 
 #include "messages_manager.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #include "../../../common/bindings/conversation.hpp"
 #include "../database_manager/database_manager.hpp"
 
+namespace {
+
+    // the discussion files used to hold a whole Conversation binding, dumped
+    // as {"data":...,"type":...}
+    constexpr std::string_view LEGACY_DISCUSSION_PREFIX = "{\"data\"";
+
+} // namespace
+
 //==== Constructor ====
 MessagesManager::MessagesManager(std::shared_ptr<DatabaseManager> &db)
     : dbManager_(db) {
@@ -50,7 +61,7 @@ MessagesManager::MessagesManager(std::shared_ptr<DatabaseManager> &db)
 std::string MessagesManager::generateFileName(const UserID &user1ID,
                                               const UserID &user2ID) {
     return dbManager_->getDatabasePath("data/chat/user") + std::to_string(user1ID) + "_user"
-           + std::to_string(user2ID) + ".json";
+           + std::to_string(user2ID) + ".jsonl";
 }
 
 bool MessagesManager::createDiscussionFile(const std::string &filePath) {
@@ -59,9 +70,7 @@ bool MessagesManager::createDiscussionFile(const std::string &filePath) {
         std::cerr << "file error" << filePath << std::endl;
         return false;
     }
-    nlohmann::json discuJson = bindings::Conversation{}.to_json();
 
-    file << discuJson;
     return true;
 }
 
@@ -88,45 +97,214 @@ std::string MessagesManager::getPathDiscussion(const UserID &user1ID,
     return discussionFile;
 }
 
-void MessagesManager::writeMessage(const std::string &pathfile,
-                                   const Message &message) {
+void MessagesManager::migrateLegacyDiscussion(const std::string &pathfile) {
     std::ifstream infile(pathfile);
-    if (!infile.is_open()) {
-        std::cerr << "Error opening file" << std::endl;
+    std::string prefix(LEGACY_DISCUSSION_PREFIX.size(), '\0');
+    if (!infile.read(prefix.data(),
+                     static_cast<std::streamsize>(prefix.size()))
+        || prefix != LEGACY_DISCUSSION_PREFIX) {
         return;
     }
+    infile.seekg(0);
 
-    nlohmann::json jsondiscu;
+    bindings::Conversation discussion;
     try {
-        jsondiscu = nlohmann::json::parse(infile);
-    } catch (const std::runtime_error &e) {
-        std::cerr << "Received packet is not valid JSON: " << e.what()
+        discussion =
+            bindings::Conversation::from_json(nlohmann::json::parse(infile));
+    } catch (const nlohmann::json::exception &e) {
+        std::cerr << "Discussion file is not valid JSON: " << e.what()
                   << std::endl;
         return;
     }
+    infile.close();
+
+    // written aside first, not to lose the discussion if interrupted
+    const std::string tmpPath = pathfile + ".tmp";
+    {
+        std::ofstream outfile(tmpPath, std::ios::trunc);
+        for (const auto &[senderID, content] : discussion.senderMessages) {
+            outfile << Message{senderID, content}.to_json().dump() << '\n';
+        }
+    }
+    std::filesystem::rename(tmpPath, pathfile);
+    // its offsets changed
+    std::filesystem::remove(getIndexPath(pathfile));
+}
+
+std::string MessagesManager::getIndexPath(const std::string &pathfile) {
+    return pathfile + std::string(INDEX_EXTENSION);
+}
+
+std::optional<uint64_t>
+MessagesManager::readIndexEntry(const std::string &indexPath,
+                                size_t messageIdx) {
+    std::ifstream index(indexPath, std::ios::binary);
+    uint64_t offset = 0;
+    if (!index.seekg(static_cast<std::streamoff>(messageIdx * sizeof(offset)))
+        || !index.read(reinterpret_cast<char *>(&offset), sizeof(offset))) {
+        return std::nullopt;
+    }
+
+    return offset;
+}
+
+std::optional<size_t>
+MessagesManager::rebuildIndex(const std::string &pathfile) {
+    std::ifstream infile(pathfile, std::ios::binary);
+    if (!infile.is_open()) {
+        std::cerr << "Error opening file" << std::endl;
+        return std::nullopt;
+    }
+
+    // written aside first, so that an interrupted rebuild leaves no index
+    const std::string indexPath = getIndexPath(pathfile);
+    const std::string tmpPath = indexPath + ".tmp";
+    size_t numMessages = 0;
+    {
+        std::ofstream index(tmpPath, std::ios::binary | std::ios::trunc);
+        uint64_t offset = static_cast<uint64_t>(infile.tellg());
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (!line.empty()) {
+                index.write(reinterpret_cast<const char *>(&offset),
+                            sizeof(offset));
+                ++numMessages;
+            }
+            offset += line.size() + 1;
+        }
+
+        if (!index) {
+            std::cerr << "Error writing " << tmpPath << std::endl;
+            return std::nullopt;
+        }
+    }
+    std::filesystem::rename(tmpPath, indexPath);
+
+    return numMessages;
+}
+
+std::optional<size_t> MessagesManager::loadIndex(const std::string &pathfile) {
+    std::error_code error;
+    const uintmax_t fileSize = std::filesystem::file_size(pathfile, error);
+    if (error) {
+        std::cerr << "Error opening file" << std::endl;
+        return std::nullopt;
+    }
+
+    // an index is appended to before its discussion: its last message must
+    // be in the file (the end of a message isn't checked)
+    const std::string indexPath = getIndexPath(pathfile);
+    const uintmax_t indexSize = std::filesystem::file_size(indexPath, error);
+    if (!error && indexSize % sizeof(uint64_t) == 0) {
+        const size_t numMessages = indexSize / sizeof(uint64_t);
+        if (numMessages == 0) {
+            if (fileSize == 0) {
+                return numMessages;
+            }
+        } else if (std::optional<uint64_t> lastOffset =
+                       readIndexEntry(indexPath, numMessages - 1);
+                   lastOffset.has_value() && *lastOffset < fileSize) {
+            return numMessages;
+        }
+    }
+
+    return rebuildIndex(pathfile);
+}
+
+std::optional<bindings::Conversation>
+MessagesManager::readMessages(const std::string &pathfile,
+                              std::optional<size_t> before,
+                              size_t maxMessages) {
+    migrateLegacyDiscussion(pathfile);
+
+    const std::optional<size_t> numMessages = loadIndex(pathfile);
+    if (!numMessages.has_value()) {
+        return std::nullopt;
+    }
+
+    const size_t end =
+        before.has_value() ? std::min(*before, *numMessages) : *numMessages;
+    const size_t first = end - std::min(maxMessages, end);
+
+    bindings::Conversation discussion;
+    discussion.firstIndex = first;
+    if (first == end) {
+        return discussion;
+    }
+
+    // only the lines of the requested messages are read (and parsed)
+    const std::optional<uint64_t> offset =
+        readIndexEntry(getIndexPath(pathfile), first);
+    std::ifstream infile(pathfile, std::ios::binary);
+    if (!offset.has_value() || !infile.is_open()
+        || !infile.seekg(static_cast<std::streamoff>(*offset))) {
+        std::cerr << "Error opening file" << std::endl;
+        return std::nullopt;
+    }
+
+    std::vector<std::string> lines;
+    lines.reserve(end - first);
+    std::string line;
+    while (lines.size() < end - first && std::getline(infile, line)) {
+        if (!line.empty()) {
+            lines.push_back(std::move(line));
+        }
+    }
+
+    for (const std::string &messageLine : lines) {
+        try {
+            Message message =
+                Message::from_json(nlohmann::json::parse(messageLine));
+            discussion.senderMessages.emplace_back(message.senderID,
+                                                   std::move(message.content));
+        } catch (const nlohmann::json::exception &e) {
+            std::cerr << "Invalid message in " << pathfile << ": " << e.what()
+                      << std::endl;
+        }
+    }
+
+    return discussion;
+}
+
+void MessagesManager::writeMessage(const std::string &pathfile,
+                                   const Message &message) {
+    migrateLegacyDiscussion(pathfile);
+    if (!loadIndex(pathfile).has_value()) {
+        return;
+    }
+
+    // one line per message: appending doesn't depend on the history's size
+    std::ofstream outfile(pathfile, std::ios::binary | std::ios::app);
+    if (!outfile.is_open()) {
+        std::cerr << "Error opening file" << std::endl;
+        return;
+    }
 
-    bindings::Conversation discussion =
-        bindings::Conversation::from_json(jsondiscu);
-    discussion.senderMessages.push_back(
-        SenderMessage{message.senderID, message.content});
+    // the index first, see loadIndex()
+    const uint64_t offset = std::filesystem::file_size(pathfile);
+    std::ofstream index(getIndexPath(pathfile),
+                        std::ios::binary | std::ios::app);
+    index.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+    index.close();
 
-    std::ofstream outfile(pathfile);
-    outfile << discussion.to_json().dump();
+    outfile << message.to_json().dump() << '\n';
 }
 
 // ==== Public ====
 
-void MessagesManager::addMessage(const UserID &senderID,
+bool MessagesManager::addMessage(const UserID &senderID,
                                  const UserID &recieverID,
                                  const std::string &content) {
     if (senderID == recieverID) {
-        return;
+        return false;
     }
 
+    std::lock_guard<std::mutex> lock(discussionsMutex_);
     if (!isThereDiscussion(senderID, recieverID)) {
         addDiscussion(senderID, recieverID);
     }
     writeMessage(getPathDiscussion(senderID, recieverID), {senderID, content});
+    return true;
 }
 
 bool MessagesManager::isThereDiscussion(const UserID &user1ID,
@@ -141,13 +319,9 @@ bool MessagesManager::isThereDiscussion(const UserID &user1ID,
           && count > 0)) {
         return false;
     } else {
-        // check if the discussion file exists (json file)
-        return std::filesystem::exists(dbManager_->getDatabasePath("data/chat/user") + std::to_string(user1ID)
-                                       + "_user" + std::to_string(user2ID)
-                                       + ".json")
-               || std::filesystem::exists(dbManager_->getDatabasePath("data/chat/user") + std::to_string(user2ID)
-                                          + "_user" + std::to_string(user1ID)
-                                          + ".json");
+        // check if the discussion file exists (json lines file, or json file
+        // before its migration)
+        return std::filesystem::exists(getPathDiscussion(user1ID, user2ID));
     }
 }
 
@@ -159,24 +333,18 @@ std::vector<int> MessagesManager::getAllUser(const UserID &userID) {
 
 std::optional<bindings::Conversation>
 MessagesManager::getDiscussion(const UserID &user1ID, const UserID &user2ID) {
-    std::ifstream infile(getPathDiscussion(user1ID, user2ID));
-    if (!infile.is_open()) {
-        std::cerr << "Error opening file" << std::endl;
-        return std::nullopt;
-    }
-
-    nlohmann::json jsondiscu;
-    try {
-        jsondiscu = nlohmann::json::parse(infile);
-    } catch (const std::runtime_error &e) {
-        std::cerr << "Received packet is not valid JSON: " << e.what()
-                  << std::endl;
-        return std::nullopt;
-    }
+    std::lock_guard<std::mutex> lock(discussionsMutex_);
+    return readMessages(getPathDiscussion(user1ID, user2ID), std::nullopt,
+                        std::numeric_limits<size_t>::max());
+}
 
-    bindings::Conversation discussion =
-        bindings::Conversation::from_json(jsondiscu);
-    return discussion;
+std::optional<bindings::Conversation>
+MessagesManager::getDiscussionPage(const UserID &user1ID,
+                                   const UserID &user2ID,
+                                   std::optional<size_t> before) {
+    std::lock_guard<std::mutex> lock(discussionsMutex_);
+    return readMessages(getPathDiscussion(user1ID, user2ID), before,
+                        bindings::Conversation::PAGE_SIZE);
 }
 
 std::vector<bindings::Conversation>
@@ -19,12 +19,16 @@
 #define MESSAGE_MANAGER_HPP
 
 #include <memory>
+#include <mutex>
 #include <nlohmann/detail/iterators/iter_impl.hpp>
 #include <nlohmann/detail/json_ref.hpp>
 #include <nlohmann/json.hpp>
 #include <nlohmann/json_fwd.hpp>
 #include <optional>
+#include <stddef.h>
+#include <stdint.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../../../common/bindings/conversation.hpp"
@@ -74,6 +78,14 @@ class MessagesManager {
 
   private:
     std::shared_ptr<DatabaseManager> dbManager_;
+    // the discussion files are appended to (and migrated) by the io threads:
+    // held by addMessage(), getDiscussion() and getDiscussionPage()
+    std::mutex discussionsMutex_;
+
+    // each discussion file has an index file next to it, holding the offset
+    // of each of its messages (a uint64_t each, in the server's byte order),
+    // so that a page is read without going through the messages before it
+    static constexpr std::string_view INDEX_EXTENSION = ".idx";
     /*
      * @brief generate a file Name, this file will contain the discussion
      * between the two users
@@ -111,6 +123,53 @@ class MessagesManager {
      */
     std::string getPathDiscussion(const UserID &user1ID, const UserID &user2ID);
 
+    /*
+     * @brief rewrite the given discussion file, if it still holds a whole
+     * conversation (old format), as one line per message
+     */
+    void migrateLegacyDiscussion(const std::string &pathfile);
+
+    /*
+     * @brief return the path of the index file of the given discussion file
+     */
+    static std::string getIndexPath(const std::string &pathfile);
+
+    /*
+     * @brief read the offset of the given message in the given index file
+     */
+    static std::optional<uint64_t> readIndexEntry(const std::string &indexPath,
+                                                  size_t messageIdx);
+
+    /*
+     * @brief write the index file of the given discussion file from scratch,
+     * going through the whole discussion (for the discussions written before
+     * the index, or whose index doesn't match them)
+     *
+     * @return the number of messages of the discussion, nullopt if it can't
+     * be read
+     */
+    std::optional<size_t> rebuildIndex(const std::string &pathfile);
+
+    /*
+     * @brief check that the index file of the given discussion file matches
+     * it, else rebuild it
+     *
+     * @return the number of messages of the discussion, nullopt if it can't
+     * be read
+     */
+    std::optional<size_t> loadIndex(const std::string &pathfile);
+
+    /*
+     * @brief read at most maxMessages messages of the given discussion file,
+     * the last ones before the message number before (or the last ones if
+     * nullopt). Only those messages are read, through the index file
+     *
+     * @return a conversation binding starting at its firstIndex message
+     */
+    std::optional<bindings::Conversation>
+    readMessages(const std::string &pathfile, std::optional<size_t> before,
+                 size_t maxMessages);
+
   public:
     /*
      * @brief Construct a new messagesManager object
@@ -132,9 +191,10 @@ class MessagesManager {
      *
      * @param content the content of the messages
      *
+     * @return true if the message was added (not sent to oneself)
      **/
 
-    void addMessage(const UserID &senderID, const UserID &recieverID,
+    bool addMessage(const UserID &senderID, const UserID &recieverID,
                     const std::string &content);
 
     /*
@@ -167,6 +227,22 @@ class MessagesManager {
     std::optional<bindings::Conversation> getDiscussion(const UserID &user1ID,
                                                         const UserID &user2ID);
 
+    /**
+     * @brief return a page (Conversation::PAGE_SIZE messages at most) of the
+     * discussion between two users
+     *
+     * @param user1ID Id of the first user
+     * @param user2ID Id of the second user
+     * @param before number of the message that follows the page, nullopt for
+     * the last page
+     *
+     * @return an optional conversation binding, starting at its firstIndex
+     * message.
+     */
+    std::optional<bindings::Conversation>
+    getDiscussionPage(const UserID &user1ID, const UserID &user2ID,
+                      std::optional<size_t> before);
+
     /*
      * @brief finds all users who have a discussion with the user : idUser
      * @param IdUser the user
@@ -0,0 +1,75 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "replays_manager.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../database_manager/database_manager.hpp"
+
+//==== Constructor ====
+ReplaysManager::ReplaysManager(std::shared_ptr<DatabaseManager> &db)
+    : dbManager_(db), numSavedReplays_{0} {
+
+    std::filesystem::path replaysPath(
+        dbManager_->getDatabasePath("data/replays/"));
+    if (!std::filesystem::exists(replaysPath)) {
+        std::filesystem::create_directories(replaysPath);
+    }
+
+    dbManager_->createTables("CREATE TABLE IF NOT EXISTS replays ("
+                             "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                             "file_path TEXT NOT NULL, "
+                             "created_at DATETIME DEFAULT CURRENT_TIMESTAMP);");
+}
+
+// ==== Private ====
+std::string ReplaysManager::generateFileName(std::string_view extension) {
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+
+    return dbManager_->getDatabasePath("data/replays/replay_")
+           + std::to_string(timestamp) + "_"
+           + std::to_string(numSavedReplays_++) + std::string(extension);
+}
+
+// ==== Public ====
+std::optional<std::string>
+ReplaysManager::saveReplay(std::span<const uint8_t> content,
+                           std::string_view extension) {
+    const std::string filePath = generateFileName(extension);
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file) {
+        std::cerr << "file error" << filePath << std::endl;
+        return std::nullopt;
+    }
+    file.write(reinterpret_cast<const char *>(content.data()),
+               static_cast<std::streamsize>(content.size()));
+    file.close();
+
+    const char *sqlRe = "INSERT INTO replays (file_path) VALUES (?);";
+    if (!dbManager_->executeSqlChangeData(sqlRe, {filePath})) {
+        return std::nullopt;
+    }
+
+    return filePath;
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef REPLAYS_MANAGER_HPP
+#define REPLAYS_MANAGER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+class DatabaseManager;
+
+/**
+ * @class ReplaysManager
+ *
+ * @brief Stores the replay files of the finished games and keeps track of them
+ * in the database.
+ */
+class ReplaysManager {
+  private:
+    std::shared_ptr<DatabaseManager> dbManager_;
+    std::atomic<size_t> numSavedReplays_;
+
+    /*
+     * @brief generate a new file name for a replay
+     *
+     * @param extension the extension of the file (e.g. ".rbr")
+     */
+    std::string generateFileName(std::string_view extension);
+
+  public:
+    /*
+     * @brief Construct a new ReplaysManager object
+     *
+     * @param db The database manager
+     */
+    ReplaysManager(std::shared_ptr<DatabaseManager> &db);
+
+    ~ReplaysManager() = default;
+
+    /*
+     * @brief write a replay to a new file and register it in the database
+     *
+     * @param content the (binary) content of the replay file
+     * @param extension the extension of the file (e.g. ".rbr")
+     *
+     * @return the path of the written file, nullopt if there has been an error
+     */
+    std::optional<std::string> saveReplay(std::span<const uint8_t> content,
+                                          std::string_view extension);
+};
+
+#endif // REPLAYS_MANAGER_HPP
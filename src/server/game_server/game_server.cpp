@@ -16,18 +16,29 @@
  */
 
 #include "game_server.hpp"
+#include "../../common/bindings/in_game/big_drop.hpp"
 #include "../../common/bindings/in_game/buy_bonus.hpp"
 #include "../../common/bindings/in_game/buy_penalty.hpp"
+#include "../../common/bindings/in_game/engine_tick.hpp"
+#include "../../common/bindings/in_game/game_input.hpp"
 #include "../../common/bindings/in_game/game_state_server.hpp"
+#include "../../common/bindings/in_game/hold_active_tetromino.hpp"
+#include "../../common/bindings/in_game/lockstep_sync.hpp"
 #include "../../common/bindings/in_game/move_active.hpp"
+#include "../../common/bindings/in_game/request_game_state_snapshot.hpp"
 #include "../../common/bindings/in_game/rotate_active.hpp"
+#include "../../common/types/overloaded.hpp"
 #include "game_engine/game_engine.hpp"
+#include "game_log/game_action.hpp"
 #include "game_mode/game_mode.hpp"
 #include "game_state/game_state.hpp"
 #include "player_state/player_state.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <variant>
 #include <vector>
 
 // ----------------------------------------------------------------------------
@@ -38,11 +49,24 @@ void GameServer::onTimerTick() {
     if (engine.gameIsFinished()) {
         pGameState_->setIsFinished();
         sendGameStates();
-        context_.stop();
+        isFinished_ = true;
+        // notify GameManager that the game is finished
+        callBackFinishGame_(gameId_);
         return;
     }
 
     engine.tick();
+    gameLog_.recordTick(*pGameState_);
+
+    const size_t tick = gameLog_.getNumTicks();
+    if (tick % bindings::StateHash::INTERVAL == 0) {
+        stateHashes_.emplace_back(tick, pGameState_->computeHash());
+        if (stateHashes_.size() > MAX_STATE_HASHES) {
+            stateHashes_.pop_front();
+        }
+    }
+
+    broadcastLockstep(bindings::EngineTick{tick}.to_json());
     sendGameStates();
 
     tickTimer_.expires_after(asio::chrono::milliseconds{tickDelayMs_});
@@ -51,19 +75,23 @@ void GameServer::onTimerTick() {
         tickDelayMs_ -= DECREASE_TICK_DELAY_MS;
     }
 
-    tickTimer_.async_wait([this](const asio::error_code &ec) {
-        if (!ec) {
-            onTimerTick();
-        }
-    });
+    tickTimer_.async_wait(
+        [this, self = shared_from_this()](const asio::error_code &ec) {
+            if (!ec) {
+                onTimerTick();
+            }
+        });
 }
 
 void GameServer::erasmePlayer(UserID userID) {
 
-    std::erase_if(pClientLinks_, [userID](auto pWeakClientLink) {
+    std::erase_if(pClientLinks_, [this, userID](auto pWeakClientLink) {
         if (std::shared_ptr<ClientLink> pClientLink = pWeakClientLink.lock()) {
             if (pClientLink->getUserID() == userID) {
-                pClientLink->exitGame();
+                // unless the client has already joined another game
+                if (pClientLink->getGameServer().lock().get() == this) {
+                    pClientLink->exitGame();
+                }
                 return true;
             }
             return false;
@@ -72,168 +100,362 @@ void GameServer::erasmePlayer(UserID userID) {
     });
 }
 
-// ----------------------------------------------------------------------------
-//                          PUBLIC METHODS
-// ----------------------------------------------------------------------------
+void GameServer::handleGameAction(UserID userID, const GameAction &gameAction,
+                                  bindings::InputSeq inputSeq) {
+    gameLog_.recordAction(userID, gameAction);
+    applyGameAction(engine, userID, gameAction);
 
-GameServer::GameServer(GameMode gameMode, std::vector<Player> &&players,
-                       GameID id, CallBackFinishGame callBackFinishGame)
-    :
+    if (inputSeq != 0) {
+        lastInputSeqs_[userID] = inputSeq;
+    }
 
-      tickDelayMs_{INITIAL_TICK_DELAY_MS}, context_{},
-      tickTimer_{context_, asio::chrono::milliseconds{tickDelayMs_}},
-      pGameState_{std::make_shared<GameState>(
-          gameMode,
-          [&] {
-              std::vector<PlayerState> playerStates;
-              playerStates.reserve(players.size());
-              std::transform(
-                  players.begin(), players.end(),
-                  std::back_inserter(playerStates), [](Player player) {
-                      return PlayerState(player.userID, player.username);
-                  });
-              return playerStates;
-          }())},
-      engine{pGameState_}, gameId_{id},
-      callBackFinishGame_{callBackFinishGame} {}
+    broadcastLockstep(
+        bindings::GameInput{gameLog_.getNumTicks(), userID, gameAction}
+            .to_json());
+}
 
-void GameServer::enqueueBinding(UserID userId, const std::string &bindingStr) {
-    try {
-        nlohmann::json j = nlohmann::json::parse(bindingStr);
+bindings::InputSeq GameServer::getLastInputSeq(UserID userID) const {
+    auto it = lastInputSeqs_.find(userID);
+    return it != lastInputSeqs_.end() ? it->second : 0;
+}
 
-        bindings::BindingType bindingType = j.at(bindings::PACKET_TYPE_FIELD);
+bool GameServer::isControlBinding(const bindings::ClientPacket &packet) {
+    return std::holds_alternative<bindings::QuitGame>(packet)
+           || std::holds_alternative<bindings::RequestGameStateSnapshot>(packet)
+           || std::holds_alternative<bindings::StateHash>(packet);
+}
 
-        switch (bindingType) {
+bool GameServer::usesLockstep(const std::shared_ptr<ClientLink> &pClientLink) {
+    return pClientLink->hasFeature(bindings::ClientFeature::Lockstep);
+}
 
-        case bindings::BindingType::BigDrop:
-            asio::post(context_, [this, userId]() {
-                engine.bigDrop(userId);
-                sendGameStates();
-            });
-            break;
+void GameServer::sendLockstepSync(
+    const std::shared_ptr<ClientLink> &pClientLink) {
+    const UserID userID = pClientLink->getUserID();
+    const std::vector<GameLogPlayer> &players = gameLog_.getPlayers();
+
+    const bool isPlayer =
+        std::any_of(players.begin(), players.end(),
+                    [userID](const GameLogPlayer &player) {
+                        return player.userID == userID;
+                    });
+
+    pClientLink->sendPackage(
+        bindings::LockstepSync::fromGameLog(
+            gameLog_, isPlayer ? std::make_optional(userID) : std::nullopt)
+            .to_json());
+}
 
-        case bindings::BindingType::BuyBonus: {
-            asio::post(
-                context_,
-                [this, userId, buyBonus = bindings::BuyBonus::from_json(j)]() {
-                    engine.tryBuyEffect(userId, buyBonus.bonusType);
-                    sendGameStates();
-                });
-            break;
-        }
+void GameServer::broadcastLockstep(const nlohmann::json &binding) {
+    std::shared_ptr<const ClientLink::Buffer> package;
 
-        case bindings::BindingType::BuyPenalty: {
-            asio::post(
-                context_, [this, userId,
-                           buyPenalty = bindings::BuyPenalty::from_json(j)]() {
-                    engine.tryBuyEffect(userId, buyPenalty.penaltyType,
-                                        buyPenalty.stashForLater);
-                    sendGameStates();
-                });
-            break;
+    for (const std::weak_ptr<ClientLink> &pWeakClientLink : pClientLinks_) {
+        if (std::shared_ptr<ClientLink> pClientLink = pWeakClientLink.lock()) {
+            if (usesLockstep(pClientLink)) {
+                // dumped for the first lockstep client only
+                if (!package) {
+                    package = ClientLink::makeSharedPackage(binding);
+                }
+                pClientLink->sendShared(package);
+            }
         }
+    }
+}
 
-        case bindings::BindingType::EmptyPenaltyStash:
-            asio::post(context_, [this, userId]() {
-                engine.emptyPenaltyStash(userId);
-                sendGameStates();
-            });
-            break;
+void GameServer::checkStateHash(UserID userID,
+                                const bindings::StateHash &stateHash) {
+    auto it = std::find_if(stateHashes_.begin(), stateHashes_.end(),
+                           [&stateHash](const auto &tickHash) {
+                               return tickHash.first == stateHash.tick;
+                           });
 
-        case bindings::BindingType::HoldActiveTetromino:
-            asio::post(context_, [this, userId]() {
-                engine.holdActiveTetromino(userId);
-                sendGameStates();
-            });
-            break;
+    // too old (or not a checked tick): nothing to compare to
+    if (it == stateHashes_.end() || it->second == stateHash.hash) {
+        return;
+    }
 
-        case bindings::BindingType::MoveActive: {
-            asio::post(
-                context_, [this, userId,
-                           moveActive = bindings::MoveActive::from_json(j)]() {
-                    engine.tryMoveActive(userId, moveActive.tetrominoMove);
-                    sendGameStates();
-                });
-            break;
-        }
+    std::cerr << "lockstep desync of user " << userID << " at tick "
+              << stateHash.tick << ", resyncing" << std::endl;
 
-        case bindings::BindingType::RotateActive: {
-            asio::post(
-                context_,
-                [this, userId,
-                 rotateActive = bindings::RotateActive::from_json(j)]() {
-                    engine.tryRotateActive(userId,
-                                           rotateActive.rotateClockwise);
-                    sendGameStates();
-                });
-            break;
-        }
+    if (std::shared_ptr<ClientLink> pClientLink = getClientLink(userID)) {
+        sendLockstepSync(pClientLink);
+    }
+}
 
-        case bindings::BindingType::SelectTarget: {
-            asio::post(
-                context_,
-                [this, userId,
-                 selectTarget = bindings::SelectTarget::from_json(j)]() {
-                    engine.selectTarget(userId, selectTarget.targetId);
-                    sendGameStates();
-                });
-            break;
+std::shared_ptr<ClientLink> GameServer::getClientLink(UserID userID) const {
+    for (const std::weak_ptr<ClientLink> &pWeakClientLink : pClientLinks_) {
+        std::shared_ptr<ClientLink> pClientLink = pWeakClientLink.lock();
+        if (pClientLink && pClientLink->getUserID() == userID) {
+            return pClientLink;
         }
+    }
+
+    return nullptr;
+}
+
+void GameServer::sendGameState(const std::shared_ptr<ClientLink> &pClientLink,
+                               GameStateBroadcast &broadcast) {
+    const UserID userID = pClientLink->getUserID();
+    const bool isPlayer =
+        pClientLink->getUserState() == bindings::State::InGame;
+    const bindings::InputSeq lastInputSeq =
+        isPlayer ? getLastInputSeq(userID) : 0;
+    const bool isBinary =
+        pClientLink->hasFeature(bindings::ClientFeature::BinaryGameState);
+
+    if (!isPlayer
+        && (!isBinary
+            || !pClientLink->hasFeature(
+                bindings::ClientFeature::DeltaGameState))) {
+        pClientLink->sendGameState(broadcast.getViewerPacket(isBinary));
+        return;
+    }
+    if (!isBinary) {
+        pClientLink->sendGameState(std::make_shared<const ClientLink::Buffer>(
+            broadcast.dumpForPlayer(userID, lastInputSeq)));
+        return;
+    }
 
-        case bindings::BindingType::QuitGame:
-            erasmePlayer(userId);
-            engine.quitGame(userId);
-            break;
+    const std::optional<UserID> selfID =
+        isPlayer ? std::make_optional(userID) : std::nullopt;
+    nlohmann::json j_self =
+        isPlayer ? broadcast.serializeSelf(userID) : nlohmann::json{};
+    const bool hasSelf = !j_self.is_null();
 
-        default:
-            std::cerr << "unkown binding" << std::endl;
-            break;
+    if (!pClientLink->hasFeature(bindings::ClientFeature::DeltaGameState)) {
+        pClientLink->sendGameState(ClientLink::makeSharedPackage(
+            bindings::GameStateMessage::fromEncoded(
+                broadcast.encode(j_self, selfID), hasSelf, lastInputSeq)));
+        return;
+    }
+
+    std::vector<GameStateBroadcast::ExternalView> externals =
+        broadcast.getExternalViews(selfID);
+
+    auto it = sentGameStates_.find(userID);
+    if (it != sentGameStates_.end()
+        && it->second.numDeltas < FULL_SNAPSHOT_INTERVAL) {
+        SentGameState &sentGameState = it->second;
+
+        if (std::optional<std::vector<uint8_t>> delta =
+                broadcast.encodeDelta(sentGameState.j_self,
+                                      sentGameState.externals, j_self,
+                                      selfID)) {
+            const bindings::GameStateID id = sentGameState.id + 1;
+            pClientLink->sendGameState(ClientLink::makeSharedPackage(
+                bindings::GameStateDelta{id, sentGameState.id,
+                                         std::move(*delta), lastInputSeq}
+                    .to_json()));
+
+            sentGameState =
+                SentGameState{id, std::move(j_self), std::move(externals),
+                              sentGameState.numDeltas + 1};
+            return;
         }
-    } catch (const std::runtime_error &e) {
-        std::cerr << "Received packet is not valid JSON: " << e.what()
-                  << std::endl;
+    }
+
+    // first GameState, time for a full one or the players changed
+    const bindings::GameStateID id =
+        it != sentGameStates_.end() ? it->second.id + 1 : 1;
+    pClientLink->sendGameState(ClientLink::makeSharedPackage(
+        bindings::GameStateMessage::fromEncoded(
+            broadcast.encode(j_self, selfID), hasSelf, lastInputSeq, id)));
+
+    sentGameStates_[userID] =
+        SentGameState{id, std::move(j_self), std::move(externals), 0};
+}
+
+void GameServer::sendGameStateSnapshot(UserID userID) {
+    auto it = sentGameStates_.find(userID);
+    if (it != sentGameStates_.end()) {
+        it->second.numDeltas = FULL_SNAPSHOT_INTERVAL;
+    }
+
+    if (std::shared_ptr<ClientLink> pClientLink = getClientLink(userID)) {
+        GameStateBroadcast broadcast{*pGameState_};
+        sendGameState(pClientLink, broadcast);
     }
 }
 
-void GameServer::run() {
-    // Setup or async engine-tick-clock
-    tickTimer_.async_wait([this](const asio::error_code &ec) {
-        if (!ec) {
-            onTimerTick();
+bool GameServer::handleBinding(UserID userId,
+                               bindings::ClientPacket &packet) {
+    std::optional<GameAction> gameAction;
+    bindings::InputSeq inputSeq = 0;
+
+    std::visit(
+        Overloaded{
+            [&](const bindings::BigDrop &bigDrop) {
+                gameAction = game_action::BigDrop{};
+                inputSeq = bigDrop.seq;
+            },
+            [&](const bindings::BuyBonus &buyBonus) {
+                gameAction = game_action::BuyEffect{buyBonus.bonusType, false};
+            },
+            [&](const bindings::BuyPenalty &buyPenalty) {
+                gameAction = game_action::BuyEffect{buyPenalty.penaltyType,
+                                                    buyPenalty.stashForLater};
+            },
+            [&](const bindings::EmptyPenaltyStash &) {
+                gameAction = game_action::EmptyPenaltyStash{};
+            },
+            [&](const bindings::HoldActiveTetromino &holdActiveTetromino) {
+                gameAction = game_action::HoldActiveTetromino{};
+                inputSeq = holdActiveTetromino.seq;
+            },
+            [&](const bindings::MoveActive &moveActive) {
+                gameAction = game_action::MoveActive{moveActive.tetrominoMove};
+                inputSeq = moveActive.seq;
+            },
+            [&](const bindings::RotateActive &rotateActive) {
+                gameAction =
+                    game_action::RotateActive{rotateActive.rotateClockwise};
+                inputSeq = rotateActive.seq;
+            },
+            [&](const bindings::SelectTarget &selectTarget) {
+                gameAction = game_action::SelectTarget{selectTarget.targetId};
+            },
+            [&](const bindings::QuitGame &) {
+                erasmePlayer(userId);
+                gameAction = game_action::QuitGame{};
+            },
+            [&](const bindings::StateHash &stateHash) {
+                checkStateHash(userId, stateHash);
+            },
+            [&](const bindings::RequestGameStateSnapshot &) {
+                sendGameStateSnapshot(userId);
+            },
+            [](const auto &) { std::cerr << "unkown binding" << std::endl; },
+        },
+        packet);
+
+    if (!gameAction.has_value()) {
+        return false;
+    }
+
+    handleGameAction(userId, *gameAction, inputSeq);
+    return true;
+}
+
+void GameServer::drainBindings() {
+    // reset first: a binding pushed from now on posts another drain
+    isDrainPosted_.exchange(false, std::memory_order_acq_rel);
+
+    bool isGameStateChanged = false;
+    while (std::optional<PendingBinding> pendingBinding =
+               pendingBindings_.tryPop()) {
+        isGameStateChanged |=
+            handleBinding(pendingBinding->userID, pendingBinding->packet);
+    }
+
+    if (isGameStateChanged) {
+        sendGameStates();
+    }
+}
+
+// ----------------------------------------------------------------------------
+//                          PUBLIC METHODS
+// ----------------------------------------------------------------------------
+
+GameServer::GameServer(GameMode gameMode, std::vector<Player> &&players,
+                       GameID id, asio::io_context &gamesContext,
+                       CallBackFinishGame callBackFinishGame)
+    :
+
+      tickDelayMs_{INITIAL_TICK_DELAY_MS},
+      strand_{asio::make_strand(gamesContext)},
+      tickTimer_{strand_, asio::chrono::milliseconds{tickDelayMs_}},
+      gameLog_{gameMode, Rng::randomSeed(),
+               [&] {
+                   std::vector<GameLogPlayer> logPlayers;
+                   logPlayers.reserve(players.size());
+                   std::transform(players.begin(), players.end(),
+                                  std::back_inserter(logPlayers),
+                                  [](Player player) {
+                                      return GameLogPlayer{player.userID,
+                                                           player.username};
+                                  });
+                   return logPlayers;
+               }()},
+      pGameState_{gameLog_.createInitialGameState()}, engine{pGameState_},
+      gameId_{id},
+      callBackFinishGame_{callBackFinishGame} {}
+
+void GameServer::enqueueBinding(UserID userId,
+                                bindings::ClientPacket &&packet) {
+    PendingBinding pendingBinding{userId, std::move(packet)};
+    if (!pendingBindings_.tryPush(std::move(pendingBinding))) {
+        if (!isControlBinding(pendingBinding.packet)) {
+            std::cerr << "too many pending bindings in game " << gameId_
+                      << ", dropping an input" << std::endl;
+            return;
         }
-    });
 
-    context_.run();
+        // handled after the bindings queued before it, the control bindings
+        // of each client are rate limited (see ClientLink::GAME_CONTROLS_RATE)
+        // so these posts stay bounded
+        postToGame(
+            [this, pendingBinding = std::move(pendingBinding)]() mutable {
+                drainBindings();
+                if (handleBinding(pendingBinding.userID,
+                                  pendingBinding.packet)) {
+                    sendGameStates();
+                }
+            });
+        return;
+    }
 
-    // End of context_.run() means the game is finished
+    // a single post for all the bindings queued until the strand runs
+    if (!isDrainPosted_.exchange(true, std::memory_order_acq_rel)) {
+        postToGame([this]() { drainBindings(); });
+    }
+}
 
-    // notify GameManager that the game is finished
-    callBackFinishGame_(gameId_);
+void GameServer::start() {
+    // Setup or async engine-tick-clock, its handler runs on the strand
+    tickTimer_.async_wait(
+        [this, self = shared_from_this()](const asio::error_code &ec) {
+            if (!ec) {
+                onTimerTick();
+            }
+        });
 }
 
 void GameServer::sendGameStates() {
+    GameStateBroadcast broadcast{*pGameState_};
+
     size_t i = 0;
     while (i < pClientLinks_.size()) {
-        if (std::shared_ptr<ClientLink> pClientLink = pClientLinks_[i].lock()) {
-            if (pClientLink->getUserState() == bindings::State::InGame) {
-                pClientLink->sendPackage(
-                    bindings::GameStateMessage::serializeForPlayer(
-                        *pGameState_, pClientLink->getUserID()));
-            } else {
-                pClientLink->sendPackage(
-                    bindings::GameStateMessage::serializeForViewer(
-                        *pGameState_));
-            }
+        std::shared_ptr<ClientLink> pClientLink = pClientLinks_[i].lock();
+        if (pClientLink && !usesLockstep(pClientLink)) {
+            sendGameState(pClientLink, broadcast);
         }
         ++i;
     }
 }
 
 void GameServer::addClientLink(std::weak_ptr<ClientLink> clientLink) {
-    pClientLinks_.push_back(clientLink);
+    // the links are only used on the game's strand
+    postToGame([this, clientLink]() {
+        std::shared_ptr<ClientLink> pClientLink = clientLink.lock();
+        if (!pClientLink) {
+            return;
+        }
+
+        pClientLinks_.push_back(clientLink);
+        if (usesLockstep(pClientLink)) {
+            sendLockstepSync(pClientLink);
+        } else {
+            // the client has none of the GameStates sent to a previous link
+            sentGameStates_.erase(pClientLink->getUserID());
+            GameStateBroadcast broadcast{*pGameState_};
+            sendGameState(pClientLink, broadcast);
+        }
+    });
 }
 
-void GameServer::quitGameAsViewer(UserID userID) { erasmePlayer(userID); }
+void GameServer::quitGameAsViewer(UserID userID) {
+    postToGame([this, userID]() { erasmePlayer(userID); });
+}
 
 // ==== getters ====
 
@@ -254,3 +476,5 @@ int GameServer::getPlayerScore(const UserID userId) const {
 const std::vector<std::weak_ptr<ClientLink>> &GameServer::getClientLinks() {
     return pClientLinks_;
 }
+
+const GameLog &GameServer::getGameLog() const { return gameLog_; }
@@ -18,14 +18,28 @@
 #ifndef GAME_SERVER_HPP
 #define GAME_SERVER_HPP
 
+#include "../../common/bindings/client_packet.hpp"
+#include "../../common/bindings/in_game/game_state_delta.hpp"
+#include "../../common/bindings/in_game/input_seq.hpp"
 #include "../../common/bindings/in_game/select_target.hpp"
+#include "../../common/bindings/in_game/state_hash.hpp"
 
+#include "../bounded_mpsc_queue/bounded_mpsc_queue.hpp"
 #include "../client_link/client_link.hpp"
+#include "game_state_broadcast.hpp"
 #include "game_engine/game_engine.hpp"
+#include "game_log/game_log.hpp"
 #include "player_state/player_state.hpp"
 
 #include <asio.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <unordered_map>
+
 using GameID = size_t;
 
 using CallBackFinishGame = std::function<void(GameID)>;
@@ -35,24 +49,64 @@ class ClientLink;
 struct Player {
     UserID userID;
     std::string username;
+    // the smoothed round trip time of their connection when they joined the
+    // matchmaking, nullopt if it wasn't measured yet
+    std::optional<std::chrono::microseconds> rtt = std::nullopt;
+};
+
+/**
+ * @brief The last GameState sent to a client with the DeltaGameState feature,
+ * the base of the next GameStateDelta sent to it.
+ */
+struct SentGameState {
+    bindings::GameStateID id;
+    // the GameState's "self", null for a viewer
+    nlohmann::json j_self;
+    // shared with the other recipients of the broadcast
+    std::vector<GameStateBroadcast::ExternalView> externals;
+    // number of GameStateDelta sent since the last full GameState
+    size_t numDeltas;
 };
 
 /**
  * @class GameServer
  * @brief handle the progress of a game, manage game packages and send gameState
  *
+ * The games share the workers of the GamesManager: everything a game does
+ * runs on its own strand, so it is never run by two workers at once.
  */
 
-class GameServer {
+class GameServer : public std::enable_shared_from_this<GameServer> {
   private:
     static constexpr size_t INITIAL_TICK_DELAY_MS = 1000;
     static constexpr size_t MIN_TICK_DELAY_MS = 1000;
     static constexpr size_t DECREASE_TICK_DELAY_MS = 20;
+    // number of recent state hashes kept to check the lockstep clients'
+    static constexpr size_t MAX_STATE_HASHES = 8;
+    // number of GameStateDelta sent to a client between two full GameStates
+    static constexpr size_t FULL_SNAPSHOT_INTERVAL = 100;
+    // number of bindings the io threads can queue for the game before it
+    // handles them: well above what all the players send between two runs,
+    // and small enough for thousands of games. The inputs beyond it are
+    // dropped, the control bindings are posted on their own
+    // (see enqueueBinding())
+    static constexpr size_t MAX_PENDING_BINDINGS = 64;
+
+    // a binding received by an io thread, handled on the game's strand
+    struct PendingBinding {
+        UserID userID;
+        bindings::ClientPacket packet;
+    };
     std::mutex gameMutex_;
     size_t tickDelayMs_;
 
-    asio::io_context context_;
+    asio::strand<asio::io_context::executor_type> strand_;
     asio::steady_timer tickTimer_;
+    // set on the strand when the game ends, the handlers still queued are
+    // then skipped
+    bool isFinished_ = false;
+    // every action applied to the engine, to be able to replay the game
+    GameLog gameLog_;
     GameStatePtr pGameState_;
     GameEngine engine;
     GameID gameId_;
@@ -60,6 +114,33 @@ class GameServer {
     CallBackFinishGame callBackFinishGame_;
     // contains the weap_ptr of clients who playing or watching the
     std::vector<std::weak_ptr<ClientLink>> pClientLinks_;
+    // (tick, hash) of the GameState every bindings::StateHash::INTERVAL ticks
+    std::deque<std::pair<size_t, uint64_t>> stateHashes_;
+    // sequence number of the last input applied for each player, echoed in
+    // their GameState for client-side prediction
+    std::unordered_map<UserID, bindings::InputSeq> lastInputSeqs_;
+    // last GameState sent to each client with the DeltaGameState feature.
+    // The links are ordered and reliable (TCP), so the client has it once
+    // the next one is sent: it is the base of the next delta.
+    std::unordered_map<UserID, SentGameState> sentGameStates_;
+    // handed over without locks by the io threads (see enqueueBinding())
+    BoundedMpscQueue<PendingBinding, MAX_PENDING_BINDINGS> pendingBindings_;
+    // true from the moment a drainBindings() is posted until it starts
+    std::atomic<bool> isDrainPosted_ = false;
+
+    /**
+     * @brief Runs the given handler on the game's strand, unless the game is
+     * finished by then. The game is kept alive until it has run.
+     */
+    template <typename Handler> void postToGame(Handler handler) {
+        asio::post(strand_, [self = shared_from_this(),
+                             handler = std::move(handler)]() mutable {
+            if (!self->isFinished_) {
+                handler();
+            }
+        });
+    }
+
     /**
      * @brief Signals the engine that an engine tick occured. Resets the timer
      * for the next tick.
@@ -70,11 +151,87 @@ class GameServer {
      */
     void erasmePlayer(UserID userID);
 
+    /**
+     * @brief Records the given action in the game log, applies it to the
+     * engine and sends it to the lockstep clients. The GameState is sent by
+     * drainBindings(). Must run on the game's strand.
+     */
+    void handleGameAction(UserID userID, const GameAction &gameAction,
+                          bindings::InputSeq inputSeq);
+
+    /**
+     * @brief Handles the given binding of the given user. Must run on the
+     * game's strand.
+     *
+     * @return true if it changed the GameState
+     */
+    bool handleBinding(UserID userID, bindings::ClientPacket &packet);
+
+    /**
+     * @brief Handles all the queued bindings, then sends a single GameState
+     * for all of them. Must run on the game's strand.
+     */
+    void drainBindings();
+
+    bindings::InputSeq getLastInputSeq(UserID userID) const;
+
+    /**
+     * @brief Returns true if the given binding must never be dropped by a
+     * full queue: leaving the game, asking for a snapshot or checking the
+     * state hash, which a client doesn't send again (see
+     * bindings::isGameControlBinding).
+     */
+    static bool isControlBinding(const bindings::ClientPacket &packet);
+
+    /**
+     * @brief Returns true if the given client simulates the game itself.
+     */
+    static bool usesLockstep(const std::shared_ptr<ClientLink> &pClientLink);
+
+    /**
+     * @brief Returns the link of the given user if they are in the game
+     * (playing or viewing), nullptr otherwise.
+     */
+    std::shared_ptr<ClientLink> getClientLink(UserID userID) const;
+
+    /**
+     * @brief Sends the GameState, serialized once for the whole broadcast, to
+     * the given client, as a GameStateDelta when it supports them. Must run
+     * on the game's strand.
+     */
+    void sendGameState(const std::shared_ptr<ClientLink> &pClientLink,
+                       GameStateBroadcast &broadcast);
+
+    /**
+     * @brief Sends a full GameState to the given user, who couldn't apply a
+     * GameStateDelta. Must run on the game's strand.
+     */
+    void sendGameStateSnapshot(UserID userID);
+
+    /**
+     * @brief Sends the last keyframe of the game's log and the inputs since
+     * then to the given lockstep client so that it can (re)build the current
+     * GameState. Must run on the game's strand.
+     */
+    void sendLockstepSync(const std::shared_ptr<ClientLink> &pClientLink);
+
+    /**
+     * @brief Sends the given binding to every lockstep client.
+     */
+    void broadcastLockstep(const nlohmann::json &binding);
+
+    /**
+     * @brief Resyncs the given lockstep client if its hash doesn't match the
+     * server's. Must run on the game's strand.
+     */
+    void checkStateHash(UserID userID, const bindings::StateHash &stateHash);
+
   public:
     /**
      * @brief Constructor.
      */
     GameServer(GameMode gameMode, std::vector<Player> &&players, GameID id,
+               asio::io_context &gamesContext,
                CallBackFinishGame callBackFinishGame);
     GameServer(const GameServer &) = delete;
     GameServer(GameServer &&) = delete;
@@ -82,27 +239,35 @@ class GameServer {
     GameServer &operator=(GameServer &&) = delete;
 
     /**
-     * @brief Enqueues a new binding as a string (json).
+     * @brief Enqueues a new binding received from the given user, from any
+     * thread. If the game has too many bindings pending, an input is dropped
+     * and a control binding is posted to the game's strand on its own.
      */
-    void enqueueBinding(UserID userId, const std::string &bindingStr);
+    void enqueueBinding(UserID userId, bindings::ClientPacket &&packet);
 
     /**
      * @brief Sends the GameState to all the connected people in the game
-     * include viewers. TODO: (not implemented yet)
+     * include viewers, except the lockstep clients (which simulate it).
+     * The parts shared by the recipients are serialized once. Must run on
+     * the game's strand.
      */
     void sendGameStates();
 
     /**
-     * @brief Runs the server. This function returns as soon as the game is
-     * finished.
+     * @brief Starts the game on its strand and returns at once. The
+     * CallBackFinishGame is called on the strand when the game is finished.
      */
-    void run();
+    void start();
 
     /**
-     * @brief add clientLink in the clients lists
+     * @brief add clientLink in the clients lists (on the game's strand) and
+     * send it the current state of the game
      */
     void addClientLink(std::weak_ptr<ClientLink> clientLink);
 
+    /**
+     * @brief remove the viewer from the clients lists (on the game's strand)
+     */
     void quitGameAsViewer(UserID userID);
 
     // === getters ===
@@ -114,6 +279,12 @@ class GameServer {
     GameMode getGameMode() const;
 
     int getPlayerScore(const UserID userId) const;
+
+    /**
+     * @brief Returns the log of the game. Only safe to call once the game is
+     * finished (i.e. from the CallBackFinishGame).
+     */
+    const GameLog &getGameLog() const;
 };
 
 #endif // GAME_SERVER_HPP
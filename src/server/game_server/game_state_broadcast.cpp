@@ -0,0 +1,227 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "game_state_broadcast.hpp"
+
+#include "../../common/bindings/in_game/game_state_server.hpp"
+#include "game_state/game_state_codec.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+// --- private ---
+
+const std::string &GameStateBroadcast::getText(External &external) {
+    if (!external.text) {
+        external.text = external.j_view->dump();
+    }
+
+    return *external.text;
+}
+
+std::span<const uint8_t> GameStateBroadcast::getEncoded(External &external) {
+    if (!external.encoded) {
+        external.encoded = game_state_codec::encodeExternal(*external.j_view);
+    }
+
+    return *external.encoded;
+}
+
+std::span<const uint8_t>
+GameStateBroadcast::getEncodedDelta(External &external,
+                                    const ExternalView &j_base) {
+    auto it = std::find_if(
+        external.deltas.begin(), external.deltas.end(),
+        [&j_base](const auto &delta) { return delta.first == j_base; });
+
+    if (it == external.deltas.end()) {
+        external.deltas.emplace_back(
+            j_base,
+            game_state_codec::encodeExternalDelta(*j_base, *external.j_view));
+        it = std::prev(external.deltas.end());
+    }
+
+    return it->second;
+}
+
+std::string GameStateBroadcast::joinTexts(std::optional<UserID> selfID) {
+    std::string text;
+
+    bool isFirst = true;
+    for (External &external : externals_) {
+        if (external.userID == selfID) {
+            continue;
+        }
+
+        if (!isFirst) {
+            text.push_back(',');
+        }
+        text.append(getText(external));
+        isFirst = false;
+    }
+
+    return text;
+}
+
+// --- public ---
+
+GameStateBroadcast::GameStateBroadcast(const GameState &gameState)
+    : gameState_{gameState},
+      gameModeText_{nlohmann::json(gameState.getGameMode()).dump()},
+      isFinishedText_{nlohmann::json(gameState.getIsFinished()).dump()} {
+    for (const auto &[userID, playerTetris] :
+         gameState_.getUserToPlayerTetris()) {
+        externals_.push_back(External{
+            userID,
+            std::make_shared<const nlohmann::json>(
+                playerTetris.serializeExternal()),
+            std::nullopt,
+            std::nullopt,
+            {}});
+    }
+
+    nlohmann::json j_prices;
+    GameState::serializeEffectPrices(gameState_.getGameMode(), j_prices);
+
+    bonusToPriceText_ = j_prices.at("bonusToPrice").dump();
+    penaltyToPriceText_ = j_prices.at("penaltyToPrice").dump();
+}
+
+nlohmann::json GameStateBroadcast::serializeSelf(UserID userID) const {
+    const auto &userToPlayerTetris = gameState_.getUserToPlayerTetris();
+    auto it = userToPlayerTetris.find(userID);
+
+    return it != userToPlayerTetris.end() ? it->second.serializeSelf()
+                                          : nlohmann::json{};
+}
+
+std::vector<GameStateBroadcast::ExternalView>
+GameStateBroadcast::getExternalViews(std::optional<UserID> selfID) const {
+    std::vector<ExternalView> externalViews;
+    externalViews.reserve(externals_.size());
+
+    for (const External &external : externals_) {
+        if (external.userID != selfID) {
+            externalViews.push_back(external.j_view);
+        }
+    }
+
+    return externalViews;
+}
+
+std::vector<uint8_t> GameStateBroadcast::encode(const nlohmann::json &j_self,
+                                                std::optional<UserID> selfID) {
+    std::vector<std::span<const uint8_t>> encodedExternals;
+    encodedExternals.reserve(externals_.size());
+
+    for (External &external : externals_) {
+        if (external.userID != selfID) {
+            encodedExternals.push_back(getEncoded(external));
+        }
+    }
+
+    return game_state_codec::encodeFromParts(gameState_.getIsFinished(),
+                                             gameState_.getGameMode(), j_self,
+                                             encodedExternals);
+}
+
+std::optional<std::vector<uint8_t>> GameStateBroadcast::encodeDelta(
+    const nlohmann::json &j_baseSelf,
+    const std::vector<ExternalView> &baseExternals,
+    const nlohmann::json &j_self, std::optional<UserID> selfID) {
+    std::vector<std::span<const uint8_t>> encodedExternals;
+    encodedExternals.reserve(baseExternals.size());
+
+    for (External &external : externals_) {
+        if (external.userID == selfID) {
+            continue;
+        }
+
+        // the players changed since the base
+        if (encodedExternals.size() == baseExternals.size()) {
+            return std::nullopt;
+        }
+
+        encodedExternals.push_back(getEncodedDelta(
+            external, baseExternals.at(encodedExternals.size())));
+    }
+
+    if (encodedExternals.size() != baseExternals.size()) {
+        return std::nullopt;
+    }
+
+    return game_state_codec::encodeDeltaFromParts(
+        gameState_.getIsFinished(), j_baseSelf, j_self, encodedExternals);
+}
+
+std::string GameStateBroadcast::dumpForPlayer(UserID userID,
+                                              bindings::InputSeq lastInputSeq) {
+    // same layout as GameState::serializeForPlayer().dump(), whose keys are
+    // sorted
+    std::string text;
+    text.append(R"({"bonusToPrice":)")
+        .append(bonusToPriceText_)
+        .append(R"(,"externals":[)")
+        .append(joinTexts(userID))
+        .append(R"(],"gameMode":)")
+        .append(gameModeText_)
+        .append(R"(,"isFinished":)")
+        .append(isFinishedText_)
+        .append(R"(,"penaltyToPrice":)")
+        .append(penaltyToPriceText_);
+
+    const nlohmann::json j_self = serializeSelf(userID);
+    if (!j_self.is_null()) {
+        text.append(R"(,"self":)").append(j_self.dump());
+    }
+
+    text.push_back('}');
+
+    return bindings::GameStateMessage::dumpForPlayer(text, lastInputSeq);
+}
+
+std::shared_ptr<const std::string>
+GameStateBroadcast::getViewerPacket(bool isBinary) {
+    std::shared_ptr<const std::string> &packet =
+        isBinary ? binaryViewerPacket_ : viewerPacket_;
+
+    if (packet) {
+        return packet;
+    }
+
+    if (isBinary) {
+        packet = std::make_shared<const std::string>(
+            bindings::GameStateMessage::fromEncoded(
+                encode(nlohmann::json{}, std::nullopt), false)
+                .dump());
+    } else {
+        // same layout as GameState::serializeForViewer().dump()
+        std::string text;
+        text.append(R"({"externals":[)")
+            .append(joinTexts(std::nullopt))
+            .append(R"(],"gameMode":)")
+            .append(gameModeText_)
+            .append(R"(,"isFinished":)")
+            .append(isFinishedText_);
+        text.push_back('}');
+
+        packet = std::make_shared<const std::string>(
+            bindings::GameStateMessage::dumpForViewer(text));
+    }
+
+    return packet;
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef GAME_STATE_BROADCAST_HPP
+#define GAME_STATE_BROADCAST_HPP
+
+#include "../../common/bindings/in_game/input_seq.hpp"
+
+#include "game_state/game_state.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A GameState serialized once for all the recipients of a broadcast:
+ * each player's external view is serialized once, then dumped (JSON clients)
+ * or encoded (binary clients), also once, and spliced into each recipient's
+ * packet, so that only the recipient's own view is serialized for them. The
+ * same goes for the deltas of the external views, which are encoded once per
+ * base (usually the previous broadcast's view, shared by every recipient).
+ * The viewers all get the same packet.
+ *
+ * Must not outlive the GameState, which must not change meanwhile.
+ */
+class GameStateBroadcast {
+  public:
+    /**
+     * @brief The external view of a player, shared by all the GameStates it
+     * was sent in and kept as the base of the next deltas (see
+     * SentGameState).
+     */
+    using ExternalView = std::shared_ptr<const nlohmann::json>;
+
+  private:
+    struct External {
+        UserID userID;
+        ExternalView j_view;
+        // dumped and encoded when the first recipient needs them
+        std::optional<std::string> text;
+        std::optional<std::vector<uint8_t>> encoded;
+        // encoded as a delta from each base a recipient had
+        std::vector<std::pair<ExternalView, std::vector<uint8_t>>> deltas;
+    };
+
+    const GameState &gameState_;
+
+    // in the GameState's order
+    std::vector<External> externals_;
+    // the parts of the player's GameStates shared by everyone, dumped
+    std::string bonusToPriceText_;
+    std::string penaltyToPriceText_;
+    std::string gameModeText_;
+    std::string isFinishedText_;
+
+    // GameStateViewer bindings, dumped for the first viewer and shared by
+    // the writes of all of them
+    std::shared_ptr<const std::string> viewerPacket_;
+    std::shared_ptr<const std::string> binaryViewerPacket_;
+
+    const std::string &getText(External &external);
+
+    std::span<const uint8_t> getEncoded(External &external);
+
+    std::span<const uint8_t> getEncodedDelta(External &external,
+                                             const ExternalView &j_base);
+
+    /**
+     * @brief Returns the dumped external views of every player but the
+     * given one, separated by commas.
+     */
+    std::string joinTexts(std::optional<UserID> selfID);
+
+  public:
+    explicit GameStateBroadcast(const GameState &gameState);
+    GameStateBroadcast(const GameStateBroadcast &) = delete;
+    GameStateBroadcast(GameStateBroadcast &&) = delete;
+    GameStateBroadcast &operator=(const GameStateBroadcast &) = delete;
+    GameStateBroadcast &operator=(GameStateBroadcast &&) = delete;
+
+    ~GameStateBroadcast() = default;
+
+    /**
+     * @brief Returns the "self" of the given player's GameState, null if
+     * they aren't a player of the game.
+     */
+    nlohmann::json serializeSelf(UserID userID) const;
+
+    /**
+     * @brief Returns the external views in the GameState of the given
+     * player (all of them for a viewer).
+     */
+    std::vector<ExternalView>
+    getExternalViews(std::optional<UserID> selfID) const;
+
+    /**
+     * @brief Returns the GameState of the given player (or viewer) in the
+     * binary encoding, same as game_state_codec::encode() of their
+     * serialized GameState.
+     *
+     * @param j_self See serializeSelf(), null for a viewer.
+     */
+    std::vector<uint8_t> encode(const nlohmann::json &j_self,
+                                std::optional<UserID> selfID);
+
+    /**
+     * @brief Returns the GameState of the given player (or viewer) encoded
+     * as a delta from a GameState sent to them before, same as
+     * game_state_codec::encodeDelta().
+     *
+     * @param j_baseSelf The "self" of the base, null for a viewer.
+     * @param baseExternals The external views of the base.
+     * @param j_self See serializeSelf(), null for a viewer.
+     * @return nullopt if the GameStates can't be compared.
+     */
+    std::optional<std::vector<uint8_t>>
+    encodeDelta(const nlohmann::json &j_baseSelf,
+                const std::vector<ExternalView> &baseExternals,
+                const nlohmann::json &j_self, std::optional<UserID> selfID);
+
+    /**
+     * @brief Returns the dumped GameState binding of the given player (same
+     * as GameStateMessage::serializeForPlayer().dump()).
+     */
+    std::string dumpForPlayer(UserID userID, bindings::InputSeq lastInputSeq);
+
+    /**
+     * @brief Returns the dumped GameStateViewer binding, shared by all the
+     * viewers, in JSON or in the binary encoding (see
+     * ClientLink::sendShared()).
+     */
+    std::shared_ptr<const std::string> getViewerPacket(bool isBinary);
+};
+
+#endif // GAME_STATE_BROADCAST_HPP
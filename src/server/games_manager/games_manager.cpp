@@ -17,89 +17,106 @@
 
 #include "games_manager.hpp"
 
-// ======== private methode ========
-
-void GamesManager::joinerThreadFunc() {
-    while (running) {
-        std::unique_lock<std::mutex> lock(mutex);
-        cv.wait(lock, [this]() { return !finishedGames_.empty() || !running; });
-        while (!finishedGames_.empty()) {
-            int gameID = finishedGames_.front();
-            finishedGames_.pop();
-            lock.unlock();
-            if (gamethreads_[gameID].joinable()) {
-                gamethreads_[gameID].join();
-            }
-            lock.lock();
-        }
-    }
-}
-
-void GamesManager::notifyGameFinished(int gameID) {
-    std::lock_guard<std::mutex> lock(mutex);
-    finishedGames_.push(gameID);
-    cv.notify_one();
-}
-
 // ======== public methode ========
 
-GamesManager::GamesManager(SaveScoreCallback saveScoreCallback,
-                           UpdateRankingCallback updateRankingCallback)
-    : saveScoreCallback_(saveScoreCallback),
-      updateRankingCallback_(updateRankingCallback) {
-    joinerThread_ = std::thread(&GamesManager::joinerThreadFunc, this);
+GamesManager::GamesManager(unsigned numWorkers,
+                           SaveScoreCallback saveScoreCallback,
+                           SaveReplayCallback saveReplayCallback)
+    : gamesWork_(asio::make_work_guard(gamesContext_)),
+      databaseWork_(asio::make_work_guard(databaseContext_)),
+      saveScoreCallback_(saveScoreCallback),
+      saveReplayCallback_(saveReplayCallback) {
+    workers_.reserve(numWorkers);
+    for (unsigned i = 0; i < numWorkers; ++i) {
+        workers_.emplace_back([this]() { gamesContext_.run(); });
+    }
+    databaseWorker_ = std::thread([this]() { databaseContext_.run(); });
 }
 
 GamesManager::~GamesManager() { shutdown(); }
 
 void GamesManager::shutdown() {
     std::cout << "shutdwon " << std::endl;
-    running = false;
-    cv.notify_all();
-    if (joinerThread_.joinable()) {
-        joinerThread_.join();
+    gamesWork_.reset();
+    gamesContext_.stop();
+    for (std::thread &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // the games finished before are still saved
+    databaseWork_.reset();
+    if (databaseWorker_.joinable()) {
+        databaseWorker_.join();
     }
+
+    // no game runs anymore, they can be released while their context is
+    // still there
+    std::lock_guard<std::mutex> lock(mutex);
+    gameSessions_.clear();
 }
 
 std::shared_ptr<GameServer>
 GamesManager::startGameServeur(GameMode gameMode, std::vector<Player> players) {
+    std::shared_ptr<GameServer> gameServer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        gameServer = std::make_shared<GameServer>(
+            gameMode, std::move(players), nextGameId, gamesContext_,
+            [this](GameID gameId) { callBackFinishGame(gameId); });
+        gameSessions_[nextGameId] = gameServer;
+        nextGameId += 1;
+    }
 
-    std::shared_ptr<GameServer> gameServer = std::make_shared<GameServer>(
-        gameMode, std::move(players), nextGameId,
-        [this](GameID gameId) { callBackFinishGame(gameId); });
-
-    gameSessions_[nextGameId] = gameServer;
-    gamethreads_[nextGameId] =
-        std::thread([gameServer]() { gameServer->run(); });
-    nextGameId += 1;
+    gameServer->start();
     return gameServer;
 }
 
 void GamesManager::enqueueGameBinding(
     const std::shared_ptr<ClientLink> &clientLink,
-    const std::string &strBindings) {
+    bindings::ClientPacket &&packet) {
     UserID clientId = clientLink->getUserID();
     if (std::shared_ptr<GameServer> gameServer =
             clientLink->getGameServer().lock()) {
-        gameServer->enqueueBinding(clientId, strBindings);
+        gameServer->enqueueBinding(clientId, std::move(packet));
     }
 }
 
 void GamesManager::callBackFinishGame(GameID gameId) {
-    for (auto &weakClient : gameSessions_[gameId]->getClientLinks()) {
+    // called on the game's strand, while the io threads start other games
+    std::shared_ptr<GameServer> gameServer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto session = gameSessions_.find(gameId);
+        if (session == gameSessions_.end()) {
+            return;
+        }
+        gameServer = std::move(session->second);
+        gameSessions_.erase(session);
+    }
+
+    for (auto &weakClient : gameServer->getClientLinks()) {
         if (std::shared_ptr<ClientLink> clientLink = weakClient.lock()) {
             clientLink->exitGame();
         }
     }
 
-    if (gameSessions_[gameId]->getGameMode() == GameMode::Endless) {
-        for (auto &user : gameSessions_[gameId]->getVectorPlayersId()) {
-            int score = gameSessions_[gameId]->getPlayerScore(user);
-            saveScoreCallback_(user, score);
-            updateRankingCallback_();
+    // copied while on the game's strand, saved on the database thread
+    std::vector<std::pair<UserID, int>> scores;
+    if (gameServer->getGameMode() == GameMode::Endless) {
+        for (UserID user : gameServer->getVectorPlayersId()) {
+            scores.emplace_back(user, gameServer->getPlayerScore(user));
         }
     }
-    notifyGameFinished(gameId);
+
+    asio::post(databaseContext_, [this, scores = std::move(scores),
+                                  gameLog = gameServer->getGameLog()]() {
+        for (const auto &[user, score] : scores) {
+            saveScoreCallback_(user, score);
+        }
+        saveReplayCallback_(gameLog);
+    });
 }
 
 void GamesManager::makeClientJoinGame(std::shared_ptr<ClientLink> clientLink,
@@ -18,61 +18,68 @@
 #ifndef GAMES_MANAGER_HPP
 #define GAMES_MANAGER_HPP
 
-#include <atomic>
-#include <condition_variable>
+#include <asio.hpp>
 #include <memory>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "../game_server/game_server.hpp"
 
 using SaveScoreCallback = std::function<void(UserID, int)>;
-using UpdateRankingCallback = std::function<void()>;
+using SaveReplayCallback = std::function<void(const GameLog &)>;
 
 /**
  *@class GameServer
  *
  *@brief manages all current games
  *
+ * The games run on a fixed pool of worker threads, each game on its own
+ * strand (see GameServer), however many games there are.
+ *
  **/
 class GamesManager {
 
   private:
+    // run by the workers, shared by all the games. Declared first so that it
+    // outlives the games, whose strands and timers use it
+    asio::io_context gamesContext_;
+
+    // the games in progress, removed once finished
     std::unordered_map<GameID, std::shared_ptr<GameServer>> gameSessions_;
-    std::unordered_map<GameID, std::thread> gamethreads_;
+    // guards gameSessions_ and nextGameId
     std::mutex mutex;
-    std::condition_variable cv;
 
-    std::queue<GameID> finishedGames_;
+    // keeps the workers running while there is no game
+    asio::executor_work_guard<asio::io_context::executor_type> gamesWork_;
+    std::vector<std::thread> workers_;
+
+    // runs the end of the finished games (scores, ranking and replay, which
+    // query the database) on a thread of its own, so that they never stall
+    // the ticks of the other games on the workers
+    asio::io_context databaseContext_;
+    asio::executor_work_guard<asio::io_context::executor_type> databaseWork_;
+    std::thread databaseWorker_;
 
     SaveScoreCallback saveScoreCallback_;
-    UpdateRankingCallback updateRankingCallback_;
-    std::atomic<bool> running = true;
-    // thread that will join a game thread when the game is finished
-    std::thread joinerThread_;
+    SaveReplayCallback saveReplayCallback_;
     GameID nextGameId = 1;
 
+  public:
     /**
-     * @brief launched by joinerThread will wait for join finished game
-     */
-    void joinerThreadFunc();
-
-    /**
-     * @brief notify the joinerThread that the game is finish
+     * @param numWorkers : the number of threads running the games
      */
-    void notifyGameFinished(int gameID);
-
-  public:
-    GamesManager(SaveScoreCallback saveScoreCallback,
-                 UpdateRankingCallback updateRankingCallback);
+    GamesManager(unsigned numWorkers, SaveScoreCallback saveScoreCallback,
+                 SaveReplayCallback saveReplayCallback);
     ~GamesManager();
 
     /**
-     * @brief shutdown the gamesManager join all game Threads and join the
-     * joinerThread
+     * @brief shutdown the gamesManager: stop the games, join the workers and
+     * wait for the finished games to be saved
      */
     void shutdown();
 
@@ -86,16 +93,18 @@ class GamesManager {
      * @brief enqueue gameBinding
      */
     void enqueueGameBinding(const std::shared_ptr<ClientLink> &clientLink,
-                            const std::string &strBindings);
+                            bindings::ClientPacket &&packet);
 
     /**
-     * @brief start game : create a new thread that will run the game
+     * @brief start game : create a new game and start it on the workers
      */
     std::shared_ptr<GameServer> startGameServeur(GameMode gameMode,
                                                  std::vector<Player> players);
 
     /**
      * @brief callback to notify that the game is finish send by the gameServer
+     * (on its strand): the players go back to the menu and the game is
+     * removed, its scores and replay are saved on the database thread
      */
     void callBackFinishGame(GameID gameId);
 
@@ -16,6 +16,7 @@
  */
 
 #include "matchmaking.hpp"
+#include <algorithm>
 #include <vector>
 // ====== Loby class ======
 
@@ -94,6 +95,22 @@ std::vector<UserID> GameCandidate::getPlayerIDs() {
 
 GameMode GameCandidate::getGameMode() { return gameMode; }
 
+std::optional<std::chrono::microseconds> GameCandidate::getMeanRtt() const {
+    std::chrono::microseconds totalRtt{0};
+    size_t numRtts = 0;
+    for (const Player &player : players_) {
+        if (player.rtt.has_value()) {
+            totalRtt += *player.rtt;
+            ++numRtts;
+        }
+    }
+
+    if (numRtts == 0) {
+        return std::nullopt;
+    }
+    return totalRtt / numRtts;
+}
+
 // ======= matchmaking class =======
 
 void Matchmaking::addPlayer(RequestJoinGame joinGame) {
@@ -104,6 +121,7 @@ void Matchmaking::addPlayer(RequestJoinGame joinGame) {
         return;
     }
 
+    std::lock_guard<std::mutex> lock(mutex_);
     findaGame(getGame(joinGame.bindGame.gameMode), joinGame);
 }
 
@@ -125,27 +143,59 @@ std::vector<GameCandidate> &Matchmaking::getGame(GameMode gameMode) {
 
 void Matchmaking::findaGame(std::vector<GameCandidate> &games,
                             RequestJoinGame joinGame) {
-    bool joinFriend = joinGame.bindGame.friendId.has_value(), findGame = false;
-    auto it = games.begin();
-    while (it != games.end() && !findGame) {
-        if (joinFriend) {
-            if (it->isthisPlayerInThisGame(
-                    joinGame.bindGame.friendId.value())) {
-                findGame = it->tryToAddPlayer(joinGame);
-            }
-        } else {
-            findGame = it->tryToAddPlayer(joinGame);
+    auto it = games.end();
+    if (joinGame.bindGame.friendId.has_value()) {
+        it = std::find_if(games.begin(), games.end(), [&](GameCandidate &game) {
+            return game.isthisPlayerInThisGame(
+                       joinGame.bindGame.friendId.value())
+                   && game.isThereRoomInThisGame();
+        });
+    } else {
+        it = findClosestRttGame(games, joinGame.player.rtt);
+    }
+
+    if (it == games.end()) {
+        createNewGameCandidate(games, joinGame);
+        return;
+    }
+
+    it->tryToAddPlayer(joinGame);
+    if (it->isThisPartyReady()) {
+        std::cout << "game ready" << std::endl;
+
+        startGame(std::move(*it));
+        games.erase(it);
+    }
+}
+
+std::vector<GameCandidate>::iterator
+Matchmaking::findClosestRttGame(std::vector<GameCandidate> &games,
+                                std::optional<std::chrono::microseconds> rtt) {
+    auto closestGame = games.end();
+    std::chrono::microseconds closestDistance{0};
+    for (auto it = games.begin(); it != games.end(); ++it) {
+        if (!it->isThereRoomInThisGame()) {
+            continue;
         }
-        if (it->isThisPartyReady()) {
-            std::cout << "game ready" << std::endl;
 
-            startGame(std::move(*it));
-            it = games.erase(it);
-        } else {
-            ++it;
+        // an unknown round trip time is close to any other
+        const std::optional<std::chrono::microseconds> gameRtt =
+            it->getMeanRtt();
+        const std::chrono::microseconds distance =
+            (rtt.has_value() && gameRtt.has_value())
+                ? std::max(std::chrono::microseconds{0},
+                           std::chrono::abs(*rtt - *gameRtt) - RTT_TOLERANCE)
+                : std::chrono::microseconds{0};
+
+        if (closestGame == games.end() || distance < closestDistance) {
+            closestGame = it;
+            closestDistance = distance;
+        }
+        if (closestDistance == std::chrono::microseconds{0}) {
+            break;
         }
     }
-    if (!findGame) createNewGameCandidate(games, joinGame);
+    return closestGame;
 }
 
 Matchmaking::Matchmaking(GameFindCallback gameFindCallback)
@@ -157,11 +207,18 @@ void Matchmaking::createNewGameCandidate(std::vector<GameCandidate> &games,
 }
 
 void Matchmaking::createAGame(RequestCreateGame createGame) {
+    std::lock_guard<std::mutex> lock(mutex_);
     getGame(createGame.bindCreateGame.gameMode)
         .push_back(GameCandidate{createGame});
 }
 
 void Matchmaking::removePlayer(UserID playerID, GameMode gameMode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    removeFromGameCandidates(playerID, gameMode);
+}
+
+void Matchmaking::removeFromGameCandidates(UserID playerID,
+                                           GameMode gameMode) {
     auto &gameList = getGame(gameMode);
     auto it = gameList.begin();
     while (it != gameList.end()) {
@@ -185,11 +242,13 @@ void Matchmaking::startGame(GameCandidate &&gameCandidate) {
 
 void Matchmaking::abortMatchmaking(
     const std::shared_ptr<ClientLink> &clientLink) {
+    // locked before checking the state, which a game found meanwhile changes
+    std::lock_guard<std::mutex> lock(mutex_);
     if (clientLink->getUserState() != bindings::State::Matchmaking) {
         std::cerr << "Player not in Matchmaking " << std::endl;
     } else {
-        removePlayer(clientLink->getUserID(),
-                     clientLink->getGameMode().value());
+        removeFromGameCandidates(clientLink->getUserID(),
+                                 clientLink->getGameMode().value());
         clientLink->setUserState(bindings::State::Menu);
     }
 }
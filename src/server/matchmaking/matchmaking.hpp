@@ -23,6 +23,9 @@
 #include "../../common/tetris_royal_lib/game_mode/game_mode.hpp"
 #include "../game_server/game_server.hpp"
 
+#include <chrono>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 using NumberOfPlayers = size_t;
@@ -31,6 +34,8 @@ using GameFindCallback = std::function<void(std::vector<Player>, GameMode)>;
 
 constexpr NumberOfPlayers MAXPLAYERDUAL = 2;
 constexpr NumberOfPlayers MAXPLAYERCLASSICANDROYAL = 9;
+// round trip time differences that don't matter when choosing a game
+constexpr std::chrono::milliseconds RTT_TOLERANCE{50};
 
 struct RequestJoinGame {
     Player player;
@@ -100,18 +105,28 @@ class GameCandidate {
     std::vector<UserID> getPlayerIDs();
 
     GameMode getGameMode();
+
+    /**
+     * @brief returns the mean round trip time of the players whose one is
+     * known, nullopt if there isn't any
+     */
+    std::optional<std::chrono::microseconds> getMeanRtt() const;
 };
 
 /**
  * @class Matchmaking
  *
  * @brief manage the search of game for all clients
+ *
+ * It is called by all the io threads: the queues are only accessed with
+ * mutex_ locked, which is held while gameFindCallback_ runs.
  */
 class Matchmaking {
   private:
     std::vector<GameCandidate> gamesCanditatesClassic_;
     std::vector<GameCandidate> gamesCanditatesDuel_;
     std::vector<GameCandidate> gamesCanditatesRoyalCompetition_;
+    std::mutex mutex_;
 
     GameFindCallback gameFindCallback_;
 
@@ -129,6 +144,28 @@ class Matchmaking {
     void startGame(GameCandidate &&gameCandidate);
     std::vector<GameCandidate> &getGame(GameMode gameMode);
 
+    /**
+     * @brief looking for a gameCandidate that a client could join
+     *if no gameCandidate found a new one with the client is create. Must be
+     *called with mutex_ locked.
+     *
+     */
+    void findaGame(std::vector<GameCandidate> &games, RequestJoinGame joinGame);
+
+    /**
+     * @brief returns the first gameCandidate with room whose players' round
+     * trip time is the closest to the given one (up to RTT_TOLERANCE),
+     * games.end() if none has room
+     */
+    std::vector<GameCandidate>::iterator
+    findClosestRttGame(std::vector<GameCandidate> &games,
+                       std::optional<std::chrono::microseconds> rtt);
+
+    /**
+     * @brief remove player from the queue. Must be called with mutex_ locked.
+     */
+    void removeFromGameCandidates(UserID playerID, GameMode gameMode);
+
   public:
     Matchmaking(GameFindCallback gameFindCallback);
     ~Matchmaking() = default;
@@ -144,13 +181,6 @@ class Matchmaking {
      */
     void removePlayer(UserID playerID, GameMode gameMode);
 
-    /**
-     * @brief looking for a gameCandidate that a client could join
-     *if no gameCandidate found a new one with the client is create
-     *
-     */
-    void findaGame(std::vector<GameCandidate> &games, RequestJoinGame joinGame);
-
     /**
      * @brief create a new gameCandidate according to the requestCreateGame
      *
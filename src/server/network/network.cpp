@@ -22,12 +22,14 @@
 #include <asio/detail/handler_cont_helpers.hpp>
 #include <asio/detail/impl/scheduler.ipp>
 #include <asio/detail/impl/service_registry.hpp>
+#include <asio/detail/socket_option.hpp>
 #include <asio/execution/context_as.hpp>
 #include <asio/execution/prefer_only.hpp>
 #include <asio/impl/execution_context.hpp>
 #include <asio/impl/io_context.hpp>
 #include <asio/io_context.hpp>
 #include <asio/ip/detail/impl/endpoint.ipp>
+#include <asio/socket_base.hpp>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <nlohmann/json_fwd.hpp>
@@ -45,38 +47,103 @@ using asio::ip::tcp;
 
 // ====== Network class ======
 
+#if defined(SO_REUSEPORT)
+using ReusePort =
+    asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
 //--- private ---
-void Network::accept() {
-    acceptor_.async_accept([this](asio::error_code ec,
-                                  tcp::socket socket) {
-        if (!ec) {
+tcp::acceptor Network::openAcceptor(uint16_t port, bool reusePort) {
+    const tcp::endpoint endpoint(tcp::v4(), port);
+    tcp::acceptor acceptor(io_);
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(tcp::acceptor::reuse_address(true));
+#if defined(SO_REUSEPORT)
+    if (reusePort) {
+        acceptor.set_option(ReusePort(true));
+    }
+#endif
+    acceptor.bind(endpoint);
+    acceptor.listen();
+    return acceptor;
+}
+
+void Network::accept(tcp::acceptor &acceptor) {
+    // each socket gets its own strand: the handlers of a client never run
+    // concurrently, while different clients are served by all the io threads
+    acceptor.async_accept(
+        asio::make_strand(io_),
+        [this, &acceptor](asio::error_code ec, tcp::socket socket) {
+            if (!ec) {
+                handleNewConnection(std::move(socket));
+            }
+            accept(acceptor);
+        });
+}
+
+void Network::handleNewConnection(tcp::socket &&socket) {
+    asio::error_code ec;
+    const tcp::endpoint remote = socket.remote_endpoint(ec);
+    if (ec) {
+        // already disconnected
+        return;
+    }
+    if (!acceptLimiter_.tryAccept(remote.address())) {
+        metrics_.recordRejectedConnection();
+        // reset rather than closed, not to keep the rejected connections
+        // in TIME_WAIT
+        socket.set_option(asio::socket_base::linger(true, 0), ec);
+        socket.close(ec);
+        return;
+    }
 
-            std::shared_ptr<ClientLink> newLink = std::make_shared<ClientLink>(
-                std::move(socket),
-                [this](const std::string &packet, const int clientId) {
-                    clientManager_.handlePacket(packet, clientId);
-                },
-                [this](nlohmann::json binding) -> nlohmann::json {
-                    return clientManager_.authPacketHandler(binding).value();
-                },
-                [this](std::shared_ptr<ClientLink> clientLink,
-                       nlohmann::json clientData) {
-                    clientManager_.authSuccessCall(clientLink, clientData);
-                },
-                [this](std::optional<UserID> userID) {
-                    clientManager_.removeClient(userID);
-                });
+    std::shared_ptr<ClientLink> newLink = std::make_shared<ClientLink>(
+        std::move(socket),
+        [this](bindings::ClientPacket &&packet, const int clientId) {
+            clientManager_.handlePacket(std::move(packet), clientId);
+        },
+        [this](const bindings::ClientPacket &packet,
+               std::function<void(nlohmann::json)> respond) {
+            return clientManager_.authPacketHandler(packet,
+                                                    std::move(respond));
+        },
+        [this](std::shared_ptr<ClientLink> clientLink,
+               const bindings::Authentication &authentication) {
+            return clientManager_.authSuccessCall(clientLink, authentication);
+        },
+        [this](std::optional<UserID> userID) {
+            clientManager_.removeClient(userID);
+        },
+        limits_, metrics_);
 
-            clientManager_.addClientInWaitingForAuth(std::move(newLink));
-        }
-        accept();
-    });
+    // started once listed, for the ClientManager to find it if it
+    // disconnects right away
+    ClientLink &link = *newLink;
+    clientManager_.addClientInWaitingForAuth(std::move(newLink));
+    link.start();
 }
 
 // --- public ---
 Network::Network(asio::io_context &io, ClientManager &clientManager,
-                 uint16_t port)
-    : io_(io), acceptor_(io, tcp::endpoint(tcp::v4(), port)),
-      clientManager_(clientManager) {
-    this->accept();
+                 uint16_t port, unsigned numAcceptors,
+                 TokenBucket::Rate acceptRate, const ConnectionLimits &limits,
+                 ServerMetrics &metrics)
+    : io_(io), acceptLimiter_(acceptRate), clientManager_(clientManager),
+      limits_(limits), metrics_(metrics) {
+#if !defined(SO_REUSEPORT)
+    // the port can't be shared
+    numAcceptors = 1;
+#endif
+    const bool reusePort = numAcceptors > 1;
+    // all opened before the first accept, which keeps a reference to its
+    // acceptor
+    acceptors_.reserve(numAcceptors);
+    for (unsigned i = 0; i < numAcceptors; ++i) {
+        acceptors_.push_back(openAcceptor(port, reusePort));
+    }
+    for (tcp::acceptor &acceptor : acceptors_) {
+        accept(acceptor);
+    }
 }
+
+std::size_t Network::getNumAcceptors() const { return acceptors_.size(); }
@@ -21,7 +21,12 @@
 #include <asio/detail/impl/reactive_socket_service_base.ipp>
 #include <asio/impl/any_io_executor.ipp>
 #include <asio/ip/tcp.hpp>
+#include <cstddef>
 #include <stdint.h>
+#include <vector>
+
+#include "../accept_limiter/accept_limiter.hpp"
+#include "../client_link/client_link.hpp"
 
 class ClientManager;
 
@@ -41,18 +46,51 @@ using asio::ip::tcp;
 class Network {
   private:
     asio::io_context &io_;
-    tcp::acceptor acceptor_;
+    // bound to the same port with SO_REUSEPORT, the kernel spreads the new
+    // connections between them
+    std::vector<tcp::acceptor> acceptors_;
+    AcceptLimiter acceptLimiter_;
     ClientManager &clientManager_;
+    // given to each new ClientLink
+    ConnectionLimits limits_;
+    ServerMetrics &metrics_;
+
+    /**
+     * @brief open an acceptor listening on the given port
+     *
+     * @param reusePort : if the port is shared with the other acceptors
+     */
+    tcp::acceptor openAcceptor(uint16_t port, bool reusePort);
+
+    /**
+     * @brief accept new connection on the given acceptor, create a
+     * clientLink whit the socket and give the clientLink to CLientManager
+     */
+    void accept(tcp::acceptor &acceptor);
 
     /**
-     * @brief accept new connection create a clientLink  whit the socket
-     * and give the clientLink to CLientManager
+     * @brief create the link of a new connection and start it
      */
-    void accept();
+    void handleNewConnection(tcp::socket &&socket);
 
   public:
+    /**
+     * @param numAcceptors : the acceptors listening on the port, one if the
+     * system can't share a port
+     * @param acceptRate : the connections per second accepted from each
+     * address
+     * @param limits : the limits of each connection
+     * @param metrics : the counters the connections report to
+     */
     Network(asio::io_context &io, ClientManager &clientManager,
-            uint16_t port);
+            uint16_t port, unsigned numAcceptors,
+            TokenBucket::Rate acceptRate, const ConnectionLimits &limits,
+            ServerMetrics &metrics);
+
+    /**
+     * @brief returns the number of acceptors listening on the port
+     */
+    std::size_t getNumAcceptors() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "server_metrics.hpp"
+
+#include <sstream>
+
+// ====== ServerMetrics class ======
+
+void ServerMetrics::recordConnectionOpened() {
+    openConnections_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ServerMetrics::recordConnectionClosed() {
+    openConnections_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ServerMetrics::recordIdleEviction() {
+    idleEvictions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ServerMetrics::recordRateLimitedPackage() {
+    rateLimitedPackets_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ServerMetrics::recordRateLimitEviction() {
+    rateLimitEvictions_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ServerMetrics::recordRejectedConnection() {
+    rejectedConnections_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ServerMetrics::recordRtt(std::chrono::microseconds rtt) {
+    const auto rttUs = static_cast<uint64_t>(rtt.count());
+    rttSamples_.fetch_add(1, std::memory_order_relaxed);
+    rttTotalUs_.fetch_add(rttUs, std::memory_order_relaxed);
+
+    uint64_t maxUs = rttMaxUs_.load(std::memory_order_relaxed);
+    while (rttUs > maxUs
+           && !rttMaxUs_.compare_exchange_weak(maxUs, rttUs,
+                                               std::memory_order_relaxed)) {
+    }
+}
+
+std::string ServerMetrics::report() {
+    const uint64_t samples = rttSamples_.exchange(0, std::memory_order_relaxed);
+    const uint64_t totalUs = rttTotalUs_.exchange(0, std::memory_order_relaxed);
+    const uint64_t maxUs = rttMaxUs_.exchange(0, std::memory_order_relaxed);
+
+    std::ostringstream report;
+    report << "connections: "
+           << openConnections_.load(std::memory_order_relaxed)
+           << ", idle evictions: "
+           << idleEvictions_.load(std::memory_order_relaxed)
+           << ", rate limited packets: "
+           << rateLimitedPackets_.load(std::memory_order_relaxed)
+           << ", rate limit evictions: "
+           << rateLimitEvictions_.load(std::memory_order_relaxed)
+           << ", rejected connections: "
+           << rejectedConnections_.load(std::memory_order_relaxed) << ", rtt: ";
+    if (samples == 0) {
+        report << "no sample";
+    } else {
+        report << "mean " << static_cast<double>(totalUs) / samples / 1000.0
+               << " ms, max " << maxUs / 1000.0 << " ms (" << samples
+               << " samples)";
+    }
+    return report.str();
+}
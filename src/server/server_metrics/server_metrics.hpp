@@ -0,0 +1,95 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SERVER_METRICS_HPP
+#define SERVER_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class ServerMetrics
+ *
+ * @brief Counters about the connections, updated by all the threads without
+ * locks and reported every now and then in the server's log.
+ */
+class ServerMetrics {
+  private:
+    std::atomic<int64_t> openConnections_ = 0;
+    // since the start of the server
+    std::atomic<uint64_t> idleEvictions_ = 0;
+    std::atomic<uint64_t> rateLimitedPackets_ = 0;
+    std::atomic<uint64_t> rateLimitEvictions_ = 0;
+    std::atomic<uint64_t> rejectedConnections_ = 0;
+    // since the last report
+    std::atomic<uint64_t> rttSamples_ = 0;
+    std::atomic<uint64_t> rttTotalUs_ = 0;
+    std::atomic<uint64_t> rttMaxUs_ = 0;
+
+  public:
+    ServerMetrics() = default;
+    ~ServerMetrics() = default;
+
+    ServerMetrics(const ServerMetrics &) = delete;
+    ServerMetrics &operator=(const ServerMetrics &) = delete;
+
+    /**
+     * @brief a client connected
+     */
+    void recordConnectionOpened();
+
+    /**
+     * @brief a client's connection is gone
+     */
+    void recordConnectionClosed();
+
+    /**
+     * @brief a client was disconnected for staying silent too long
+     */
+    void recordIdleEviction();
+
+    /**
+     * @brief a package was dropped for being over its client's rate
+     */
+    void recordRateLimitedPackage();
+
+    /**
+     * @brief a client was disconnected for sending too many packages over
+     * its rate
+     */
+    void recordRateLimitEviction();
+
+    /**
+     * @brief a connection was dropped for its address connecting too often
+     */
+    void recordRejectedConnection();
+
+    /**
+     * @brief a round trip time was measured (see bindings/ping.hpp)
+     */
+    void recordRtt(std::chrono::microseconds rtt);
+
+    /**
+     * @brief returns a line summing up the counters, and resets the ones
+     * about the round trip times
+     */
+    std::string report();
+};
+
+#endif // SERVER_METRICS_HPP
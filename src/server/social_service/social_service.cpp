@@ -25,9 +25,9 @@ SocialService::SocialService(std::shared_ptr<FriendsManager> &friendsManager,
     : friendsManager_{friendsManager}, messagesManager_{messagesManager},
       getUser_{getUser} {}
 
-void SocialService::handleMessages(UserID senderID, bindings::Message message) {
-    messagesManager_->addMessage(senderID, message.recipientId,
-                                 message.content);
+bool SocialService::handleMessages(UserID senderID, bindings::Message message) {
+    return messagesManager_->addMessage(senderID, message.recipientId,
+                                        message.content);
 }
 
 void SocialService::handleFriendRequest(
@@ -80,7 +80,7 @@ bindings::Conversations SocialService::getConversations(
     for (auto id : messagesManager_->getAllUser(userID)) {
         if (messagesManager_->isThereDiscussion(userID, id)) {
             std::optional<bindings::Conversation> optDiscussion =
-                messagesManager_->getDiscussion(userID, id);
+                messagesManager_->getDiscussionPage(userID, id, std::nullopt);
             if (optDiscussion.has_value()) {
                 conversations.conversationsById.insert(
                     {static_cast<unsigned long>(id),
@@ -91,6 +91,18 @@ bindings::Conversations SocialService::getConversations(
     return conversations;
 }
 
+bindings::ConversationPage SocialService::getConversationPage(
+    UserID userID, const bindings::RequestConversationPage &request) {
+    bindings::ConversationPage conversationPage{request.userID, {}};
+    if (messagesManager_->isThereDiscussion(userID, request.userID)) {
+        conversationPage.conversation =
+            messagesManager_
+                ->getDiscussionPage(userID, request.userID, request.before)
+                .value_or(bindings::Conversation{});
+    }
+    return conversationPage;
+}
+
 std::vector<int> SocialService::getFriendIdsList(UserID userID) {
     return friendsManager_->getFriends(userID);
 }
@@ -27,6 +27,7 @@
 
 #include "../../common/bindings/user.hpp"
 
+#include "../../common/bindings/conversation_page.hpp"
 #include "../../common/bindings/conversations.hpp"
 #include "../../common/bindings/friend_request.hpp"
 #include "../../common/bindings/friends_list.hpp"
@@ -34,6 +35,7 @@
 #include "../../common/bindings/message.hpp"
 #include "../../common/bindings/pending_friend_requests.hpp"
 #include "../../common/bindings/remove_friend.hpp"
+#include "../../common/bindings/request_conversation_page.hpp"
 
 /**
  * @class SocialService
@@ -61,8 +63,10 @@ class SocialService {
      *
      * @param senderID userID of the sender
      * @param message binding with the message's content and recipient's userID
+     *
+     * @return true if the message was added
      */
-    void handleMessages(UserID senderID, bindings::Message message);
+    bool handleMessages(UserID senderID, bindings::Message message);
 
     /**
      * @brief send a friend request from the sender to the recipient on the
@@ -110,12 +114,21 @@ class SocialService {
     bindings::FriendsList getFriendsList(UserID userID);
 
     /**
-     * @brief returns the conversations concerning an userID
+     * @brief returns the conversations concerning an userID (the last page of
+     * each one)
      */
     bindings::Conversations
     getConversations(UserID userID,
                      std::shared_ptr<AccountManager> &accountManager);
 
+    /**
+     * @brief returns the requested page of a conversation concerning an
+     * userID
+     */
+    bindings::ConversationPage
+    getConversationPage(UserID userID,
+                        const bindings::RequestConversationPage &request);
+
     /**
      * @brief returns the userID of the friends' list concerning an userID
      */
@@ -0,0 +1,39 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef IO_BACKEND_HPP
+#define IO_BACKEND_HPP
+
+#include <asio.hpp>
+
+/**
+ * @brief The mechanism asio waits for the sockets with, chosen at build time:
+ * io_uring with the USE_IO_URING CMake option, epoll otherwise on Linux.
+ */
+#if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+constexpr char IO_BACKEND[] = "io_uring";
+#elif defined(ASIO_HAS_EPOLL)
+constexpr char IO_BACKEND[] = "epoll";
+#elif defined(ASIO_HAS_KQUEUE)
+constexpr char IO_BACKEND[] = "kqueue";
+#elif defined(ASIO_HAS_IOCP)
+constexpr char IO_BACKEND[] = "iocp";
+#else
+constexpr char IO_BACKEND[] = "select";
+#endif
+
+#endif // IO_BACKEND_HPP
@@ -18,8 +18,11 @@
 #include "tetris_main_server.hpp"
 
 #include "../database/database_manager/database_manager.hpp"
+#include "io_backend.hpp"
 #include "network/network.hpp"
 
+#include <algorithm>
+
 /*Publics methods*/
 
 uint16_t TetrisMainServer::getEnvPort() {
@@ -32,6 +35,57 @@ uint16_t TetrisMainServer::getEnvPort() {
     }
     return DEFAULT_PORT;
 }
+
+unsigned TetrisMainServer::getEnvThreads(const char *envVar) {
+    if (const char *threads_env = std::getenv(envVar)) {
+        try {
+            const int threads = std::stoi(threads_env);
+            if (threads > 0) {
+                return static_cast<unsigned>(threads);
+            }
+        } catch (...) {
+            // not a number, the default is used
+        }
+        std::cerr << envVar << invalidNumberOfThreads << std::endl;
+    }
+    // hardware_concurrency() is 0 when it can't be known
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::chrono::seconds TetrisMainServer::getEnvIdleTimeout() {
+    if (const char *timeout_env = std::getenv(ENV_VAR_IDLE_TIMEOUT)) {
+        try {
+            const int timeout = std::stoi(timeout_env);
+            if (timeout > 0) {
+                return std::chrono::seconds{timeout};
+            }
+        } catch (...) {
+            // not a number, the default is used
+        }
+        std::cerr << ENV_VAR_IDLE_TIMEOUT << invalidIdleTimeout << std::endl;
+    }
+    return DEFAULT_IDLE_TIMEOUT;
+}
+
+TokenBucket::Rate TetrisMainServer::getEnvRate(const char *envVar,
+                                               unsigned defaultRate) {
+    unsigned rate = defaultRate;
+    if (const char *rate_env = std::getenv(envVar)) {
+        try {
+            const int envRate = std::stoi(rate_env);
+            if (envRate > 0) {
+                rate = static_cast<unsigned>(envRate);
+            } else {
+                std::cerr << envVar << invalidRate << std::endl;
+            }
+        } catch (...) {
+            std::cerr << envVar << invalidRate << std::endl;
+        }
+    }
+    return TokenBucket::Rate{static_cast<double>(rate),
+                             static_cast<double>(rate)};
+}
+
 TetrisMainServer *TetrisMainServer::instance_ = nullptr;
 
 uint16_t TetrisMainServer::handleArguments(int argc, char *argv[]) {
@@ -65,8 +119,17 @@ TetrisMainServer::TetrisMainServer(int argc, char *argv[])
     : dbManager(std::make_shared<DatabaseManager>()),
       database{std::make_shared<AccountManager>(dbManager),
                std::make_shared<FriendsManager>(dbManager),
-               std::make_shared<MessagesManager>(dbManager)},
-      clientManager(database), serverPort(handleArguments(argc, argv)) {
+               std::make_shared<MessagesManager>(dbManager),
+               std::make_shared<ReplaysManager>(dbManager)},
+      clientManager(database, getEnvThreads(ENV_VAR_GAME_THREADS)),
+      serverPort(handleArguments(argc, argv)),
+      ioThreads(getEnvThreads(ENV_VAR_IO_THREADS)),
+      connectionLimits{
+          getEnvIdleTimeout(),
+          getEnvRate(ENV_VAR_GAME_INPUT_RATE, DEFAULT_GAME_INPUT_RATE),
+          getEnvRate(ENV_VAR_MENU_RATE, DEFAULT_MENU_RATE),
+      },
+      acceptRate(getEnvRate(ENV_VAR_ACCEPT_RATE, DEFAULT_ACCEPT_RATE)) {
     instance_ = this;
 }
 void TetrisMainServer::handler(const asio::error_code &error,
@@ -77,13 +140,62 @@ void TetrisMainServer::handler(const asio::error_code &error,
     }
 }
 
+void TetrisMainServer::runIoContext() {
+    // a handler exception leaves the io_context usable: the thread goes back
+    // to running it, so the pool never silently loses one of its threads
+    for (;;) {
+        try {
+            io_context.run();
+            return;
+        } catch (std::exception &e) {
+            std::cerr << "Exception in an io thread : " << e.what()
+                      << std::endl;
+        }
+    }
+}
+
+void TetrisMainServer::scheduleMetricsReport(asio::steady_timer &timer) {
+    timer.expires_after(METRICS_REPORT_INTERVAL);
+    timer.async_wait([this, &timer](const asio::error_code &error) {
+        if (!error) {
+            std::cout << "Metrics : " << metrics.report() << std::endl;
+            scheduleMetricsReport(timer);
+        }
+    });
+}
+
 void TetrisMainServer::run() {
     try {
         asio::signal_set signals(io_context, SIGINT, SIGTERM);
-        Network network(io_context, clientManager, serverPort);
-        std::cout << "Server started on port " << serverPort << std::endl;
+        // one acceptor per io thread, for the accepts to scale with the
+        // cores when all the clients reconnect at once
+        Network network(io_context, clientManager, serverPort, ioThreads,
+                        acceptRate, connectionLimits, metrics);
+        std::cout << "Server started on port " << serverPort << " with "
+                  << ioThreads << " io threads (" << IO_BACKEND << ") and "
+                  << network.getNumAcceptors() << " acceptors" << std::endl;
+        std::cout << "Clients limited to "
+                  << connectionLimits.gameInputs.perSecond
+                  << " packets/s in game and "
+                  << connectionLimits.menuRequests.perSecond
+                  << " packets/s otherwise, dropped after "
+                  << connectionLimits.idleTimeout.count() << "s of silence, "
+                  << acceptRate.perSecond << " connections/s per address"
+                  << std::endl;
         signals.async_wait(handler);
-        io_context.run();
+        asio::steady_timer metricsTimer(io_context);
+        scheduleMetricsReport(metricsTimer);
+
+        // the calling thread is one of the io threads
+        std::vector<std::thread> threads;
+        threads.reserve(ioThreads - 1);
+        for (unsigned i = 1; i < ioThreads; ++i) {
+            threads.emplace_back([this]() { runIoContext(); });
+        }
+        runIoContext();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
 
     } catch (std::exception &e) {
         std::cerr << "Exception : " << e.what() << std::endl;
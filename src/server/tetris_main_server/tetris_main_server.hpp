@@ -20,21 +20,52 @@
 
 #include <asio/impl/io_context.ipp>
 #include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "../client_manager/client_manager.hpp"
+#include "../server_metrics/server_metrics.hpp"
 
 class DatabaseManager;
 
 constexpr uint16_t DEFAULT_PORT = 1234;
 constexpr char ENV_VAR_PORT[] = "SERVER_PORT";
+// number of threads running the io_context (default: one per core)
+constexpr char ENV_VAR_IO_THREADS[] = "SERVER_IO_THREADS";
+// number of threads running the games (default: one per core)
+constexpr char ENV_VAR_GAME_THREADS[] = "SERVER_GAME_THREADS";
+// seconds a client can stay silent before being disconnected
+constexpr char ENV_VAR_IDLE_TIMEOUT[] = "SERVER_IDLE_TIMEOUT";
+constexpr std::chrono::seconds DEFAULT_IDLE_TIMEOUT{30};
+// packets per second a client can send while in game (burst: one second's)
+constexpr char ENV_VAR_GAME_INPUT_RATE[] = "SERVER_GAME_INPUT_RATE";
+constexpr unsigned DEFAULT_GAME_INPUT_RATE = 60;
+// packets per second a client can send otherwise (burst: one second's)
+constexpr char ENV_VAR_MENU_RATE[] = "SERVER_MENU_RATE";
+constexpr unsigned DEFAULT_MENU_RATE = 20;
+// connections per second accepted from each address (burst: one second's),
+// above the retries of a client every 100 ms, with room for a few clients
+// behind the same NAT
+constexpr char ENV_VAR_ACCEPT_RATE[] = "SERVER_ACCEPT_RATE";
+constexpr unsigned DEFAULT_ACCEPT_RATE = 20;
+// interval between two reports of the metrics in the log
+constexpr std::chrono::seconds METRICS_REPORT_INTERVAL{60};
 
 constexpr char invalidNumberOfArguments[] =
     "\033[1;31merror:\033[0m invalid number of arguments\nTry "
     "'./tetris_royal_server --help' for more information.";
 constexpr char noServerPortVariable[] =
     "No SERVER_PORT environment variable set. Using default.";
+constexpr char invalidNumberOfThreads[] =
+    " must be a positive number. Using default.";
+constexpr char invalidIdleTimeout[] =
+    " must be a positive number of seconds. Using default.";
+constexpr char invalidRate[] =
+    " must be a positive number per second. Using default.";
 constexpr char invalidPortRange[] = "Port must be between 1 and 65535.";
 constexpr char invalidPortType[] = "Port must be a number between 1 and 65535.";
 constexpr char help[] =
@@ -49,9 +80,26 @@ class TetrisMainServer {
   private:
     std::shared_ptr<DatabaseManager> dbManager;
     DataBase database;
+    // outlives the clients, which report to it until they are destroyed
+    ServerMetrics metrics;
     ClientManager clientManager;
     asio::io_context io_context;
     uint16_t serverPort;
+    unsigned ioThreads;
+    ConnectionLimits connectionLimits;
+    TokenBucket::Rate acceptRate;
+
+    /**
+     * @brief run the io_context on the calling thread until it is stopped,
+     * logging the exceptions thrown by its handlers
+     */
+    void runIoContext();
+
+    /**
+     * @brief log the metrics once the timer expires, then again every
+     * METRICS_REPORT_INTERVAL
+     */
+    void scheduleMetricsReport(asio::steady_timer &timer);
 
   public:
     /**
@@ -83,6 +131,35 @@ class TetrisMainServer {
      */
     uint16_t getEnvPort();
 
+    /**
+     * @brief Get a number of threads from the given environment variable or
+     * use one per core
+     *
+     * @param envVar The environment variable
+     * @return unsigned The number of threads
+     */
+    static unsigned getEnvThreads(const char *envVar);
+
+    /**
+     * @brief Get the idle timeout from the environment variable or use the
+     * default
+     *
+     * @return std::chrono::seconds The time after which a silent client is
+     * disconnected
+     */
+    static std::chrono::seconds getEnvIdleTimeout();
+
+    /**
+     * @brief Get a rate of packets (or connections) from the given
+     * environment variable or use the given default
+     *
+     * @param envVar The environment variable
+     * @param defaultRate The packets per second used by default
+     * @return TokenBucket::Rate The rate, with a burst of one second's packets
+     */
+    static TokenBucket::Rate getEnvRate(const char *envVar,
+                                        unsigned defaultRate);
+
     /**
      * @brief Handle the arguments passed to the program
      *
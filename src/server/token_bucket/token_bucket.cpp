@@ -0,0 +1,39 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "token_bucket.hpp"
+
+#include <algorithm>
+
+// ====== TokenBucket class ======
+
+TokenBucket::TokenBucket(Rate rate)
+    : rate_(rate), tokens_(rate.burst), lastRefill_(Clock::now()) {}
+
+bool TokenBucket::tryTake() {
+    const Clock::time_point now = Clock::now();
+    const std::chrono::duration<double> elapsed = now - lastRefill_;
+    tokens_ =
+        std::min(rate_.burst, tokens_ + elapsed.count() * rate_.perSecond);
+    lastRefill_ = now;
+
+    if (tokens_ < 1) {
+        return false;
+    }
+    tokens_ -= 1;
+    return true;
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of Royal Blocks.
+ *
+ * Royal Blocks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Royal Blocks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Royal Blocks.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TOKEN_BUCKET_HPP
+#define TOKEN_BUCKET_HPP
+
+#include <chrono>
+
+/**
+ * @class TokenBucket
+ *
+ * @brief Limits the rate of an event: each event takes a token, the tokens
+ * come back at a steady rate, up to a burst. Not thread safe, a bucket
+ * belongs to the strand of its client.
+ */
+class TokenBucket {
+  public:
+    struct Rate {
+        // tokens coming back every second
+        double perSecond;
+        // tokens the bucket holds at most, the bucket starts full
+        double burst;
+    };
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    Rate rate_;
+    double tokens_;
+    Clock::time_point lastRefill_;
+
+  public:
+    explicit TokenBucket(Rate rate);
+
+    /**
+     * @brief take a token, if there's one
+     *
+     * @return false if the bucket is empty: the event is over the rate
+     */
+    bool tryTake();
+};
+
+#endif // TOKEN_BUCKET_HPP